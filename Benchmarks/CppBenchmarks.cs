@@ -42,6 +42,16 @@ namespace Benchmarks
             }
         }
 
+        [Benchmark]
+        public int LexCppDeclarationsOnly()
+        {
+            using (CppLexer lexer = new CppLexer(HeaderSource, 0, HeaderSource.Length, new TextPosition(), LanguageKind.Cpp, CppLexer.LexMode.DeclarationsOnly))
+            {
+                IEnumerable<CppToken> tokens = lexer.Tokenize();
+                return tokens.Count();
+            }
+        }
+
         [Benchmark]
         public int ParseCpp()
         {
@@ -5,17 +5,21 @@ using TSP.DoxygenEditor.Languages.Cpp;
 using TSP.DoxygenEditor.Languages;
 using TSP.DoxygenEditor.TextAnalysis;
 using TSP.DoxygenEditor.Languages.Doxygen;
+using TSP.DoxygenEditor.Languages.Html;
+using TSP.DoxygenEditor.Lexers;
 
 namespace Benchmarks
 {
     [MinColumn, MaxColumn, MedianColumn]
     public class DoxygenBenchmarks
     {
-        [ParamsSource(nameof(DocBlocks))]
         public string BlockSource { get; set; }
 
         public string[] DocBlocks { get; set; }
 
+        private readonly HtmlScanner _htmlScanner = new HtmlScanner();
+        private readonly List<IBaseToken> _htmlTokens = new List<IBaseToken>();
+
         [GlobalSetup]
         public void GlobalSetup()
         {
@@ -43,5 +47,35 @@ namespace Benchmarks
                 return tokens.Count();
             }
         }
+
+        [Benchmark]
+        public int LexDoxygenBlocks()
+        {
+            // Lexes each documentation block on its own, just like the editor does
+            int result = 0;
+            foreach (string block in DocBlocks)
+            {
+                using (DoxygenBlockLexer lexer = new DoxygenBlockLexer(block, 0, block.Length, new TextPosition()))
+                {
+                    IEnumerable<DoxygenToken> tokens = lexer.Tokenize();
+                    result += tokens.Count();
+                }
+            }
+            return result;
+        }
+
+        [Benchmark]
+        public int ScanHtmlBlocks()
+        {
+            // Reuses one scanner for all blocks, just like the editor does
+            int result = 0;
+            foreach (string block in DocBlocks)
+            {
+                result += _htmlScanner.Scan(block, 0, block.Length, new TextPosition(), _htmlTokens);
+                HtmlTokenPool.Release(_htmlTokens.Cast<HtmlToken>());
+                _htmlTokens.Clear();
+            }
+            return result;
+        }
     }
 }
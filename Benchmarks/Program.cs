@@ -36,6 +36,7 @@ namespace Benchmarks
             BenchmarkRunner.Run<TextStreamBenchmarks>(config);
             //BenchmarkRunner.Run<CppBenchmarks>(config);
             //BenchmarkRunner.Run<DoxygenBenchmarks>();
+            //BenchmarkRunner.Run<SymbolBenchmarks>(config);
             //BenchmarkSwitcher.FromAssembly(typeof(Program).Assembly).Run(args);
 
             //var b = new TextStreamBenchmarks();
@@ -0,0 +1,64 @@
+﻿using BenchmarkDotNet.Attributes;
+using System.Collections.Generic;
+using System.Linq;
+using TSP.DoxygenEditor.Languages;
+using TSP.DoxygenEditor.Symbols;
+using TSP.DoxygenEditor.TextAnalysis;
+
+namespace Benchmarks
+{
+    [MinColumn, MaxColumn, MedianColumn]
+    public class SymbolBenchmarks
+    {
+        // Names like size_t or uint32_t, which are referenced by every include table
+        private const int SharedNameCount = 200;
+        private const int UniqueNameCount = 64;
+        private const int BatchSize = 64;
+
+        [Params(500, 2000, 4000)]
+        public int TableCount { get; set; }
+
+        public SymbolTable[] Tables { get; set; }
+
+        public SymbolReferenceIndex FullIndex { get; set; }
+
+        private static SymbolTable CreateTable(int id)
+        {
+            SymbolTable result = new SymbolTable(new SimpleSymbolTableId(id));
+            int index = 0;
+            for (int i = 0; i < SharedNameCount + UniqueNameCount; ++i)
+            {
+                string name = i < SharedNameCount ? $"shared{i}" : $"table{id}_name{i}";
+                result.AddReference(new ReferenceSymbol(LanguageKind.Cpp, ReferenceSymbolKind.CppType, name, new TextRange(new TextPosition(index), name.Length), null));
+                index += name.Length + 1;
+            }
+            return (result);
+        }
+
+        [GlobalSetup]
+        public void GlobalSetup()
+        {
+            Tables = Enumerable.Range(0, TableCount).Select(i => CreateTable(i)).ToArray();
+            FullIndex = new SymbolReferenceIndex();
+            FullIndex.ReplaceTables(Tables);
+        }
+
+        [Benchmark]
+        public int PublishTablesInBatches()
+        {
+            // Same as the include loader, which publishes its tables in batches
+            SymbolReferenceIndex index = new SymbolReferenceIndex();
+            for (int i = 0; i < Tables.Length; i += BatchSize)
+                index.ReplaceTables(Tables.Skip(i).Take(BatchSize));
+            return (index.GetReferenceCount("shared0"));
+        }
+
+        [Benchmark]
+        public int RepublishTable()
+        {
+            // Same as an editor, which republishes its table on every parse
+            FullIndex.ReplaceTable(Tables[Tables.Length / 2]);
+            return (FullIndex.GetReferenceCount("shared0"));
+        }
+    }
+}
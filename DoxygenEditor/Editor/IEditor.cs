@@ -24,9 +24,12 @@ namespace TSP.DoxygenEditor.Editor
 
         IParseInfo ParseInfo { get; }
 
+        int CaretPosition { get; }
+
         Panel ContainerPanel { get; }
 
         event EventHandler TabUpdating;
+        event EventHandler CaretChanged;
         event FocusChangedEventHandler FocusChanged;
         event ParseEventHandler ParseCompleted;
         event ParseEventHandler ParseStarting;
@@ -34,6 +37,8 @@ namespace TSP.DoxygenEditor.Editor
 
         void Stop();
         void Reparse();
+        bool ReleaseParseState();
+        void RestoreParseState();
 
         void ShowSearch();
         void ShowReplace();
@@ -56,6 +61,7 @@ namespace TSP.DoxygenEditor.Editor
         void SetText(string text);
         void SetFocus();
 
+        string GetSymbolName(int position);
         void GoToPosition(int position);
         void GoToLine(int lineIndex);
     }
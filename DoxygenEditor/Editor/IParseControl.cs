@@ -3,7 +3,8 @@
     interface IParseControl
     {
         bool IsParsing();
-        void StartParsing(string text);
+        void StartParsing(string text, int previewLength = 0);
         void StopParsing();
+        void ReleaseState();
     }
 }
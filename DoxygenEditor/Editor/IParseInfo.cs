@@ -14,5 +14,7 @@ namespace TSP.DoxygenEditor.Editor
         IBaseNode DoxyConfigTree { get; }
         IBaseNode CppTree { get; }
         SymbolTable LocalSymbolTable { get; }
+        long RetainedSize { get; }
+        bool IsReleased { get; }
     }
 }
@@ -3,6 +3,7 @@ using System.Collections.Generic;
 using System.ComponentModel;
 using System.Diagnostics;
 using System.Linq;
+using System.Text;
 using TSP.DoxygenEditor.Extensions;
 using TSP.DoxygenEditor.Languages;
 using TSP.DoxygenEditor.Languages.Cpp;
@@ -23,18 +24,31 @@ namespace TSP.DoxygenEditor.Editor
         private readonly List<IBaseToken> _tokens = new List<IBaseToken>();
         private readonly List<TextError> _errors = new List<TextError>();
         private readonly List<PerformanceItemModel> _performanceItems = new List<PerformanceItemModel>();
+        private readonly DoxygenBlockCache _blockCache = new DoxygenBlockCache();
+        private readonly HtmlScanner _htmlScanner = new HtmlScanner();
         public IEnumerable<TextError> Errors => _errors;
         public IEnumerable<PerformanceItemModel> PerformanceItems => _performanceItems;
         public IBaseNode DoxyBlockTree { get; private set; }
         public IBaseNode DoxyConfigTree { get; private set; }
         public IBaseNode CppTree { get; private set; }
         public SymbolTable LocalSymbolTable { get; private set; }
+        public long RetainedSize { get; private set; }
+        public bool IsReleased { get; private set; }
         public delegate void ParseEventHandler(object sender);
+        public delegate void ParsePreviewEventHandler(object sender, int previewLength);
         public event ParseEventHandler ParseCompleted;
         public event ParseEventHandler ParseStarting;
+        public event ParsePreviewEventHandler ParsePreviewCompleted;
         private readonly IEditor _editor;
         private readonly IStylerData _stylerRefresh;
 
+        // @NOTE(final): Above this size the tokens are streamed in windows and released right after styling, no trees and no symbols are built
+        private const int LargeFileThreshold = 8 * 1024 * 1024;
+        private const int LargeFileWindowLength = 256 * 1024;
+        private const long LargeFileMemoryBudget = 512L * 1024 * 1024;
+        private const int LargeFileMaxErrorCount = 1000;
+        private const int EstimatedTokenSize = 96;
+
         public bool IsParsing()
         {
             return _parseWorker.IsBusy;
@@ -51,12 +65,29 @@ namespace TSP.DoxygenEditor.Editor
             LocalSymbolTable = new SymbolTable(editor);
             _parseWorker = new BackgroundWorker();
             _parseWorker.WorkerSupportsCancellation = true;
+            _parseWorker.WorkerReportsProgress = true;
             _parseWorker.DoWork += (s, e) =>
             {
                 // @TODO(final): Support for incremental parsing, so only changes are applied
-                string text = (string)e.Argument;
-                Tokenize(text);
-                Parse(text, _stylerRefresh);
+                ParseRequest request = (ParseRequest)e.Argument;
+                string text = request.Text;
+                if (request.PreviewLength > 0 && request.PreviewLength < text.Length)
+                {
+                    if (TokenizePreview(text, request.PreviewLength, _stylerRefresh))
+                        _parseWorker.ReportProgress(0, request.PreviewLength);
+                }
+                if (IsLargeFile(text))
+                    TokenizeLargeFile(text, _stylerRefresh);
+                else
+                {
+                    Tokenize(text);
+                    Parse(text, _stylerRefresh);
+                }
+                RetainedSize = (long)_tokens.Count * EstimatedTokenSize + _blockCache.EstimatedSize + _stylerRefresh.EstimatedSize;
+            };
+            _parseWorker.ProgressChanged += (s, e) =>
+            {
+                ParsePreviewCompleted?.Invoke(this, (int)e.UserState);
             };
             _parseWorker.RunWorkerCompleted += (s, e) =>
             {
@@ -91,283 +122,292 @@ namespace TSP.DoxygenEditor.Editor
         }
         #endregion
         
-        public void StartParsing(string text)
+        class ParseRequest
         {
+            public string Text { get; }
+            public int PreviewLength { get; }
+            public ParseRequest(string text, int previewLength)
+            {
+                Text = text;
+                PreviewLength = previewLength;
+            }
+        }
+
+        /// <summary>
+        /// Starts parsing the text in the background.
+        /// When a preview length is given, the styles for the text up to that length are published through <see cref="ParsePreviewCompleted"/> before the full text is parsed.
+        /// </summary>
+        public void StartParsing(string text, int previewLength = 0)
+        {
+            IsReleased = false;
             ParseStarting?.Invoke(this);
-            _parseWorker.RunWorkerAsync(text);
+            _parseWorker.RunWorkerAsync(new ParseRequest(text, previewLength));
         }
         public void StopParsing()
         {
             _parseWorker.CancelAsync();
         }
 
+        /// <summary>
+        /// Releases the tokens, the block cache and the style data, which are only needed again by the next parse.
+        /// The trees, errors and the symbol table are kept, so the symbols stay published and the issues stay valid.
+        /// </summary>
+        public void ReleaseState()
+        {
+            Debug.Assert(!IsParsing());
+            GiveTokensBackToPool();
+            _tokens.Clear();
+            _tokens.TrimExcess();
+            _blockCache.Clear();
+            _stylerRefresh.ReleaseData();
+            RetainedSize = 0;
+            IsReleased = true;
+        }
+
         class TokenizerTimingStats
         {
             public TimeSpan CppDuration = new TimeSpan();
             public TimeSpan DoxyDuration = new TimeSpan();
             public TimeSpan HtmlDuration = new TimeSpan();
-            public TimeSpan InsertDuration = new TimeSpan();
-
-            public static TokenizerTimingStats operator +(TokenizerTimingStats a, TokenizerTimingStats b)
-            {
-                TokenizerTimingStats result = new TokenizerTimingStats();
-                result.CppDuration = a.CppDuration + b.CppDuration;
-                result.DoxyDuration = a.DoxyDuration + b.DoxyDuration;
-                result.HtmlDuration = a.HtmlDuration + b.HtmlDuration;
-                result.InsertDuration = a.InsertDuration + b.InsertDuration;
-                return (result);
-            }
         }
 
-        class TokenizeResult : IDisposable
+        /// <summary>
+        /// Token and error buffer shared by all nested lexers, so every token is appended exactly once.
+        /// </summary>
+        class TokenizeResult
         {
-            private readonly List<IBaseToken> _tokens = new List<IBaseToken>();
-            private readonly List<TextError> _errors = new List<TextError>();
-            public IEnumerable<IBaseToken> Tokens => _tokens;
-            public IEnumerable<TextError> Errors => _errors;
+            private readonly List<IBaseToken> _tokens;
+            private readonly List<TextError> _errors;
             public TokenizerTimingStats Stats { get; }
-            public TokenizeResult()
+            public TokenizeResult(List<IBaseToken> tokens, List<TextError> errors)
             {
+                _tokens = tokens;
+                _errors = errors;
                 Stats = new TokenizerTimingStats();
             }
             public void AddErrors(IEnumerable<TextError> errors)
             {
                 _errors.AddRange(errors);
             }
-            public void AddTokens(IEnumerable<IBaseToken> inTokens)
-            {
-                Stopwatch w = Stopwatch.StartNew();
-                _tokens.AddRange(inTokens);
-                w.Stop();
-                Stats.InsertDuration += w.Elapsed;
-            }
             public void AddToken(IBaseToken token)
             {
-                Stopwatch w = Stopwatch.StartNew();
                 _tokens.Add(token);
-                w.Stop();
-                Stats.InsertDuration += w.Elapsed;
             }
-
-            protected virtual void Dispose(bool disposing)
+            public void AddTokens(IEnumerable<IBaseToken> tokens)
             {
-                if (disposing)
-                {
-                    _tokens.Clear();
-                    _errors.Clear();
-                }
+                _tokens.AddRange(tokens);
             }
-
-            public void Dispose()
+            public int ScanHtml(HtmlScanner scanner, string text, int index, int length, TextPosition pos)
             {
-                Dispose(true);
-                GC.SuppressFinalize(this);
+                return scanner.Scan(text, index, length, pos, _tokens);
             }
+            public int TokenCount => _tokens.Count;
+            public int ErrorCount => _errors.Count;
+            public List<IBaseToken> GetTokens(int start) => _tokens.GetRange(start, _tokens.Count - start);
+            public List<TextError> GetErrors(int start) => _errors.GetRange(start, _errors.Count - start);
         }
 
-        private TokenizeResult TokenizeCpp(string text, int index, int length, TextPosition pos, LanguageKind lang)
+        private void TokenizeCpp(string text, int index, int length, TextPosition pos, LanguageKind lang, TokenizeResult result)
         {
-            TokenizeResult result = new TokenizeResult();
-            Stopwatch timer = new Stopwatch();
-            timer.Restart();
-            List<CppToken> cppTokens = new List<CppToken>();
-            using (CppLexer cppLexer = new CppLexer(text, index, length, pos, lang))
+            Stopwatch timer = Stopwatch.StartNew();
+            // Code blocks inside of documentation are always lexed entirely
+            CppPreprocessorDefines defines = lang == LanguageKind.Cpp ? _workspace.ParserCpp.CreateDefines() : null;
+            using (CppLexer cppLexer = new CppLexer(text, index, length, pos, lang, CppLexer.LexMode.Full, defines))
             {
-                cppTokens.AddRange(cppLexer.Tokenize());
+                IEnumerable<CppToken> cppTokens = cppLexer.Tokenize();
+                timer.Stop();
+                result.Stats.CppDuration += timer.Elapsed;
                 result.AddErrors(cppLexer.LexErrors);
-            }
-            timer.Stop();
-            result.Stats.CppDuration += timer.Elapsed;
-            foreach (CppToken token in cppTokens)
-            {
-                if ((lang == LanguageKind.Cpp) && (token.Kind == CppTokenKind.MultiLineCommentDoc || token.Kind == CppTokenKind.SingleLineCommentDoc))
+                foreach (CppToken token in cppTokens)
                 {
                     result.AddToken(token);
-                    using (TokenizeResult doxyRes = TokenizeDoxy(text, token.Index, token.Length, token.Position))
-                    {
-                        result.Stats.DoxyDuration += doxyRes.Stats.DoxyDuration;
-                        result.Stats.HtmlDuration += doxyRes.Stats.HtmlDuration;
-                        result.AddTokens(doxyRes.Tokens);
-                        result.AddErrors(doxyRes.Errors);
-                    }
+                    if ((lang == LanguageKind.Cpp) && (token.Kind == CppTokenKind.MultiLineCommentDoc || token.Kind == CppTokenKind.SingleLineCommentDoc))
+                        TokenizeDoxy(text, token.Index, token.Length, token.Position, result);
                 }
-                else result.AddToken(token);
             }
-            return (result);
         }
 
-        private TokenizeResult TokenizeHtml(string text, int index, int length, TextPosition pos)
+        private void TokenizeHtml(string text, int index, int length, TextPosition pos, TokenizeResult result)
         {
-            TokenizeResult result = new TokenizeResult();
-            Stopwatch timer = Stopwatch.StartNew();
-            using (HtmlLexer htmlLexer = new HtmlLexer(text, index, length, pos))
-            {
-                IEnumerable<HtmlToken> htmlTokens = htmlLexer.Tokenize();
-                if (htmlTokens.FirstOrDefault(d => !d.IsEOF) != null)
-                    result.AddTokens(htmlTokens);
-                result.AddErrors(htmlLexer.LexErrors);
-            }
-            timer.Stop();
-            result.Stats.HtmlDuration += timer.Elapsed;
-            return (result);
+            // @NOTE(final): Called for every text run, so the scanner is reused and the timing does not allocate a stopwatch
+            long startTimestamp = Stopwatch.GetTimestamp();
+            result.ScanHtml(_htmlScanner, text, index, length, pos);
+            long elapsed = Stopwatch.GetTimestamp() - startTimestamp;
+            result.Stats.HtmlDuration += TimeSpan.FromTicks(elapsed * TimeSpan.TicksPerSecond / Stopwatch.Frequency);
         }
 
-        class CommandStartState
+        private void TokenizeDoxy(string text, int index, int length, TextPosition pos, TokenizeResult result)
         {
-            public TextPosition StartPosition { get; set; }
-            public string CommandName { get; }
-            public List<DoxygenToken> ArgTokens { get; }
-            public DoxygenToken CommandToken { get; }
+            Stopwatch timer = Stopwatch.StartNew();
 
-            public CommandStartState(DoxygenToken commandToken, string commandName)
+            // Unchanged blocks are taken from the cache, including all nested code and html tokens
+            List<IBaseToken> cachedTokens;
+            List<TextError> cachedErrors;
+            // @NOTE(final): Issues are grouped by the type of the error tag, so cached errors are tagged with the lexer type instead of the disposed lexer
+            if (_blockCache.TryGetTokens(text, index, length, pos, typeof(DoxygenBlockLexer), out cachedTokens, out cachedErrors))
             {
-                CommandToken = commandToken;
-                CommandName = commandName;
-                ArgTokens = new List<DoxygenToken>();
-                StartPosition = commandToken.Position;
+                result.AddTokens(cachedTokens);
+                result.AddErrors(cachedErrors);
+                timer.Stop();
+                result.Stats.DoxyDuration += timer.Elapsed;
+                return;
             }
+
+            timer.Stop();
+            result.Stats.DoxyDuration += timer.Elapsed;
+
+            int tokenStart = result.TokenCount;
+            int errorStart = result.ErrorCount;
+            LexDoxy(text, index, length, pos, result);
+            _blockCache.AddTokens(text, index, length, pos, result.GetTokens(tokenStart), result.GetErrors(errorStart));
         }
 
-        private TokenizeResult TokenizeDoxy(string text, int index, int length, TextPosition pos)
+        private void LexDoxy(string text, int index, int length, TextPosition pos, TokenizeResult result)
         {
-            TokenizeResult result = new TokenizeResult();
-
-            Stopwatch timer = new Stopwatch();
-            timer.Restart();
-            List<DoxygenToken> doxyTokens = new List<DoxygenToken>();
+            Stopwatch timer = Stopwatch.StartNew();
             using (DoxygenBlockLexer doxyLexer = new DoxygenBlockLexer(text, index, length, pos))
             {
-                doxyTokens.AddRange(doxyLexer.Tokenize());
+                IEnumerable<DoxygenToken> doxyTokens = doxyLexer.Tokenize();
+                timer.Stop();
+                result.Stats.DoxyDuration += timer.Elapsed;
                 result.AddErrors(doxyLexer.LexErrors);
-            }
-            timer.Stop();
-            result.Stats.DoxyDuration += timer.Elapsed;
 
-            Stack<CommandStartState> startStates = new Stack<CommandStartState>();
-            Stack<DoxygenToken> textStartTokens = new Stack<DoxygenToken>();
-            LinkedList<DoxygenToken> doxyTokenList = new LinkedList<DoxygenToken>(doxyTokens);
-            LinkedListNode<DoxygenToken> curLink = doxyTokenList.First;
-            while (curLink != null)
-            {
-                DoxygenToken doxyToken = curLink.Value;
-                if (doxyToken.Kind == DoxygenTokenKind.CommandStart)
+                // @NOTE(final): The lexer already emits the code ranges and never nests text ranges, so a single pass is enough
+                DoxygenToken textStartToken = null;
+                foreach (DoxygenToken doxyToken in doxyTokens)
                 {
-                    result.AddToken(doxyToken);
-                    string commandName = text.Substring(doxyToken.Index + 1, doxyToken.Length - 1);
-                    List<DoxygenToken> argTokens = new List<DoxygenToken>();
-                    if (curLink.Next != null)
+                    if (doxyToken.Kind == DoxygenTokenKind.TextStart)
+                        textStartToken = doxyToken;
+                    else if (doxyToken.Kind == DoxygenTokenKind.TextEnd && textStartToken != null)
                     {
-                        LinkedListNode<DoxygenToken> nextLink = curLink.Next;
-                        while (nextLink != null)
-                        {
-                            if (nextLink.Value.IsArgument)
-                            {
-                                argTokens.Add(nextLink.Value);
-                            }
-                            else
-                                break;
-                            nextLink = nextLink.Next;
-                        }
-                        curLink = nextLink;
+                        Debug.Assert(doxyToken.Index >= textStartToken.Index);
+                        TokenizeHtml(text, textStartToken.Index, doxyToken.Index - textStartToken.Index, textStartToken.Position, result);
+                        textStartToken = null;
                     }
-                    else
-                        curLink = null;
+                    result.AddToken(doxyToken);
+                    if (doxyToken.Kind == DoxygenTokenKind.Code)
+                        TokenizeCpp(text, doxyToken.Index, doxyToken.Length, doxyToken.Position, LanguageKind.DoxygenCode, result);
+                }
+            }
+        }
 
-                    result.AddTokens(argTokens);
+        private static void GiveTokensBackToPool(List<IBaseToken> tokens)
+        {
+            CppTokenPool.Release(tokens.Where(t => typeof(CppToken).Equals(t.GetType())).Select(t => (CppToken)t));
+            DoxygenTokenPool.Release(tokens.Where(t => typeof(DoxygenToken).Equals(t.GetType())).Select(t => (DoxygenToken)t));
+            HtmlTokenPool.Release(tokens.Where(t => typeof(HtmlToken).Equals(t.GetType())).Select(t => (HtmlToken)t));
+        }
 
-                    CommandStartState startState = new CommandStartState(doxyToken, commandName);
-                    startState.ArgTokens.AddRange(argTokens);
-                    startStates.Push(startState);
+        private void GiveTokensBackToPool()
+        {
+            GiveTokensBackToPool(_tokens);
+        }
 
-                    if (argTokens.Count > 0)
-                    {
-                        DoxygenToken last = argTokens.Last();
-                        startState.StartPosition = new TextPosition(last.End + 1, last.Position.Line, last.Position.Column + 1);
-                    }
-                    else
-                        startState.StartPosition = new TextPosition(doxyToken.End + 1, doxyToken.Position.Line, doxyToken.Position.Column + 1);
+        private bool TokenizePreview(string text, int length, IStylerData stylerData)
+        {
+            // @NOTE(final): The lexers start at the top of the document, which is always a safe state, so the preview tokens match the ones of the full pass, except for the tokens crossing the end of the preview.
+            // Lexed documentation blocks are added to the block cache, so the full pass does not lex them again.
+            if (_editor.FileType != EditorFileType.Cpp && _editor.FileType != EditorFileType.DoxyDocs)
+                return (false);
+            List<IBaseToken> tokens = new List<IBaseToken>();
+            TokenizeResult result = new TokenizeResult(tokens, new List<TextError>());
+            TokenizeCpp(text, 0, length, new TextPosition(0), LanguageKind.Cpp, result);
+            stylerData.RefreshPreview(tokens, text, length);
+            GiveTokensBackToPool(tokens);
+            return (true);
+        }
 
-                    continue;
-                }
+        private bool IsLargeFile(string text)
+        {
+            bool result = (_editor.FileType == EditorFileType.Cpp || _editor.FileType == EditorFileType.DoxyDocs) && text.Length >= LargeFileThreshold;
+            return (result);
+        }
 
-                if (doxyToken.Kind == DoxygenTokenKind.CommandEnd)
-                {
-                    string commandName = text.Substring(doxyToken.Index + 1, doxyToken.Length - 1);
-                    CommandStartState topStartState = startStates.Count > 0 ? startStates.Peek() : null;
-                    if (topStartState != null)
-                    {
-                        DoxygenSyntax.CommandRule rule = DoxygenSyntax.GetCommandRule(commandName);
-                        Debug.Assert(rule != null && rule.Kind == DoxygenSyntax.CommandKind.EndCommandBlock);
-                        DoxygenSyntax.EndBlockCommandRule endRule = rule as DoxygenSyntax.EndBlockCommandRule;
-                        Debug.Assert(endRule != null);
-                        if (endRule.StartCommandNames.Contains(topStartState.CommandName))
-                        {
-                            TextPosition commandContentStart = topStartState.StartPosition;
-                            TextPosition commandContentEnd = doxyToken.Position;
-                            Debug.Assert(commandContentEnd.Index >= commandContentStart.Index);
-                            int commandContentLength = commandContentEnd.Index - commandContentStart.Index;
-
-                            // Special handling for code block
-                            if ("code".Equals(topStartState.CommandName))
-                            {
-                                string codeType = null;
-                                DoxygenToken firstArgToken = topStartState.ArgTokens.FirstOrDefault();
-                                if (firstArgToken != null && firstArgToken.Kind == DoxygenTokenKind.ArgumentCaption)
-                                    codeType = text.Substring(firstArgToken.Index, firstArgToken.Length);
-                                if ("{.c}".Equals(codeType, StringComparison.InvariantCultureIgnoreCase) || "{.cpp}".Equals(codeType, StringComparison.InvariantCultureIgnoreCase))
-                                {
-                                    DoxygenToken codeRangedToken = DoxygenTokenPool.Make(DoxygenTokenKind.Code, new TextRange(commandContentStart, commandContentLength), true);
-                                    result.AddToken(codeRangedToken);
-                                    using (TokenizeResult cppRes = TokenizeCpp(text, commandContentStart.Index, commandContentLength, commandContentStart, LanguageKind.DoxygenCode))
-                                    {
-                                        result.AddTokens(cppRes.Tokens);
-                                        result.AddErrors(cppRes.Errors);
-                                    }
-                                }
-                            }
-                            startStates.Pop();
-                        }
-                    }
-                    else
-                    {
-                        // @TODO(final): Print error (Command end without command start)
-                    }
-                    result.AddToken(doxyToken);
-                }
-                else if (doxyToken.Kind == DoxygenTokenKind.TextStart)
-                {
-                    textStartTokens.Push(doxyToken);
-                    result.AddToken(doxyToken);
-                }
-                else if (doxyToken.Kind == DoxygenTokenKind.TextEnd)
+        class LargeFileStats
+        {
+            public int WindowCount = 0;
+            public int TokenCount = 0;
+            public long PeakWindowSize = 0;
+        }
+
+        private IEnumerable<IBaseToken> StreamLargeFileTokens(string text, TokenizeResult result, List<IBaseToken> windowTokens, LargeFileStats stats)
+        {
+            CppPreprocessorDefines defines = _workspace.ParserCpp.CreateDefines();
+            using (CppLexer cppLexer = new CppLexer(text, 0, text.Length, new TextPosition(0), LanguageKind.Cpp, CppLexer.LexMode.Full, defines))
+            {
+                IEnumerable<CppToken> cppTokens;
+                while (true)
                 {
-                    if (textStartTokens.Count > 0)
+                    Stopwatch timer = Stopwatch.StartNew();
+                    bool hasWindow = cppLexer.TokenizeWindow(LargeFileWindowLength, out cppTokens);
+                    timer.Stop();
+                    result.Stats.CppDuration += timer.Elapsed;
+                    if (!hasWindow)
+                        break;
+
+                    // Documentation blocks are lexed without the block cache, which would keep all of them resident
+                    foreach (CppToken token in cppTokens)
                     {
-                        DoxygenToken textStartToken = textStartTokens.Pop();
-                        Debug.Assert(doxyToken.Index >= textStartToken.Index);
-                        int textContentStart = textStartToken.Index;
-                        int textContentLen = doxyToken.Index - textContentStart;
-                        using (TokenizeResult htmlRes = TokenizeHtml(text, textContentStart, textContentLen, textStartToken.Position))
-                        {
-                            result.AddTokens(htmlRes.Tokens);
-                            result.AddErrors(htmlRes.Errors);
-                            result.Stats.HtmlDuration += htmlRes.Stats.HtmlDuration;
-                        }
+                        result.AddToken(token);
+                        if (token.Kind == CppTokenKind.MultiLineCommentDoc || token.Kind == CppTokenKind.SingleLineCommentDoc)
+                            LexDoxy(text, token.Index, token.Length, token.Position, result);
                     }
-                    result.AddToken(doxyToken);
+
+                    long windowSize = 0;
+                    foreach (IBaseToken token in windowTokens)
+                        windowSize += EstimatedTokenSize + token.Length * sizeof(char);
+                    stats.PeakWindowSize = Math.Max(stats.PeakWindowSize, windowSize);
+                    stats.TokenCount += windowTokens.Count;
+                    ++stats.WindowCount;
+
+                    foreach (IBaseToken token in windowTokens)
+                        yield return token;
+                    GiveTokensBackToPool(windowTokens);
+                    windowTokens.Clear();
+                    if (_errors.Count > LargeFileMaxErrorCount)
+                        _errors.RemoveRange(LargeFileMaxErrorCount, _errors.Count - LargeFileMaxErrorCount);
                 }
-                else
-                    result.AddToken(doxyToken);
-                curLink = curLink.Next;
+                _errors.AddRange(cppLexer.LexErrors.Take(Math.Max(0, LargeFileMaxErrorCount - _errors.Count)));
             }
-            return (result);
         }
 
-        private void GiveTokensBackToPool()
+        private void TokenizeLargeFile(string text, IStylerData stylerData)
         {
-            CppTokenPool.Release(_tokens.Where(t => typeof(CppToken).Equals(t.GetType())).Select(t => (CppToken)t));
-            DoxygenTokenPool.Release(_tokens.Where(t => typeof(DoxygenToken).Equals(t.GetType())).Select(t => (DoxygenToken)t));
-            HtmlTokenPool.Release(_tokens.Where(t => typeof(HtmlToken).Equals(t.GetType())).Select(t => (HtmlToken)t));
+            GiveTokensBackToPool();
+            _tokens.Clear();
+            _errors.Clear();
+            _performanceItems.Clear();
+            LocalSymbolTable.Clear();
+            _blockCache.Clear();
+            DoxyBlockTree = null;
+            CppTree = null;
+
+            // @NOTE(final): The style buffers are the only state kept for the whole document (one style per character and one per byte of the scintilla document).
+            // The old buffers are replaced only after the new ones are built, so both count. Pure ascii text shares one buffer for characters and bytes, otherwise a character takes up to 3 bytes.
+            // When they do not fit into the budget, the document is not styled at all.
+            long documentSize = Encoding.UTF8.GetByteCount(text);
+            long styleSize = stylerData.EstimatedSize + text.Length + (documentSize != text.Length ? documentSize : 0);
+            string budgetText = $"{LargeFileMemoryBudget / (1024 * 1024)} MB budget";
+            if (styleSize > LargeFileMemoryBudget)
+            {
+                stylerData.ClearStyles(text.Length);
+                _performanceItems.Add(new PerformanceItemModel(_editor, _editor.Name, _editor.TabIndex, budgetText, $"{styleSize / (1024 * 1024)} MB styles, not styled", "Large file memory", new TimeSpan()));
+                return;
+            }
+
+            List<IBaseToken> windowTokens = new List<IBaseToken>();
+            TokenizeResult result = new TokenizeResult(windowTokens, _errors);
+            LargeFileStats stats = new LargeFileStats();
+            Stopwatch timer = Stopwatch.StartNew();
+            stylerData.RefreshStyles(StreamLargeFileTokens(text, result, windowTokens, stats), text);
+            timer.Stop();
+            TimeSpan styleDuration = timer.Elapsed - result.Stats.CppDuration - result.Stats.DoxyDuration;
+
+            long usedSize = styleSize + stats.PeakWindowSize;
+            _performanceItems.Add(new PerformanceItemModel(_editor, _editor.Name, _editor.TabIndex, $"{text.Length} chars", $"{stats.TokenCount} tokens in {stats.WindowCount} windows", "C++ lexer (large file)", result.Stats.CppDuration));
+            _performanceItems.Add(new PerformanceItemModel(_editor, _editor.Name, _editor.TabIndex, $"{text.Length} chars", $"{stats.TokenCount} tokens in {stats.WindowCount} windows", "Doxygen block lexer (large file)", result.Stats.DoxyDuration));
+            _performanceItems.Add(new PerformanceItemModel(_editor, _editor.Name, _editor.TabIndex, $"{stats.TokenCount} tokens", $"{text.Length} styles", "Styler (large file)", styleDuration));
+            _performanceItems.Add(new PerformanceItemModel(_editor, _editor.Name, _editor.TabIndex, budgetText, $"{usedSize / (1024 * 1024)} MB used", "Large file memory", new TimeSpan()));
         }
 
         private void Tokenize(string text)
@@ -381,17 +421,15 @@ namespace TSP.DoxygenEditor.Editor
             _performanceItems.Clear();
             LocalSymbolTable.Clear();
 
-            TokenizerTimingStats totalStats = new TokenizerTimingStats();
+            TokenizeResult result = new TokenizeResult(_tokens, _errors);
+            TokenizerTimingStats totalStats = result.Stats;
+
+            _blockCache.BeginParse();
 
             if (_editor.FileType == EditorFileType.Cpp || _editor.FileType == EditorFileType.DoxyDocs)
             {
                 // C++ lexing -> Doxygen (Code -> Cpp) -> (Text -> Html)
-                using (TokenizeResult cppRes = TokenizeCpp(text, 0, text.Length, new TextPosition(0), LanguageKind.Cpp))
-                {
-                    totalStats += cppRes.Stats;
-                    _tokens.AddRange(cppRes.Tokens);
-                    _errors.AddRange(cppRes.Errors);
-                }
+                TokenizeCpp(text, 0, text.Length, new TextPosition(0), LanguageKind.Cpp, result);
                 int countCppTokens = _tokens.Count(t => typeof(CppToken).Equals(t.GetType()));
                 int countHtmlTokens = _tokens.Count(t => typeof(HtmlToken).Equals(t.GetType()));
                 int countDoxyTokens = _tokens.Count(t => typeof(DoxygenToken).Equals(t.GetType()));
@@ -450,7 +488,7 @@ namespace TSP.DoxygenEditor.Editor
             {
                 // Doxygen parsing
                 timer.Restart();
-                using (DoxygenBlockParser doxyParser = new DoxygenBlockParser(_editor))
+                using (DoxygenBlockParser doxyParser = new DoxygenBlockParser(_editor) { BlockCache = _blockCache, IsParallel = Environment.ProcessorCount > 1 })
                 {
                     doxyParser.ParseTokens(text, _tokens);
                     _errors.InsertRange(0, doxyParser.ParseErrors);
@@ -459,7 +497,9 @@ namespace TSP.DoxygenEditor.Editor
                     LocalSymbolTable.AddTable(doxyParser.LocalSymbolTable);
                 }
                 timer.Stop();
+                _blockCache.EndParse();
                 _performanceItems.Add(new PerformanceItemModel(_editor, _editor.Name, _editor.TabIndex, $"{_tokens.Count} tokens", $"{doxyNodeCount} nodes", "Doxygen block parser", timer.Elapsed));
+                _performanceItems.Add(new PerformanceItemModel(_editor, _editor.Name, _editor.TabIndex, $"{_blockCache.Count} blocks", $"{_blockCache.TokenHits} lexed, {_blockCache.ParseHits} parsed", "Doxygen block cache", new TimeSpan()));
 
                 // C++ parsing
                 timer.Restart();
@@ -503,7 +543,7 @@ namespace TSP.DoxygenEditor.Editor
 
             // Refresh data for styler
             timer.Restart();
-            stylerData.RefreshData(_tokens);
+            stylerData.RefreshData(_tokens, text);
             timer.Stop();
             _performanceItems.Add(new PerformanceItemModel(_editor, _editor.Name, _editor.TabIndex, $"{_tokens.Count} tokens", $"{stylerData.Count} styles", "Styler", timer.Elapsed));
         }
@@ -0,0 +1,84 @@
+﻿using System.Collections.Generic;
+using TSP.DoxygenEditor.Models;
+
+namespace TSP.DoxygenEditor.Editor
+{
+    /// <summary>
+    /// Keeps the parse state of all editors within the memory budget of the workspace, by releasing the state of the least recently used editors.
+    /// Released editors keep their symbol tables published and parse again when they are activated.
+    /// </summary>
+    class ParseStateManager
+    {
+        // Most recently used editor first
+        private readonly LinkedList<IEditor> _editors = new LinkedList<IEditor>();
+        private readonly WorkspaceModel _workspace;
+
+        public int ReleasedCount { get; private set; }
+
+        public long RetainedSize
+        {
+            get
+            {
+                long result = 0;
+                foreach (IEditor editor in _editors)
+                    result += editor.ParseInfo.RetainedSize;
+                return (result);
+            }
+        }
+
+        public ParseStateManager(WorkspaceModel workspace)
+        {
+            _workspace = workspace;
+        }
+
+        public void Add(IEditor editor)
+        {
+            _editors.AddFirst(editor);
+        }
+
+        public void Remove(IEditor editor)
+        {
+            _editors.Remove(editor);
+        }
+
+        public void Activate(IEditor editor)
+        {
+            if (_editors.Remove(editor))
+                _editors.AddFirst(editor);
+            editor.RestoreParseState();
+        }
+
+        /// <summary>
+        /// Releases the parse state of the least recently used editors, until the retained size fits into the budget.
+        /// The most recently used editor is never released.
+        /// </summary>
+        public int Trim()
+        {
+            int result = 0;
+            long budget = (long)_workspace.Memory.ParseStateBudget * 1024 * 1024;
+            if (budget > 0)
+            {
+                long retainedSize = RetainedSize;
+                LinkedListNode<IEditor> node = _editors.Last;
+                while (retainedSize > budget && node != null && node != _editors.First)
+                {
+                    IEditor editor = node.Value;
+                    long size = editor.ParseInfo.RetainedSize;
+                    if (size > 0 && editor.ReleaseParseState())
+                    {
+                        retainedSize -= size;
+                        ++result;
+                    }
+                    node = node.Previous;
+                }
+            }
+            ReleasedCount = 0;
+            foreach (IEditor editor in _editors)
+            {
+                if (editor.ParseInfo.IsReleased)
+                    ++ReleasedCount;
+            }
+            return (result);
+        }
+    }
+}
@@ -32,8 +32,11 @@ namespace TSP.DoxygenEditor.Editor
             get { return _editor.ViewWhitespace != WhitespaceMode.Invisible; }
             set { _editor.ViewWhitespace = value ? WhitespaceMode.VisibleAlways : WhitespaceMode.Invisible; }
         }
+
+        public int CaretPosition => _editor.CurrentPosition;
         
         public event EventHandler TabUpdating;
+        public event EventHandler CaretChanged;
         public event FocusChangedEventHandler FocusChanged;
         public event ParseEventHandler ParseCompleted;
         public event ParseEventHandler ParseStarting;
@@ -54,6 +57,7 @@ namespace TSP.DoxygenEditor.Editor
         private readonly Scintilla _editor;
         private int _maxLineNumberCharLength;
         private System.Windows.Forms.Timer _textChangedTimer;
+        private const int MinPreviewLineCount = 100;
 
         class StyleNeededState
         {
@@ -63,8 +67,13 @@ namespace TSP.DoxygenEditor.Editor
             public int EndPos { get; private set; }
             public void Set(int startPos, int endPos)
             {
-                Interlocked.Exchange(ref _value, 1);
-                StartPos = StartPos;
+                // Keep the union of all ranges requested while the styles are outdated
+                if (Interlocked.Exchange(ref _value, 1) > 0)
+                {
+                    startPos = Math.Min(startPos, StartPos);
+                    endPos = Math.Max(endPos, EndPos);
+                }
+                StartPos = startPos;
                 EndPos = endPos;
             }
             public void Reset()
@@ -99,6 +108,17 @@ namespace TSP.DoxygenEditor.Editor
             {
                 ParseStarting?.Invoke(ParseInfo);
             };
+            _parseState.ParsePreviewCompleted += (s, previewLength) =>
+            {
+                // Style the preview range right away, the rest is styled when the parse is done
+                if (!_textChangedTimer.Enabled && _visualStyler.HighlightChanges(_editor))
+                {
+                    int startPos = _editor.GetEndStyled();
+                    int endPos = Math.Min(previewLength, _editor.TextLength) - 1;
+                    if (startPos <= endPos)
+                        _visualStyler.Highlight(_editor, startPos, endPos);
+                }
+            };
 
             // Editor
             _visualStyler = _editorStyler;
@@ -140,16 +160,12 @@ namespace TSP.DoxygenEditor.Editor
             };
             ParseCompleted += (s) =>
             {
+                // Restyle only what has changed since the last parse and what was requested while the styles were outdated, all other styles in scintilla are still valid
+                // When the text was changed during the parse, the styles are outdated already and the pending changes are kept for the next parse
+                if (_textChangedTimer.Enabled || !_visualStyler.HighlightChanges(_editor))
+                    return;
                 if (_styleNeededState.IsSet)
-                    _editor.Colorize(_styleNeededState.StartPos, _styleNeededState.EndPos);
-                else
-                {
-                    int firstLine = _editor.FirstVisibleLine;
-                    int lastLine = firstLine + Math.Max(Math.Min(_editor.LinesOnScreen, _editor.Lines.Count) - 1, 0);
-                    int start = _editor.Lines[firstLine].Position;
-                    int end = _editor.Lines[lastLine].Position + Math.Max(_editor.Lines[lastLine].Length - 1, 0);
-                    _editor.Colorize(start, end);
-                }
+                    _editor.Colorize(_styleNeededState.StartPos, Math.Min(_styleNeededState.EndPos, _editor.TextLength));
             };
         }
 
@@ -159,6 +175,21 @@ namespace TSP.DoxygenEditor.Editor
             ParseControl.StartParsing(GetText());
         }
 
+        public bool ReleaseParseState()
+        {
+            // Only an idle editor is released, pending changes are parsed first
+            if (ParseControl.IsParsing() || _textChangedTimer.Enabled || ParseInfo.IsReleased)
+                return (false);
+            ParseControl.ReleaseState();
+            return (true);
+        }
+
+        public void RestoreParseState()
+        {
+            if (ParseInfo.IsReleased && !ParseControl.IsParsing())
+                ParseControl.StartParsing(GetText());
+        }
+
         #region Editor implementation
         public void ShowSearch()
         {
@@ -245,6 +276,23 @@ namespace TSP.DoxygenEditor.Editor
             _editor.ClearAll();
             _editor.Text = text;
             _editor.EmptyUndoBuffer();
+
+            // Parse right away instead of waiting for the text changed timer and publish the styles for the visible lines first
+            if (!ParseControl.IsParsing())
+            {
+                _textChangedTimer.Stop();
+                ParseControl.StartParsing(_editor.Text, GetPreviewLength());
+            }
+        }
+
+        private int GetPreviewLength()
+        {
+            // @NOTE(final): The preview always starts at the top of the document, so it covers the visible lines of a new editor and one more page for scrolling
+            int linesOnScreen = Math.Max(_editor.LinesOnScreen, MinPreviewLineCount);
+            int lastLine = Math.Min(_editor.FirstVisibleLine + linesOnScreen * 2, _editor.Lines.Count - 1);
+            Line line = _editor.Lines[lastLine];
+            int result = line.Position + line.Length;
+            return (result);
         }
 
         public void SetFocus()
@@ -389,6 +437,18 @@ namespace TSP.DoxygenEditor.Editor
             return (null);
         }
 
+        public string GetSymbolName(int position)
+        {
+            Tuple<string, StyleEntry> textStyle = FindTextStyleFromPosition(position);
+            if (textStyle != null)
+                return (textStyle.Item1);
+            int start = _editor.WordStartPosition(position, true);
+            int end = _editor.WordEndPosition(position, true);
+            if (end > start)
+                return (_editor.GetTextRange(start, end - start));
+            return (null);
+        }
+
         private bool isShownIndicators = false;
         private void ShowIndicators(Point mouse)
         {
@@ -511,6 +571,12 @@ namespace TSP.DoxygenEditor.Editor
                 HideIndicators();
             };
 
+            target.UpdateUI += (s, e) =>
+            {
+                if ((e.Change & UpdateChange.Selection) == UpdateChange.Selection)
+                    CaretChanged?.Invoke(this, new EventArgs());
+            };
+
             Font editorFont = new Font(FontFamily.GenericMonospace, 14.0f, FontStyle.Regular);
             target.StyleResetDefault();
             target.Styles[Style.Default].Font = editorFont.Name;
@@ -549,11 +615,13 @@ namespace TSP.DoxygenEditor.Editor
                 int endLine = thisEditor.LineFromPosition(endPos);
                 startPos = thisEditor.Lines[startLine].Position;
                 endPos = thisEditor.Lines[endLine].Position + Math.Max(thisEditor.Lines[endLine].Length - 1, 0);
-                if (!ParseControl.IsParsing())
+                // @NOTE(final): While the text was changed but not parsed yet, the styles would be applied to the wrong positions, so the range is remembered and styled when the parse is done
+                if (!ParseControl.IsParsing() && !_textChangedTimer.Enabled)
                 {
-                    if (startPos < endPos)
-                        VisualStyler.Highlight(thisEditor, startPos, endPos);
-                    _styleNeededState.Reset();
+                    if (startPos >= endPos || VisualStyler.Highlight(thisEditor, startPos, endPos))
+                        _styleNeededState.Reset();
+                    else
+                        _styleNeededState.Set(startPos, endPos);
                 }
                 else
                     _styleNeededState.Set(startPos, endPos);
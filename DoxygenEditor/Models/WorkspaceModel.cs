@@ -1,6 +1,7 @@
 ﻿using TSP.DoxygenEditor.Services;
 using System.Collections.Generic;
 using System.Diagnostics;
+using TSP.DoxygenEditor.Languages.Cpp;
 
 namespace TSP.DoxygenEditor.Models
 {
@@ -137,23 +138,65 @@ namespace TSP.DoxygenEditor.Models
             public bool ExcludeFunctionBodies { get; internal set; } = false;
             public bool ExcludeFunctionBodySymbols { get; internal set; } = false;
             public bool ExcludeFunctionCallSymbols { get; internal set; } = false;
+            public bool EvaluatePreprocessorConditions { get; internal set; } = false;
+
+            // Defines in the form of "NAME" or "NAME=VALUE", used when evaluating preprocessor conditions
+            public readonly List<string> _preprocessorDefines = new List<string>();
+            public IEnumerable<string> PreprocessorDefines => _preprocessorDefines;
+
+            // Precompiled symbol packs of third-party headers, relative paths are relative to the workspace file
+            public readonly List<string> _symbolPackFiles = new List<string>();
+            public IEnumerable<string> SymbolPackFiles => _symbolPackFiles;
+
             public void Assign(ParserCppOptions other)
             {
                 ExcludeFunctionBodies = other.ExcludeFunctionBodies;
                 ExcludeFunctionBodySymbols = other.ExcludeFunctionBodySymbols;
                 ExcludeFunctionCallSymbols = other.ExcludeFunctionCallSymbols;
+                EvaluatePreprocessorConditions = other.EvaluatePreprocessorConditions;
+                _preprocessorDefines.Clear();
+                _preprocessorDefines.AddRange(other.PreprocessorDefines);
+                _symbolPackFiles.Clear();
+                _symbolPackFiles.AddRange(other.SymbolPackFiles);
             }
             public void Load(IConfigurarionReader reader)
             {
                 ExcludeFunctionBodies = reader.ReadBool(SectionName, () => ExcludeFunctionBodies, false);
                 ExcludeFunctionBodySymbols = reader.ReadBool(SectionName, () => ExcludeFunctionBodySymbols, false);
                 ExcludeFunctionCallSymbols = reader.ReadBool(SectionName, () => ExcludeFunctionCallSymbols, false);
+                EvaluatePreprocessorConditions = reader.ReadBool(SectionName, () => EvaluatePreprocessorConditions, false);
+                _preprocessorDefines.Clear();
+                _preprocessorDefines.AddRange(reader.ReadList(SectionName, () => PreprocessorDefines));
+                _symbolPackFiles.Clear();
+                _symbolPackFiles.AddRange(reader.ReadList(SectionName, () => SymbolPackFiles));
             }
             public void Save(IConfigurarionWriter writer)
             {
                 writer.WriteBool(SectionName, () => ExcludeFunctionBodies, ExcludeFunctionBodies);
                 writer.WriteBool(SectionName, () => ExcludeFunctionBodySymbols, ExcludeFunctionBodySymbols);
                 writer.WriteBool(SectionName, () => ExcludeFunctionCallSymbols, ExcludeFunctionCallSymbols);
+                writer.WriteBool(SectionName, () => EvaluatePreprocessorConditions, EvaluatePreprocessorConditions);
+                writer.WriteList(SectionName, () => PreprocessorDefines, _preprocessorDefines);
+                writer.WriteList(SectionName, () => SymbolPackFiles, _symbolPackFiles);
+            }
+
+            public void UpdatePreprocessorDefines(IEnumerable<string> defines)
+            {
+                _preprocessorDefines.Clear();
+                _preprocessorDefines.AddRange(defines);
+            }
+
+            public void UpdateSymbolPackFiles(IEnumerable<string> files)
+            {
+                _symbolPackFiles.Clear();
+                _symbolPackFiles.AddRange(files);
+            }
+
+            public CppPreprocessorDefines CreateDefines()
+            {
+                if (!EvaluatePreprocessorConditions)
+                    return (null);
+                return (CppPreprocessorDefines.Parse(_preprocessorDefines));
             }
         }
 
@@ -185,11 +228,33 @@ namespace TSP.DoxygenEditor.Models
             }
         }
 
+        public class MemoryOptions : IWorkspaceOptions<MemoryOptions>
+        {
+            const string SectionName = "Memory";
+
+            // Budget in megabytes for the tokens and styles of all open files, zero means unlimited
+            public int ParseStateBudget { get; internal set; } = 1024;
+
+            public void Assign(MemoryOptions other)
+            {
+                ParseStateBudget = other.ParseStateBudget;
+            }
+            public void Load(IConfigurarionReader reader)
+            {
+                ParseStateBudget = reader.ReadInt(SectionName, () => ParseStateBudget, 1024);
+            }
+            public void Save(IConfigurarionWriter writer)
+            {
+                writer.WriteInt(SectionName, () => ParseStateBudget, ParseStateBudget);
+            }
+        }
+
         public ViewOptions View { get; }
         public HistoryOptions History { get; }
         public ParserCppOptions ParserCpp { get; }
         public ValidationCppOptions ValidationCpp { get; }
         public BuildOptions Build { get; }
+        public MemoryOptions Memory { get; }
 
         public WorkspaceModel(string filePath)
         {
@@ -199,6 +264,7 @@ namespace TSP.DoxygenEditor.Models
             ParserCpp = new ParserCppOptions();
             ValidationCpp = new ValidationCppOptions();
             Build = new BuildOptions();
+            Memory = new MemoryOptions();
         }
 
         public void Assign(WorkspaceModel other)
@@ -209,6 +275,7 @@ namespace TSP.DoxygenEditor.Models
             ParserCpp.Assign(other.ParserCpp);
             ValidationCpp.Assign(other.ValidationCpp);
             Build.Assign(other.Build);
+            Memory.Assign(other.Memory);
         }
 
         public static WorkspaceModel Load(string filePath)
@@ -223,6 +290,7 @@ namespace TSP.DoxygenEditor.Models
                 result.ParserCpp.Load(reader);
                 result.ValidationCpp.Load(reader);
                 result.Build.Load(reader);
+                result.Memory.Load(reader);
             }
             return (result);
         }
@@ -237,6 +305,7 @@ namespace TSP.DoxygenEditor.Models
                 ParserCpp.Save(writer);
                 ValidationCpp.Save(writer);
                 Build.Save(writer);
+                Memory.Save(writer);
                 writer.Save(FilePath);
             }
         }
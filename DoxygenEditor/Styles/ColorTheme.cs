@@ -74,6 +74,7 @@ namespace TSP.DoxygenEditor.Styles
         PreprocessorDefine,
         PreprocessorDefineArgument,
         PreprocessorInclude,
+        PreprocessorInactive,
 
         ReservedKeyword,
         GlobalTypeKeyword,
@@ -102,6 +103,7 @@ namespace TSP.DoxygenEditor.Styles
         public static readonly ColorThemeStyle DefaultPreprocessorDefine = new ColorThemeStyle() { Color = Color.BlueViolet };
         public static readonly ColorThemeStyle DefaultPreprocessorDefineArgument = new ColorThemeStyle() { Color = Color.Magenta };
         public static readonly ColorThemeStyle DefaultPreprocessorInclude = new ColorThemeStyle() { Color = Color.Brown };
+        public static readonly ColorThemeStyle DefaultPreprocessorInactive = new ColorThemeStyle() { Color = Color.DarkGray };
 
         public static readonly ColorThemeStyle DefaultReservedKeyword = new ColorThemeStyle() { Color = Color.Blue };
         public static readonly ColorThemeStyle DefaultGlobalTypeKeyword = new ColorThemeStyle() { Color = Color.DarkBlue };
@@ -130,6 +132,7 @@ namespace TSP.DoxygenEditor.Styles
             Set(CppStyleKind.PreprocessorDefine, DefaultPreprocessorDefine);
             Set(CppStyleKind.PreprocessorDefineArgument, DefaultPreprocessorDefineArgument);
             Set(CppStyleKind.PreprocessorInclude, DefaultPreprocessorInclude);
+            Set(CppStyleKind.PreprocessorInactive, DefaultPreprocessorInactive);
 
             Set(CppStyleKind.ReservedKeyword, DefaultReservedKeyword);
             Set(CppStyleKind.GlobalTypeKeyword, DefaultGlobalTypeKeyword);
@@ -3,7 +3,7 @@ using System;
 using System.Collections.Generic;
 using System.Diagnostics;
 using System.Drawing;
-using System.Linq;
+using System.Runtime.CompilerServices;
 using TSP.DoxygenEditor.Extensions;
 using TSP.DoxygenEditor.Languages;
 using TSP.DoxygenEditor.Languages.Cpp;
@@ -30,6 +30,7 @@ namespace TSP.DoxygenEditor.Styles
         static readonly int cppPreprocessorDefineStyle = styleIndex++;
         static readonly int cppPreprocessorDefineArgumentStyle = styleIndex++;
         static readonly int cppPreprocessorIncludeStyle = styleIndex++;
+        static readonly int cppPreprocessorInactiveStyle = styleIndex++;
 
         static readonly int cppReservedKeywordStyle = styleIndex++;
         static readonly int cppGlobalTypeKeywordStyle = styleIndex++;
@@ -56,6 +57,7 @@ namespace TSP.DoxygenEditor.Styles
             { CppTokenKind.PreprocessorDefineMatch, cppPreprocessorDefineStyle },
             { CppTokenKind.PreprocessorDefineArgument, cppPreprocessorDefineArgumentStyle },
             { CppTokenKind.PreprocessorInclude, cppPreprocessorIncludeStyle },
+            { CppTokenKind.PreprocessorInactive, cppPreprocessorInactiveStyle },
 
             { CppTokenKind.ReservedKeyword, cppReservedKeywordStyle },
             { CppTokenKind.GlobalTypeKeyword, cppGlobalTypeKeywordStyle },
@@ -131,8 +133,45 @@ namespace TSP.DoxygenEditor.Styles
             doxygenArgumentStyle,
         };
 
-        private readonly List<StyleEntry> _entries = new List<StyleEntry>();
-        public int Count => _entries.Count;
+        class StyleData
+        {
+            // @NOTE(final): Sorted by index and never overlapping, so any range can be found by a binary search
+            public List<StyleEntry> Entries { get; }
+
+            // @NOTE(final): The styles of the whole document, one per character for finding changes and one per byte of the scintilla document for applying them.
+            // For pure ascii text both are the same array.
+            public byte[] CharStyles { get; }
+            public byte[] DocumentStyles { get; }
+
+            // The length of the parsed text, the styles are only valid while the document has the same length
+            public int TextLength { get; }
+
+            public StyleData(List<StyleEntry> entries, byte[] charStyles, byte[] documentStyles, int textLength)
+            {
+                Entries = entries;
+                CharStyles = charStyles;
+                DocumentStyles = documentStyles;
+                TextLength = textLength;
+            }
+        }
+
+        // @NOTE(final): Replaced as a whole by the parse worker and never modified afterwards, so the UI thread always sees a consistent state, even while the next refresh is running
+        private volatile StyleData _data = new StyleData(new List<StyleEntry>(), new byte[0], new byte[0], 0);
+        private readonly object _changedRangesLock = new object();
+        private List<StyleEntry> _changedRanges = new List<StyleEntry>();
+        public int Count => _data.Entries.Count;
+
+        public long EstimatedSize
+        {
+            get
+            {
+                StyleData data = _data;
+                long result = (long)data.Entries.Capacity * Unsafe.SizeOf<StyleEntry>() + data.CharStyles.Length;
+                if (data.DocumentStyles != data.CharStyles)
+                    result += data.DocumentStyles.Length;
+                return (result);
+            }
+        }
 
         private readonly WorkspaceModel _workspace;
         public EditorStyler(WorkspaceModel workspace)
@@ -140,61 +179,288 @@ namespace TSP.DoxygenEditor.Styles
             _workspace = workspace;
         }
 
+        /// <summary>
+        /// Returns the index of the first entry which ends at or after the given position, or the number of entries when there is none.
+        /// </summary>
+        private static int FindFirstEntry(List<StyleEntry> entries, int position)
+        {
+            int lo = 0;
+            int hi = entries.Count;
+            while (lo < hi)
+            {
+                int mid = lo + ((hi - lo) >> 1);
+                if (entries[mid].End < position)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return (lo);
+        }
+
         public StyleEntry FindStyleFromPosition(int position)
         {
-            StyleEntry result = _entries.FirstOrDefault((e) => allowedMatchStyles.Contains(e.Style) && position >= e.Index && position <= e.End);
-            return (result);
+            List<StyleEntry> entries = _data.Entries;
+            int index = FindFirstEntry(entries, position);
+            if (index < entries.Count)
+            {
+                StyleEntry entry = entries[index];
+                if (position >= entry.Index && allowedMatchStyles.Contains(entry.Style))
+                    return (entry);
+            }
+            return (default(StyleEntry));
         }
 
-        public void RefreshData(IEnumerable<IBaseToken> tokens)
+        private static bool IsSortedAndDisjoint(List<StyleEntry> entries)
         {
-            _entries.Clear();
-            foreach (IBaseToken token in tokens)
+            for (int i = 1; i < entries.Count; ++i)
             {
-                if (token.Length == 0) continue;
-                if (typeof(CppToken).Equals(token.GetType()))
+                if (entries[i].Index < entries[i - 1].Index + entries[i - 1].Length)
+                    return (false);
+            }
+            return (true);
+        }
+
+        private static List<StyleEntry> FlattenEntries(List<StyleEntry> entries)
+        {
+            // @NOTE(final): Tokens are added in lexing order, so the doxygen and html tokens of a comment follow the comment token and overlap it.
+            // The entries are split into non overlapping runs, where the entry added last wins, the same as painting them one after another.
+            if (IsSortedAndDisjoint(entries))
+                return (entries);
+
+            int[] order = new int[entries.Count];
+            for (int i = 0; i < order.Length; ++i)
+                order[i] = i;
+            Array.Sort(order, (a, b) =>
+            {
+                int c = entries[a].Index.CompareTo(entries[b].Index);
+                return (c != 0 ? c : a.CompareTo(b));
+            });
+
+            List<StyleEntry> result = new List<StyleEntry>(entries.Count);
+            List<int> active = new List<int>();
+            int next = 0;
+            int pos = 0;
+            while (next < order.Length || active.Count > 0)
+            {
+                int nextStart = next < order.Length ? entries[order[next]].Index : int.MaxValue;
+                int nextEnd = int.MaxValue;
+                int top = -1;
+                foreach (int a in active)
                 {
-                    CppToken cppToken = (CppToken)token;
-                    int style;
-                    if (cppTokenTypeToStyleDict.TryGetValue(cppToken.Kind, out style))
-                    {
-#if DEBUG
-                        _entries.Add(new StyleEntry(LanguageKind.Cpp, token, style, token.Value));
-#else
-                        _entries.Add(new StyleEntry(LanguageKind.Cpp, token, style));
-#endif
-                    }
+                    nextEnd = Math.Min(nextEnd, entries[a].Index + entries[a].Length);
+                    top = Math.Max(top, a);
                 }
-                else if (typeof(DoxygenToken).Equals(token.GetType()))
+                int boundary = Math.Min(nextStart, nextEnd);
+                if (top != -1 && boundary > pos)
                 {
-                    DoxygenToken doxygenToken = (DoxygenToken)token;
-                    int style;
-                    if (doxygenTokenTypeToStyleDict.TryGetValue(doxygenToken.Kind, out style))
-                    {
-                        LanguageKind styleKind = LanguageKind.Doxygen;
-                        if (doxygenToken.Kind == DoxygenTokenKind.Code)
-                            styleKind = LanguageKind.DoxygenCode;
+                    StyleEntry entry = entries[top];
 #if DEBUG
-                        _entries.Add(new StyleEntry(styleKind, token, style, doxygenToken.Value));
+                    result.Add(new StyleEntry(entry.Lang, pos, boundary - pos, entry.Style, entry.Value));
 #else
-                        _entries.Add(new StyleEntry(styleKind, token, style));
+                    result.Add(new StyleEntry(entry.Lang, pos, boundary - pos, entry.Style));
 #endif
-                    }
                 }
-                else if (typeof(HtmlToken).Equals(token.GetType()))
+                pos = boundary;
+                for (int i = active.Count - 1; i >= 0; --i)
+                {
+                    if (entries[active[i]].Index + entries[active[i]].Length <= boundary)
+                        active.RemoveAt(i);
+                }
+                while (next < order.Length && entries[order[next]].Index == boundary)
+                    active.Add(order[next++]);
+            }
+            return (result);
+        }
+
+        private static byte[] BuildCharStyles(List<StyleEntry> entries, int textLength)
+        {
+            byte[] result = new byte[textLength];
+            foreach (StyleEntry entry in entries)
+            {
+                Debug.Assert(entry.Style <= byte.MaxValue);
+                int length = Math.Min(entry.Length, textLength - entry.Index);
+                if (length > 0)
+                    result.AsSpan(entry.Index, length).Fill((byte)entry.Style);
+            }
+            return (result);
+        }
+
+        private static byte[] BuildDocumentStyles(byte[] charStyles, string text)
+        {
+            // @NOTE(final): Scintilla stores one style for each byte of the UTF-8 document, so the style of a non ascii character is repeated for each of its bytes.
+            // Pure ascii text has the same positions, so the character styles are used directly.
+            // The character styles may cover the start of the text only, see RefreshPreview
+            int charCount = charStyles.Length;
+            int byteCount = 0;
+            for (int i = 0; i < charCount; ++i)
+                byteCount += GetUTF8ByteCount(text, i);
+            if (byteCount == charCount)
+                return (charStyles);
+            byte[] result = new byte[byteCount];
+            int bytePos = 0;
+            for (int i = 0; i < charCount; ++i)
+            {
+                int count = GetUTF8ByteCount(text, i);
+                result.AsSpan(bytePos, count).Fill(charStyles[i]);
+                bytePos += count;
+            }
+            return (result);
+        }
+
+        private static int GetUTF8ByteCount(string text, int index)
+        {
+            char c = text[index];
+            if (c < 0x80)
+                return (1);
+            if (c < 0x800)
+                return (2);
+            // A surrogate pair is 4 bytes in total, a single surrogate is encoded as a replacement character
+            if (char.IsHighSurrogate(c) && index + 1 < text.Length && char.IsLowSurrogate(text[index + 1]))
+                return (2);
+            if (char.IsLowSurrogate(c) && index > 0 && char.IsHighSurrogate(text[index - 1]))
+                return (2);
+            return (3);
+        }
+
+        private static List<StyleEntry> FindChangedRanges(ReadOnlySpan<byte> oldSpan, ReadOnlySpan<byte> newSpan)
+        {
+            // @NOTE(final): Scintilla moves the styles along with the text on each edit, so the equal styles at the start and the equal styles at the end are still valid.
+            // Only the range between them needs to be restyled.
+            const int ChunkSize = 256;
+            List<StyleEntry> result = new List<StyleEntry>();
+            int count = Math.Min(oldSpan.Length, newSpan.Length);
+            int head = 0;
+            while (head + ChunkSize <= count && oldSpan.Slice(head, ChunkSize).SequenceEqual(newSpan.Slice(head, ChunkSize)))
+                head += ChunkSize;
+            while (head < count && oldSpan[head] == newSpan[head])
+                ++head;
+            if (head == oldSpan.Length && head == newSpan.Length)
+                return (result);
+            int tail = 0;
+            while (tail + ChunkSize <= count - head && oldSpan.Slice(oldSpan.Length - tail - ChunkSize, ChunkSize).SequenceEqual(newSpan.Slice(newSpan.Length - tail - ChunkSize, ChunkSize)))
+                tail += ChunkSize;
+            while (tail < count - head && oldSpan[oldSpan.Length - 1 - tail] == newSpan[newSpan.Length - 1 - tail])
+                ++tail;
+            int end = newSpan.Length - 1 - tail;
+            if (head <= end)
+                result.Add(new StyleEntry(LanguageKind.None, head, (end - head) + 1, 0));
+            return (result);
+        }
+
+        private static bool TryGetStyle(IBaseToken token, out LanguageKind lang, out int style)
+        {
+            if (typeof(CppToken).Equals(token.GetType()))
+            {
+                lang = LanguageKind.Cpp;
+                return (cppTokenTypeToStyleDict.TryGetValue(((CppToken)token).Kind, out style));
+            }
+            else if (typeof(DoxygenToken).Equals(token.GetType()))
+            {
+                DoxygenToken doxygenToken = (DoxygenToken)token;
+                lang = doxygenToken.Kind == DoxygenTokenKind.Code ? LanguageKind.DoxygenCode : LanguageKind.Doxygen;
+                return (doxygenTokenTypeToStyleDict.TryGetValue(doxygenToken.Kind, out style));
+            }
+            else if (typeof(HtmlToken).Equals(token.GetType()))
+            {
+                lang = LanguageKind.Html;
+                return (htmlTokenTypeToStyleDict.TryGetValue(((HtmlToken)token).Kind, out style));
+            }
+            lang = LanguageKind.None;
+            style = 0;
+            return (false);
+        }
+
+        private static List<StyleEntry> FindChangedRanges(StyleData oldData, byte[] newStyles, int newTextLength)
+        {
+            if (oldData.CharStyles.Length == oldData.TextLength && newStyles.Length == newTextLength)
+                return (FindChangedRanges(oldData.CharStyles, newStyles));
+
+            // @NOTE(final): A preview covers the start of the text only, so just the common start is compared and everything after it counts as changed
+            int count = Math.Min(oldData.CharStyles.Length, newStyles.Length);
+            List<StyleEntry> result = FindChangedRanges(oldData.CharStyles.AsSpan(0, count), newStyles.AsSpan(0, count));
+            if (newStyles.Length > count)
+                result.Add(new StyleEntry(LanguageKind.None, count, newStyles.Length - count, 0));
+            return (result);
+        }
+
+        private void ReplaceData(List<StyleEntry> entries, byte[] charStyles, string text)
+        {
+            List<StyleEntry> changedRanges = FindChangedRanges(_data, charStyles, text.Length);
+            _data = new StyleData(entries, charStyles, BuildDocumentStyles(charStyles, text), text.Length);
+
+            // The changes are collected until the UI thread applies them, a preview and the following full refresh share the same text
+            lock (_changedRangesLock)
+                _changedRanges.AddRange(changedRanges);
+        }
+
+        private static List<StyleEntry> BuildEntries(IEnumerable<IBaseToken> tokens)
+        {
+            List<StyleEntry> entries = new List<StyleEntry>();
+            foreach (IBaseToken token in tokens)
+            {
+                if (token.Length == 0) continue;
+                LanguageKind lang;
+                int style;
+                if (TryGetStyle(token, out lang, out style))
                 {
-                    HtmlToken htmlToken = (HtmlToken)token;
-                    int style;
-                    if (htmlTokenTypeToStyleDict.TryGetValue(htmlToken.Kind, out style))
-                    {
 #if DEBUG
-                        _entries.Add(new StyleEntry(LanguageKind.Html, token, style, htmlToken.Value));
+                    entries.Add(new StyleEntry(lang, token, style, token.Value));
 #else
-                        _entries.Add(new StyleEntry(LanguageKind.Html, token, style));
+                    entries.Add(new StyleEntry(lang, token, style));
 #endif
-                    }
                 }
             }
+            return (FlattenEntries(entries));
+        }
+
+        public void RefreshData(IEnumerable<IBaseToken> tokens, string text)
+        {
+            List<StyleEntry> newEntries = BuildEntries(tokens);
+            ReplaceData(newEntries, BuildCharStyles(newEntries, text.Length), text);
+        }
+
+        public void RefreshPreview(IEnumerable<IBaseToken> tokens, string text, int length)
+        {
+            // @NOTE(final): Only the styles of the preview range are built, the following full refresh builds the buffers for the whole document and merges its changes with the preview
+            List<StyleEntry> newEntries = BuildEntries(tokens);
+            ReplaceData(newEntries, BuildCharStyles(newEntries, length), text);
+        }
+
+        public void RefreshStyles(IEnumerable<IBaseToken> tokens, string text)
+        {
+            // @NOTE(final): The tokens of very large documents are streamed and released right after, so no style entries are kept.
+            // The tokens are painted in lexing order instead, so nested tokens override their comment the same as in the flattened entries.
+            byte[] charStyles = new byte[text.Length];
+            foreach (IBaseToken token in tokens)
+            {
+                LanguageKind lang;
+                int style;
+                if (token.Length == 0 || !TryGetStyle(token, out lang, out style))
+                    continue;
+                int length = Math.Min(token.Length, text.Length - token.Index);
+                if (length > 0)
+                    charStyles.AsSpan(token.Index, length).Fill((byte)style);
+            }
+            ReplaceData(new List<StyleEntry>(), charStyles, text);
+        }
+
+        public void ClearStyles(int textLength)
+        {
+            // No style buffers at all, the whole text is styled with the default style
+            _data = new StyleData(new List<StyleEntry>(), new byte[0], new byte[0], textLength);
+            lock (_changedRangesLock)
+            {
+                if (textLength > 0)
+                    _changedRanges.Add(new StyleEntry(LanguageKind.None, 0, textLength, 0));
+            }
+        }
+
+        public void ReleaseData()
+        {
+            // @NOTE(final): Scintilla keeps the applied styles, so nothing changes visually. The next refresh finds the whole document as changed and restyles what was already styled.
+            _data = new StyleData(new List<StyleEntry>(), new byte[0], new byte[0], 0);
+            lock (_changedRangesLock)
+                _changedRanges = new List<StyleEntry>();
         }
 
         private void ApplyCppStyle(Scintilla editor, ColorTheme theme)
@@ -213,6 +479,7 @@ namespace TSP.DoxygenEditor.Styles
             editor.Styles[cppPreprocessorDefineStyle].Set(cppTheme[CppStyleKind.PreprocessorDefine]);
             editor.Styles[cppPreprocessorDefineArgumentStyle].Set(cppTheme[CppStyleKind.PreprocessorDefineArgument]);
             editor.Styles[cppPreprocessorIncludeStyle].Set(cppTheme[CppStyleKind.PreprocessorInclude]);
+            editor.Styles[cppPreprocessorInactiveStyle].Set(cppTheme[CppStyleKind.PreprocessorInactive]);
 
             editor.Styles[cppReservedKeywordStyle].Set(cppTheme[CppStyleKind.ReservedKeyword]);
             editor.Styles[cppGlobalTypeKeywordStyle].Set(cppTheme[CppStyleKind.GlobalTypeKeyword]);
@@ -266,26 +533,55 @@ namespace TSP.DoxygenEditor.Styles
             editor.Indicators[0].ForeColor = Color.Red;
         }
 
-        public void Highlight(Scintilla editor, int startPos, int endPos)
+        public bool Highlight(Scintilla editor, int startPos, int endPos)
         {
-            Debug.Assert(startPos < endPos);
+            StyleData data = _data;
+            return (Highlight(editor, data, startPos, endPos));
+        }
 
-            int length = (endPos - startPos) + 1;
+        private static bool Highlight(Scintilla editor, StyleData data, int startPos, int endPos)
+        {
+            Debug.Assert(startPos <= endPos);
 
-            editor.StartStyling(startPos);
-            editor.SetStyling(length, 0);
+            // @NOTE(final): The styles of an older text would be applied to the wrong positions, so nothing is styled until the parse of the current text is done
+            if (data.TextLength != editor.TextLength)
+                return (false);
 
-            StyleEntry rangeEntry = new StyleEntry(LanguageKind.None, startPos, length, 0);
-            IEnumerable<StyleEntry> intersectingEntries = _entries.Where(r => r.InterectsWith(rangeEntry));
+            // The styles are already computed by the parse worker, so the range is applied with a single call
+            int length = (endPos - startPos) + 1;
+            int styledLength = Math.Max(0, Math.Min(length, data.CharStyles.Length - startPos));
+            editor.StartStyling(startPos);
+            if (styledLength > 0)
+                editor.SetStyling(styledLength, data.DocumentStyles);
+            if (styledLength < length)
+                editor.SetStyling(length - styledLength, 0);
+            return (true);
+        }
 
-            foreach (StyleEntry entry in intersectingEntries)
+        public bool HighlightChanges(Scintilla editor)
+        {
+            // Only the ranges scintilla has already styled are fixed, everything after that is requested on demand anyway
+            // The changed ranges are kept while the document does not match the parsed text, so the next parse still restyles them
+            StyleData data = _data;
+            if (data.TextLength != editor.TextLength)
+                return (false);
+            List<StyleEntry> ranges;
+            lock (_changedRangesLock)
             {
-                int s = Math.Max(startPos, entry.Index);
-                int e = Math.Min(entry.Index + (entry.Length - 1), endPos);
-                int l = (e - s) + 1;
-                editor.StartStyling(s);
-                editor.SetStyling(l, entry.Style);
+                ranges = _changedRanges;
+                _changedRanges = new List<StyleEntry>();
             }
+            int endStyled = Math.Min(editor.GetEndStyled(), editor.TextLength);
+            foreach (StyleEntry range in ranges)
+            {
+                int end = Math.Min(range.End, endStyled - 1);
+                if (range.Index <= end)
+                    Highlight(editor, data, range.Index, end);
+            }
+
+            // Styling moves the end of the styled range, so it is restored to not restyle everything after the last change again
+            editor.StartStyling(endStyled);
+            return (true);
         }
     }
 }
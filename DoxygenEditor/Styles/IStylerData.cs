@@ -6,6 +6,11 @@ namespace TSP.DoxygenEditor.Styles
     interface IStylerData
     {
         int Count { get; }
-        void RefreshData(IEnumerable<IBaseToken> tokens);
+        long EstimatedSize { get; }
+        void RefreshData(IEnumerable<IBaseToken> tokens, string text);
+        void RefreshPreview(IEnumerable<IBaseToken> tokens, string text, int length);
+        void RefreshStyles(IEnumerable<IBaseToken> tokens, string text);
+        void ClearStyles(int textLength);
+        void ReleaseData();
     }
 }
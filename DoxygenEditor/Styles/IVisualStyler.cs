@@ -6,7 +6,8 @@ namespace TSP.DoxygenEditor.Styles
     interface IVisualStyler
     {
         void ApplyStyles(Scintilla editor);
-        void Highlight(Scintilla editor, int startPos, int endPos);
+        bool Highlight(Scintilla editor, int startPos, int endPos);
+        bool HighlightChanges(Scintilla editor);
         StyleEntry FindStyleFromPosition(int position);
     }
 }
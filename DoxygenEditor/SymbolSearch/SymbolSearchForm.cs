@@ -1,5 +1,6 @@
 ﻿using TSP.DoxygenEditor.Models;
 using TSP.DoxygenEditor.SearchReplace;
+using TSP.DoxygenEditor.Symbols;
 using System;
 using System.Collections.Generic;
 using System.Windows.Forms;
@@ -8,7 +9,7 @@ namespace TSP.DoxygenEditor.SymbolSearch
 {
     public partial class SymbolSearchForm : Form
     {
-        private readonly Timer _delayedTextChangeTimer;
+        private const int MaxResultCount = 500;
 
         public string SearchText
         {
@@ -16,13 +17,15 @@ namespace TSP.DoxygenEditor.SymbolSearch
             private set;
         }
 
-        public string SearchType
+        public SourceSymbolKind? SearchType
         {
             get;
             private set;
         }
 
-        private readonly IEnumerable<SymbolItemModel> _allItems;
+        private readonly SymbolSearchIndex _index;
+        private readonly ISymbolTableId _tableId;
+        private readonly Func<SymbolSearchEntry, bool> _scopeFilter;
 
         public SymbolItemModel SelectedItem
         {
@@ -30,20 +33,15 @@ namespace TSP.DoxygenEditor.SymbolSearch
             private set;
         }
 
-        public SymbolSearchForm(IEnumerable<SymbolItemModel> allItems, IEnumerable<string> allSearchTypes)
+        public SymbolSearchForm(SymbolSearchIndex index, ISymbolTableId tableId, Func<SymbolSearchEntry, bool> scopeFilter, IEnumerable<SourceSymbolKind> allSearchTypes)
         {
             InitializeComponent();
-            _allItems = allItems;
+            _index = index;
+            _tableId = tableId;
+            _scopeFilter = scopeFilter;
             DialogResult = DialogResult.Cancel;
 
-            _delayedTextChangeTimer = new Timer() { Enabled = true, Interval = 500 };
-            _delayedTextChangeTimer.Tick += (s, e) =>
-            {
-                _delayedTextChangeTimer.Stop();
-                RefreshSearchResults(_allItems);
-            };
-
-            // @NOTE(final): Disable text and selected index changed event, so that we can call RefreshSearchResults initially - without triggering the timer
+            // @NOTE(final): Disable text and selected index changed event, so that we can call RefreshSearchResults initially - only once
             textBoxSearch.TextChanged -= textBoxSearch_TextChanged;
             comboBoxSearchType.SelectedIndexChanged -= comboBoxSearchType_SelectedIndexChanged;
 
@@ -52,41 +50,45 @@ namespace TSP.DoxygenEditor.SymbolSearch
             comboBoxSearchType.BeginUpdate();
             comboBoxSearchType.Items.Clear();
             comboBoxSearchType.Items.Add("All types");
-            foreach (string t in allSearchTypes)
+            foreach (SourceSymbolKind t in allSearchTypes)
                 comboBoxSearchType.Items.Add(t);
             comboBoxSearchType.EndUpdate();
             comboBoxSearchType.SelectedIndex = 0;
 
-            RefreshSearchResults(allItems);
+            RefreshSearchResults();
 
             // Re-enable text and seleced index changed event
             textBoxSearch.TextChanged += textBoxSearch_TextChanged;
             comboBoxSearchType.SelectedIndexChanged += comboBoxSearchType_SelectedIndexChanged;
         }
 
-        private void RefreshSearchResults(IEnumerable<SymbolItemModel> items)
+        private bool IsMatchingEntry(SymbolSearchEntry entry)
+        {
+            if (_scopeFilter != null && !_scopeFilter(entry))
+                return (false);
+            if (SearchType.HasValue && entry.Symbol.Kind != SearchType.Value)
+                return (false);
+            return (true);
+        }
+
+        private void RefreshSearchResults()
         {
+            // @NOTE(final): The index returns the best matches only, so this is fast enough to run on every keystroke
+            List<SymbolSearchEntry> entries = _index.Search(_tableId, SearchText, MaxResultCount, IsMatchingEntry);
+
             ListViewItem selectedItem = null;
             listViewResults.BeginUpdate();
             listViewResults.Items.Clear();
-            foreach (SymbolItemModel item in items)
+            foreach (SymbolSearchEntry entry in entries)
             {
-                if (SearchType != null)
+                SourceSymbol source = entry.Symbol;
+                SymbolItemModel item = new SymbolItemModel()
                 {
-                    if (!item.Type.Equals(SearchType))
-                        continue;
-                }
-
-                if (!string.IsNullOrEmpty(SearchText))
-                {
-                    bool found = false;
-                    if (item.Caption != null && item.Caption.IndexOf(SearchText, StringComparison.InvariantCultureIgnoreCase) > -1)
-                        found = true;
-                    if (item.Id != null && item.Id.IndexOf(SearchText, StringComparison.InvariantCultureIgnoreCase) > -1)
-                        found = true;
-                    if (!found)
-                        continue;
-                }
+                    Caption = source.Caption,
+                    Id = source.Name,
+                    Type = source.Kind.ToString(),
+                    Position = source.Range.Position,
+                };
 
                 ListViewItem listItem = new ListViewItem();
                 listItem.Tag = item;
@@ -107,16 +109,14 @@ namespace TSP.DoxygenEditor.SymbolSearch
         private void textBoxSearch_TextChanged(object sender, EventArgs e)
         {
             SearchText = textBoxSearch.Text;
-            _delayedTextChangeTimer.Stop();
-            _delayedTextChangeTimer.Start();
+            RefreshSearchResults();
         }
 
         private void comboBoxSearchType_SelectedIndexChanged(object sender, EventArgs e)
         {
-            string v = comboBoxSearchType.SelectedIndex == 0 ? null : (string)comboBoxSearchType.Items[comboBoxSearchType.SelectedIndex];
+            SourceSymbolKind? v = comboBoxSearchType.SelectedIndex == 0 ? null : (SourceSymbolKind?)comboBoxSearchType.Items[comboBoxSearchType.SelectedIndex];
             SearchType = v;
-            _delayedTextChangeTimer.Stop();
-            _delayedTextChangeTimer.Start();
+            RefreshSearchResults();
         }
 
         private void JumpToSelectedItem()
@@ -52,6 +52,7 @@ namespace TSP.DoxygenEditor.Views
             this.miEdit = new System.Windows.Forms.ToolStripMenuItem();
             this.miEditGoTo = new System.Windows.Forms.ToolStripMenuItem();
             this.miEditGoToSymbol = new System.Windows.Forms.ToolStripMenuItem();
+            this.miEditGoToReferences = new System.Windows.Forms.ToolStripMenuItem();
             this.miEditFindAndReplace = new System.Windows.Forms.ToolStripMenuItem();
             this.miEditFindAndReplaceQuickFind = new System.Windows.Forms.ToolStripMenuItem();
             this.miEditFindAndReplaceQuickReplace = new System.Windows.Forms.ToolStripMenuItem();
@@ -70,6 +71,7 @@ namespace TSP.DoxygenEditor.Views
             this.miWorkspaceNew = new System.Windows.Forms.ToolStripMenuItem();
             this.mitWorkspaceLoad = new System.Windows.Forms.ToolStripMenuItem();
             this.miWorkspaceConfiguration = new System.Windows.Forms.ToolStripMenuItem();
+            this.miWorkspaceWriteSymbolPack = new System.Windows.Forms.ToolStripMenuItem();
             this.miBuild = new System.Windows.Forms.ToolStripMenuItem();
             this.miBuildDocumentation = new System.Windows.Forms.ToolStripMenuItem();
             this.miHelp = new System.Windows.Forms.ToolStripMenuItem();
@@ -97,6 +99,9 @@ namespace TSP.DoxygenEditor.Views
             this.tpDoxygenIssues = new System.Windows.Forms.TabPage();
             this.tpCppIssues = new System.Windows.Forms.TabPage();
             this.tpPerformance = new System.Windows.Forms.TabPage();
+            this.tpPreview = new System.Windows.Forms.TabPage();
+            this.tpReferences = new System.Windows.Forms.TabPage();
+            this.wbPreview = new System.Windows.Forms.WebBrowser();
             this.lvPerformance = new System.Windows.Forms.ListView();
             this.columnHeader7 = ((System.Windows.Forms.ColumnHeader)(new System.Windows.Forms.ColumnHeader()));
             this.columnHeader8 = ((System.Windows.Forms.ColumnHeader)(new System.Windows.Forms.ColumnHeader()));
@@ -125,6 +130,7 @@ namespace TSP.DoxygenEditor.Views
             this.dlgSaveFile = new System.Windows.Forms.SaveFileDialog();
             this.dlgOpenWorkspace = new System.Windows.Forms.OpenFileDialog();
             this.dlgSaveWorkspace = new System.Windows.Forms.SaveFileDialog();
+            this.dlgSaveSymbolPack = new System.Windows.Forms.SaveFileDialog();
             this.mainMenuStrip.SuspendLayout();
             this.tsMain.SuspendLayout();
             this.statusStrip1.SuspendLayout();
@@ -138,6 +144,7 @@ namespace TSP.DoxygenEditor.Views
             this.scTreeAndFiles.SuspendLayout();
             this.tcBottom.SuspendLayout();
             this.tpPerformance.SuspendLayout();
+            this.tpPreview.SuspendLayout();
             this.cmsTabActions.SuspendLayout();
             this.SuspendLayout();
             // 
@@ -299,7 +306,8 @@ namespace TSP.DoxygenEditor.Views
             // miEditGoTo
             // 
             this.miEditGoTo.DropDownItems.AddRange(new System.Windows.Forms.ToolStripItem[] {
-            this.miEditGoToSymbol});
+            this.miEditGoToSymbol,
+            this.miEditGoToReferences});
             this.miEditGoTo.Name = "miEditGoTo";
             this.miEditGoTo.Size = new System.Drawing.Size(200, 26);
             this.miEditGoTo.Text = "Go To";
@@ -312,6 +320,14 @@ namespace TSP.DoxygenEditor.Views
             this.miEditGoToSymbol.Text = "Symbol...";
             this.miEditGoToSymbol.Click += new System.EventHandler(this.MenuActionEditGoToSymbol);
             // 
+            // miEditGoToReferences
+            // 
+            this.miEditGoToReferences.Name = "miEditGoToReferences";
+            this.miEditGoToReferences.ShortcutKeys = ((System.Windows.Forms.Keys)((System.Windows.Forms.Keys.Shift | System.Windows.Forms.Keys.F12)));
+            this.miEditGoToReferences.Size = new System.Drawing.Size(195, 26);
+            this.miEditGoToReferences.Text = "References";
+            this.miEditGoToReferences.Click += new System.EventHandler(this.MenuActionEditGoToReferences);
+            // 
             // miEditFindAndReplace
             // 
             this.miEditFindAndReplace.DropDownItems.AddRange(new System.Windows.Forms.ToolStripItem[] {
@@ -430,7 +446,8 @@ namespace TSP.DoxygenEditor.Views
             this.miWorkspace.DropDownItems.AddRange(new System.Windows.Forms.ToolStripItem[] {
             this.miWorkspaceNew,
             this.mitWorkspaceLoad,
-            this.miWorkspaceConfiguration});
+            this.miWorkspaceConfiguration,
+            this.miWorkspaceWriteSymbolPack});
             this.miWorkspace.Name = "miWorkspace";
             this.miWorkspace.Size = new System.Drawing.Size(93, 24);
             this.miWorkspace.Text = "Workspace";
@@ -456,6 +473,14 @@ namespace TSP.DoxygenEditor.Views
             this.miWorkspaceConfiguration.Text = "Configuration...";
             this.miWorkspaceConfiguration.Click += new System.EventHandler(this.miWorkspaceConfiguration_Click);
             // 
+            // miWorkspaceWriteSymbolPack
+            // 
+            this.miWorkspaceWriteSymbolPack.Enabled = false;
+            this.miWorkspaceWriteSymbolPack.Name = "miWorkspaceWriteSymbolPack";
+            this.miWorkspaceWriteSymbolPack.Size = new System.Drawing.Size(184, 26);
+            this.miWorkspaceWriteSymbolPack.Text = "Write Symbol Pack...";
+            this.miWorkspaceWriteSymbolPack.Click += new System.EventHandler(this.miWorkspaceWriteSymbolPack_Click);
+            // 
             // miBuild
             // 
             this.miBuild.DropDownItems.AddRange(new System.Windows.Forms.ToolStripItem[] {
@@ -697,6 +722,8 @@ namespace TSP.DoxygenEditor.Views
             this.tcBottom.Controls.Add(this.tpDoxygenIssues);
             this.tcBottom.Controls.Add(this.tpCppIssues);
             this.tcBottom.Controls.Add(this.tpPerformance);
+            this.tcBottom.Controls.Add(this.tpPreview);
+            this.tcBottom.Controls.Add(this.tpReferences);
             this.tcBottom.Dock = System.Windows.Forms.DockStyle.Fill;
             this.tcBottom.HotTrack = true;
             this.tcBottom.Location = new System.Drawing.Point(0, 0);
@@ -740,6 +767,43 @@ namespace TSP.DoxygenEditor.Views
             this.tpPerformance.Text = "Performance";
             this.tpPerformance.UseVisualStyleBackColor = true;
             // 
+            // tpPreview
+            // 
+            this.tpPreview.Controls.Add(this.wbPreview);
+            this.tpPreview.Location = new System.Drawing.Point(4, 25);
+            this.tpPreview.Margin = new System.Windows.Forms.Padding(4);
+            this.tpPreview.Name = "tpPreview";
+            this.tpPreview.Padding = new System.Windows.Forms.Padding(4);
+            this.tpPreview.Size = new System.Drawing.Size(973, 135);
+            this.tpPreview.TabIndex = 3;
+            this.tpPreview.Text = "Preview";
+            this.tpPreview.UseVisualStyleBackColor = true;
+            // 
+            // tpReferences
+            // 
+            this.tpReferences.Location = new System.Drawing.Point(4, 25);
+            this.tpReferences.Margin = new System.Windows.Forms.Padding(3, 2, 3, 2);
+            this.tpReferences.Name = "tpReferences";
+            this.tpReferences.Padding = new System.Windows.Forms.Padding(3, 2, 3, 2);
+            this.tpReferences.Size = new System.Drawing.Size(973, 135);
+            this.tpReferences.TabIndex = 4;
+            this.tpReferences.Text = "References";
+            this.tpReferences.UseVisualStyleBackColor = true;
+            // 
+            // wbPreview
+            // 
+            this.wbPreview.AllowWebBrowserDrop = false;
+            this.wbPreview.Dock = System.Windows.Forms.DockStyle.Fill;
+            this.wbPreview.IsWebBrowserContextMenuEnabled = false;
+            this.wbPreview.Location = new System.Drawing.Point(4, 4);
+            this.wbPreview.Margin = new System.Windows.Forms.Padding(0);
+            this.wbPreview.MinimumSize = new System.Drawing.Size(20, 20);
+            this.wbPreview.Name = "wbPreview";
+            this.wbPreview.ScriptErrorsSuppressed = true;
+            this.wbPreview.Size = new System.Drawing.Size(965, 127);
+            this.wbPreview.TabIndex = 0;
+            this.wbPreview.Navigating += new System.Windows.Forms.WebBrowserNavigatingEventHandler(this.wbPreview_Navigating);
+            // 
             // lvPerformance
             // 
             this.lvPerformance.Columns.AddRange(new System.Windows.Forms.ColumnHeader[] {
@@ -915,6 +979,12 @@ namespace TSP.DoxygenEditor.Views
             this.dlgSaveWorkspace.DefaultExt = "doxyedit";
             this.dlgSaveWorkspace.Filter = "Workspace files (*.doxyedit)|*.doxyedit";
             // 
+            // dlgSaveSymbolPack
+            // 
+            this.dlgSaveSymbolPack.DefaultExt = "dxsp";
+            this.dlgSaveSymbolPack.Filter = "Symbol packs (*.dxsp)|*.dxsp";
+            this.dlgSaveSymbolPack.Title = "Write symbol pack";
+            // 
             // MainForm
             // 
             this.AutoScaleDimensions = new System.Drawing.SizeF(8F, 16F);
@@ -949,6 +1019,7 @@ namespace TSP.DoxygenEditor.Views
             this.scTreeAndFiles.ResumeLayout(false);
             this.tcBottom.ResumeLayout(false);
             this.tpPerformance.ResumeLayout(false);
+            this.tpPreview.ResumeLayout(false);
             this.cmsTabActions.ResumeLayout(false);
             this.ResumeLayout(false);
             this.PerformLayout();
@@ -966,6 +1037,9 @@ namespace TSP.DoxygenEditor.Views
         private System.Windows.Forms.SplitContainer scTreeAndFiles;
         private System.Windows.Forms.TabControl tcBottom;
         private System.Windows.Forms.TabPage tpCppIssues;
+        private System.Windows.Forms.TabPage tpPreview;
+        private System.Windows.Forms.TabPage tpReferences;
+        private System.Windows.Forms.WebBrowser wbPreview;
         private System.Windows.Forms.TabControl tcFiles;
         private System.Windows.Forms.TreeView tvTree;
         private System.Windows.Forms.Panel panTreeTop;
@@ -1001,6 +1075,7 @@ namespace TSP.DoxygenEditor.Views
         private System.Windows.Forms.ToolStripMenuItem miViewShowWhitespaces;
         private System.Windows.Forms.ToolStripMenuItem miEditGoTo;
         private System.Windows.Forms.ToolStripMenuItem miEditGoToSymbol;
+        private System.Windows.Forms.ToolStripMenuItem miEditGoToReferences;
         private System.Windows.Forms.ToolStripButton tbtnFileNew;
         private System.Windows.Forms.ColumnHeader columnHeader2;
         private System.Windows.Forms.ColumnHeader columnHeader3;
@@ -1041,6 +1116,8 @@ namespace TSP.DoxygenEditor.Views
         private System.Windows.Forms.ToolStripMenuItem miWorkspace;
         private System.Windows.Forms.ToolStripMenuItem miWorkspaceConfiguration;
         private System.Windows.Forms.ToolStripMenuItem miWorkspaceNew;
+        private System.Windows.Forms.ToolStripMenuItem miWorkspaceWriteSymbolPack;
+        private System.Windows.Forms.SaveFileDialog dlgSaveSymbolPack;
         private System.Windows.Forms.ToolStripMenuItem mitWorkspaceLoad;
         private System.Windows.Forms.OpenFileDialog dlgOpenWorkspace;
         private System.Windows.Forms.SaveFileDialog dlgSaveWorkspace;
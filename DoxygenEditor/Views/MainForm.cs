@@ -1,5 +1,6 @@
 ﻿using TSP.DoxygenEditor.Editor;
 using TSP.DoxygenEditor.Extensions;
+using TSP.DoxygenEditor.Includes;
 using TSP.DoxygenEditor.Models;
 using TSP.DoxygenEditor.Natives;
 using TSP.DoxygenEditor.Parsers;
@@ -22,6 +23,7 @@ using TSP.DoxygenEditor.Symbols;
 using System.Collections;
 using TSP.DoxygenEditor.FilterControls;
 using System.Threading;
+using System.Threading.Tasks;
 using System.Text;
 
 namespace TSP.DoxygenEditor.Views
@@ -34,6 +36,18 @@ namespace TSP.DoxygenEditor.Views
         private readonly string _dataPath;
         private readonly string _defaultWorkspaceFilePath;
         private readonly object _performanceItemsSummaryRoot = new object();
+        private readonly List<ISymbolTableId> _symbolPackTableIds = new List<ISymbolTableId>();
+        private int _symbolPackLoadId = 0;
+        private readonly List<ISymbolTableId> _doxyfileTableIds = new List<ISymbolTableId>();
+        private SourceIncludesLoader _doxyfileLoader = null;
+        private IncludeFilesRefresher _doxyfileRefresher = null;
+        private string _doxyfileSignature = null;
+        private readonly DoxygenHtmlRenderer _previewRenderer = new DoxygenHtmlRenderer();
+        // Editors which are still loading their file, by file path. The file path of an editor is set after the file is loaded only.
+        private readonly Dictionary<string, IEditor> _loadingEditors = new Dictionary<string, IEditor>();
+        private readonly ParseStateManager _parseStateManager;
+        private DoxygenBlockNode _previewBlock = null;
+        private string _previewHtml = null;
 
         class PerformanceListViewItemComparer : IComparer
         {
@@ -54,6 +68,7 @@ namespace TSP.DoxygenEditor.Views
         private readonly FilterBarControl _cppIssuesFilterControl;
         private readonly FilterListView lvDoxygenIssues;
         private readonly FilterListView lvCppIssues;
+        private readonly FilterListView lvReferences;
 
         private void SetupIssueColumns(FilterListView listview)
         {
@@ -130,6 +145,7 @@ namespace TSP.DoxygenEditor.Views
             }
             _globalConfig.WorkspacePath = _workspace.FilePath;
             UpdatedWorkspaceFile();
+            _parseStateManager = new ParseStateManager(_workspace);
 
 
             // @STUPID(final): Visual studio designer is so stupid, it cannot recognize usercontrols properly
@@ -157,6 +173,12 @@ namespace TSP.DoxygenEditor.Views
                 lvCppIssues.FilterText = e;
             };
 
+            lvReferences = new FilterListView();
+            lvReferences.Dock = DockStyle.Fill;
+            lvReferences.ItemDoubleClick += Issues_ItemDoubleClick;
+            SetupIssueColumns(lvReferences);
+            tpReferences.Controls.Add(lvReferences);
+
             lvPerformance.ListViewItemSorter = new PerformanceListViewItemComparer();
 
             // Update UI from config settings
@@ -195,6 +217,169 @@ namespace TSP.DoxygenEditor.Views
                 distance = Math.Min(Math.Max(d, minDistance), scTreeAndFiles.ClientSize.Width - minDistance);
             }
             scTreeAndFiles.SplitterDistance = distance;
+
+            ResetDoxyfileIndex();
+            LoadSymbolPacks();
+        }
+
+        /// <summary>
+        /// Sources of a Doxyfile are indexed with the settings of the workspace, so they are dropped and indexed again on the next parse.
+        /// </summary>
+        private void ResetDoxyfileIndex()
+        {
+            StopDoxyfileIndexing();
+            foreach (ISymbolTableId id in _doxyfileTableIds)
+                GlobalSymbolCache.Remove(id);
+            _doxyfileTableIds.Clear();
+            _doxyfileSignature = null;
+        }
+
+        /// <summary>
+        /// Loads the symbol packs of the workspace in the background, the tables are published when all packs are read.
+        /// A newer load discards the results of an older one.
+        /// </summary>
+        private void LoadSymbolPacks()
+        {
+            foreach (ISymbolTableId id in _symbolPackTableIds)
+                GlobalSymbolCache.Remove(id);
+            _symbolPackTableIds.Clear();
+
+            int loadId = ++_symbolPackLoadId;
+            string workspaceDir = Path.GetDirectoryName(_workspace.FilePath);
+            List<string> packFilePaths = _workspace.ParserCpp.SymbolPackFiles
+                .Where(f => !string.IsNullOrWhiteSpace(f))
+                .Select(f => Path.IsPathRooted(f) ? f : Path.Combine(workspaceDir, f))
+                .ToList();
+            if (packFilePaths.Count == 0)
+                return;
+
+            SetParseStatus($"Loading {packFilePaths.Count} symbol packs");
+            Task.Run(() =>
+            {
+                List<SymbolTable> tables = new List<SymbolTable>();
+                List<KeyValuePair<string, Exception>> errors = new List<KeyValuePair<string, Exception>>();
+                foreach (string packFilePath in packFilePaths)
+                {
+                    try
+                    {
+                        using (SymbolPack pack = SymbolPack.Open(packFilePath))
+                            tables.AddRange(pack.ReadTables());
+                    }
+                    catch (Exception e)
+                    {
+                        errors.Add(new KeyValuePair<string, Exception>(packFilePath, e));
+                    }
+                }
+                return (Tuple.Create(tables, errors));
+            }).ContinueWith((task) =>
+            {
+                if (loadId != _symbolPackLoadId)
+                    return;
+                SetParseStatus("");
+                List<SymbolTable> tables = task.Result.Item1;
+                GlobalSymbolCache.AddOrReplaceTables(tables);
+                _symbolPackTableIds.AddRange(tables.Select(t => t.Id));
+                foreach (KeyValuePair<string, Exception> error in task.Result.Item2)
+                    ShowError("Symbol pack", $"Symbol pack '{Path.GetFileName(error.Key)}' could not be loaded", error.Value.Message);
+                if (tables.Count > 0)
+                {
+                    IssuesTimings timings = RefreshIssues(GetAllEditors());
+                    RefreshPerformanceSummary(timings);
+                }
+            }, TaskScheduler.FromCurrentSynchronizationContext());
+        }
+
+        /// <summary>
+        /// Indexes all sources the opened Doxyfile refers to, but only when its input settings have changed.
+        /// </summary>
+        private void BootstrapDoxyfile(IEditor editor, IBaseNode configTree)
+        {
+            if (configTree == null || string.IsNullOrWhiteSpace(editor.FilePath))
+                return;
+            // @NOTE(final): Called on every parse, so the patterns are only compiled when the input settings have changed
+            string baseDir = Path.GetDirectoryName(editor.FilePath);
+            string signature = DoxyfileBootstrap.GetSignature(configTree, baseDir);
+            if (signature.Equals(_doxyfileSignature))
+                return;
+            _doxyfileSignature = signature;
+            DoxyfileBootstrap bootstrap = new DoxyfileBootstrap(configTree, baseDir);
+
+            StopDoxyfileIndexing();
+
+            SetParseStatus($"Discovering files of '{Path.GetFileName(editor.FilePath)}'");
+            Task.Run(() => bootstrap.DiscoverFiles()).ContinueWith((task) =>
+            {
+                if (!signature.Equals(_doxyfileSignature))
+                    return;
+                if (task.IsFaulted)
+                {
+                    SetParseStatus("");
+                    ShowError("Doxyfile", $"Files of '{Path.GetFileName(editor.FilePath)}' could not be discovered", task.Exception.InnerException.Message);
+                    return;
+                }
+
+                IReadOnlyList<string> files = task.Result;
+                foreach (ISymbolTableId id in _doxyfileTableIds)
+                    GlobalSymbolCache.Remove(id);
+                _doxyfileTableIds.Clear();
+
+                string discoverStatus = $"Discovered {files.Count} files ({bootstrap.DiscoverStage.ItemsPerSecond:F0} files/sec)";
+                SetParseStatus(discoverStatus);
+
+                SourceIncludesLoader loader = new SourceIncludesLoader(files, bootstrap.IncludePaths);
+                loader.Defines = _workspace.ParserCpp.CreateDefines();
+                loader.ProgressChanged += (s, e) =>
+                {
+                    if (loader == _doxyfileLoader)
+                        SetParseStatus($"{discoverStatus}, indexing {e.ParsedFileCount} of {e.TotalFileCount}");
+                };
+                loader.TablesPublished += (s, tables) => _doxyfileTableIds.AddRange(tables.Select(t => t.Id));
+                loader.IsCompleted += (s, tables) =>
+                {
+                    if (loader != _doxyfileLoader)
+                        return;
+                    SetParseStatus("");
+
+                    // From now on, only the files which are changed on disk are parsed again
+                    IncludeFilesRefresher refresher = new IncludeFilesRefresher(loader.GetIncludeGraph().Files);
+                    refresher.Defines = loader.Defines;
+                    refresher.ValidationConfig = CreateValidationConfig();
+                    refresher.Refreshed += DoxyfileRefresher_Refreshed;
+                    _doxyfileRefresher = refresher;
+                    miWorkspaceWriteSymbolPack.Enabled = true;
+
+                    IssuesTimings timings = RefreshIssues(GetAllEditors());
+                    RefreshPerformanceSummary(timings);
+                };
+                _doxyfileLoader = loader;
+                loader.Start();
+            }, TaskScheduler.FromCurrentSynchronizationContext());
+        }
+
+        private void DoxyfileRefresher_Refreshed(object sender, IncludeFilesRefresher.RefreshedEventArgs e)
+        {
+            if (sender != _doxyfileRefresher)
+                return;
+
+            // The refresher already replaced the tables in the global cache, so the issues of all editors are collected again
+            int errorCount = e.Errors.Count();
+            SetParseStatus($"Refreshed {e.ChangedFiles.Count} include files, {e.RemovedFiles.Count} removed, {errorCount} missing symbols");
+            IssuesTimings timings = RefreshIssues(GetAllEditors());
+            RefreshPerformanceSummary(timings);
+        }
+
+        private void StopDoxyfileIndexing()
+        {
+            if (_doxyfileLoader != null && (_doxyfileLoader.IsRunning || _doxyfileLoader.IsPaused))
+                _doxyfileLoader.Stop();
+            _doxyfileLoader = null;
+            miWorkspaceWriteSymbolPack.Enabled = false;
+            if (_doxyfileRefresher != null)
+            {
+                _doxyfileRefresher.Refreshed -= DoxyfileRefresher_Refreshed;
+                _doxyfileRefresher.Dispose();
+                _doxyfileRefresher = null;
+            }
         }
 
         private void SetParseStatus(string status)
@@ -324,6 +509,7 @@ namespace TSP.DoxygenEditor.Views
             editor.FileType = fileType;
             editor.IsShowWhitespace = miViewShowWhitespaces.Checked;
             editor.TabUpdating += (s, e) => UpdateEditor((IEditor)s);
+            editor.CaretChanged += (s, e) => UpdatePreview((IEditor)s);
             editor.FocusChanged += (s, e) =>
             {
                 UpdateMenuEditChange(editor);
@@ -331,12 +517,16 @@ namespace TSP.DoxygenEditor.Views
             };
             editor.ParseCompleted += (IParseInfo parseInfo) =>
             {
-                RebuildSymbolTree(editor, parseInfo.DoxyBlockTree);
+                UpdateSymbolTree(editor, parseInfo.DoxyBlockTree);
                 AddPerformanceItemsFor(editor);
+                if (editor.FileType == EditorFileType.DoxyConfig)
+                    BootstrapDoxyfile(editor, parseInfo.DoxyConfigTree);
+                UpdatePreview(editor);
                 bool isComplete = Interlocked.Decrement(ref _parseProgressCount) == 0;
                 if (isComplete)
                 {
                     Interlocked.Exchange(ref _parseTotalCount, 0);
+                    _parseStateManager.Trim();
                     IEnumerable<IEditor> editors = GetAllEditors();
                     IssuesTimings timings = RefreshIssues(editors);
                     RefreshPerformanceSummary(timings);
@@ -366,16 +556,29 @@ namespace TSP.DoxygenEditor.Views
             newTab.Controls.Add(editor.ContainerPanel);
             tcFiles.TabPages.Add(newTab);
             AddToSymbolTree(editor, editor.Name);
+            _parseStateManager.Add(editor);
             return (editor);
         }
 
         private void RemoveFileTab(IEditor editor)
         {
             editor.Stop();
+            _parseStateManager.Remove(editor);
+            foreach (KeyValuePair<string, IEditor> loadingPair in _loadingEditors.Where(p => p.Value == editor).ToList())
+                _loadingEditors.Remove(loadingPair.Key);
             RemoveFromSymbolTree(editor);
             ClearPerformanceItemsFrom(editor);
             GlobalSymbolCache.Remove(editor);
 
+            // Found references may point into the closed editor
+            if (lvReferences.ItemCount > 0)
+            {
+                lvReferences.ClearSelection();
+                lvReferences.ClearItems();
+                lvReferences.RefreshItems();
+                tpReferences.Text = "References";
+            }
+
             TabPage tab = (TabPage)editor.Tab;
             tcFiles.TabPages.Remove(tab);
             editor.Dispose();
@@ -389,15 +592,18 @@ namespace TSP.DoxygenEditor.Views
         {
             Debug.Assert(!string.IsNullOrWhiteSpace(filePath));
 
-            // Is the file already open?
-            IEditor alreadyOpenEditor = null;
-            foreach (TabPage tab in tcFiles.TabPages)
+            // Is the file already open or still loading?
+            IEditor alreadyOpenEditor;
+            if (!_loadingEditors.TryGetValue(filePath, out alreadyOpenEditor))
             {
-                IEditor editor = (IEditor)tab.Tag;
-                if (string.Equals(editor.FilePath, filePath))
+                foreach (TabPage tab in tcFiles.TabPages)
                 {
-                    alreadyOpenEditor = editor;
-                    break;
+                    IEditor editor = (IEditor)tab.Tag;
+                    if (string.Equals(editor.FilePath, filePath))
+                    {
+                        alreadyOpenEditor = editor;
+                        break;
+                    }
                 }
             }
 
@@ -414,33 +620,40 @@ namespace TSP.DoxygenEditor.Views
                 IEditor newEditor = AddFileTab(Path.GetFileName(filePath), supportedFileType);
                 TabPage tab = (TabPage)newEditor.Tab;
                 tcFiles.SelectedIndex = tcFiles.TabPages.IndexOf(tab);
-                Tuple<bool, Exception> openRes = IOOpenFile(newEditor, filePath);
-                if (!openRes.Item1)
-                {
-                    Exception e = openRes.Item2;
-                    Dictionary<string, string> values = new Dictionary<string, string>() { { "filepath", filePath } };
-                    ErrorMessageModel msg = e.ToErrorMessage("Open file", values);
-                    ShowError(msg.Caption, msg.ShortText, msg.Details);
-                    RemoveFileTab(newEditor);
-                }
-                else
-                {
-                    _workspace.History.PushRecentFiles(filePath);
-                    RefreshRecentFiles();
 
-                    // Remove first tab when it was a "New" and is still unchanged
-                    if (tcFiles.TabPages.Count == 2)
+                // @NOTE(final): The tab is added right away, so the order of the tabs stays the same while several files are loaded at once.
+                // The file path is set when the file is loaded, so the empty editor can not be saved over the file. Until then opening the same file again focuses this tab through the loading editors.
+                _loadingEditors.Add(filePath, newEditor);
+                IOOpenFileAsync(newEditor, filePath, (openRes) =>
+                {
+                    _loadingEditors.Remove(filePath);
+                    if (!openRes.Item1)
                     {
-                        TabPage firstTab = tcFiles.TabPages[0];
-                        IEditor existingEditor = (IEditor)firstTab.Tag;
-                        if (existingEditor.FilePath == null && !existingEditor.IsChanged)
-                            RemoveFileTab(existingEditor);
+                        Exception e = openRes.Item2;
+                        Dictionary<string, string> values = new Dictionary<string, string>() { { "filepath", filePath } };
+                        ErrorMessageModel msg = e.ToErrorMessage("Open file", values);
+                        ShowError(msg.Caption, msg.ShortText, msg.Details);
+                        RemoveFileTab(newEditor);
                     }
+                    else
+                    {
+                        _workspace.History.PushRecentFiles(filePath);
+                        RefreshRecentFiles();
 
-                    // Focus new tab
-                    tcFiles.SelectedTab = tab;
-                    newEditor.SetFocus();
-                }
+                        // Remove first tab when it was a "New" and is still unchanged
+                        if (tcFiles.TabPages.Count == 2)
+                        {
+                            TabPage firstTab = tcFiles.TabPages[0];
+                            IEditor existingEditor = (IEditor)firstTab.Tag;
+                            if (existingEditor.FilePath == null && !existingEditor.IsChanged && !_loadingEditors.ContainsValue(existingEditor))
+                                RemoveFileTab(existingEditor);
+                        }
+
+                        // Focus new tab, when no other tab was selected while loading
+                        if (tcFiles.SelectedTab == tab)
+                            newEditor.SetFocus();
+                    }
+                });
             }
         }
 
@@ -483,32 +696,89 @@ namespace TSP.DoxygenEditor.Views
             {
                 TabPage selectedTab = tcFiles.TabPages[tcFiles.SelectedIndex];
                 IEditor editor = (IEditor)selectedTab.Tag;
+                _parseStateManager.Activate(editor);
                 UpdateEditor(editor);
+                UpdatePreview(editor);
+            }
+        }
+        #endregion
+
+        #region Preview
+        private void UpdatePreview(IEditor editor)
+        {
+            // Only the block under the caret of the selected editor is rendered
+            if (editor == null || tcFiles.SelectedTab != editor.Tab)
+                return;
+            IParseInfo parseInfo = editor.ParseInfo;
+            DoxygenBlockNode blockNode = null;
+            if (parseInfo != null && editor.FileType != EditorFileType.DoxyConfig)
+                blockNode = DoxygenHtmlRenderer.FindBlockAt(parseInfo.DoxyBlockTree, editor.CaretPosition);
+            if (blockNode != null && blockNode == _previewBlock)
+                return;
+            _previewBlock = blockNode;
+            string html = _previewRenderer.RenderPage(blockNode);
+            if (!string.Equals(html, _previewHtml))
+            {
+                _previewHtml = html;
+                wbPreview.DocumentText = html;
+            }
+        }
+
+        private void wbPreview_Navigating(object sender, WebBrowserNavigatingEventArgs e)
+        {
+            string url = e.Url.OriginalString;
+            if (!url.StartsWith(DoxygenHtmlRenderer.LinkScheme, StringComparison.Ordinal))
+                return;
+            e.Cancel = true;
+            string name = Uri.UnescapeDataString(url.Substring(DoxygenHtmlRenderer.LinkScheme.Length));
+            Tuple<SourceSymbol, ISymbolTableId> found = GlobalSymbolCache.FindSource(name);
+            if (found == null)
+                return;
+            IEditor foundEditor = FindEditorById(found.Item2);
+            if (foundEditor != null)
+            {
+                TabPage tab = (TabPage)foundEditor.Tab;
+                tcFiles.SelectedIndex = tcFiles.TabPages.IndexOf(tab);
+                foundEditor.GoToPosition(found.Item1.Range.Index);
             }
         }
         #endregion
 
         #region IO
-        private Tuple<bool, Exception> IOOpenFile(IEditor editor, string filePath)
+        private static async Task<Tuple<string, Encoding>> IOReadFileAsync(string filePath)
         {
-            try
+            const int bufferSize = 64 * 1024;
+            using (FileStream stream = new FileStream(filePath, FileMode.Open, FileAccess.Read, FileShare.Read, bufferSize, FileOptions.Asynchronous | FileOptions.SequentialScan))
             {
-                using (StreamReader reader = new StreamReader(filePath))
+                using (StreamReader reader = new StreamReader(stream, Encoding.UTF8, true, bufferSize))
                 {
-                    string contents = reader.ReadToEnd();
-                    editor.FileEncoding = reader.CurrentEncoding;
-                    editor.SetText(contents);
+                    string contents = await reader.ReadToEndAsync();
+                    return new Tuple<string, Encoding>(contents, reader.CurrentEncoding);
                 }
             }
-            catch (IOException e)
+        }
+
+        private void IOOpenFileAsync(IEditor editor, string filePath, Action<Tuple<bool, Exception>> completed)
+        {
+            // Reading and decoding runs in the background, only the text is handed over to the editor on the UI thread
+            Task.Run(() => IOReadFileAsync(filePath)).ContinueWith((task) =>
             {
-                return new Tuple<bool, Exception>(false, e);
-            }
-            editor.Name = Path.GetFileName(filePath);
-            editor.FilePath = filePath;
-            editor.IsChanged = false;
-            UpdateEditor(editor);
-            return new Tuple<bool, Exception>(true, null);
+                TabPage tab = (TabPage)editor.Tab;
+                if (!tcFiles.TabPages.Contains(tab))
+                    return; // Tab was closed while loading
+                if (task.IsFaulted)
+                {
+                    completed(new Tuple<bool, Exception>(false, task.Exception.InnerException));
+                    return;
+                }
+                editor.FileEncoding = task.Result.Item2;
+                editor.SetText(task.Result.Item1);
+                editor.Name = Path.GetFileName(filePath);
+                editor.FilePath = filePath;
+                editor.IsChanged = false;
+                UpdateEditor(editor);
+                completed(new Tuple<bool, Exception>(true, null));
+            }, TaskScheduler.FromCurrentSynchronizationContext());
         }
 
         private Tuple<bool, Exception> IOSaveFile(IEditor editor)
@@ -551,7 +821,7 @@ namespace TSP.DoxygenEditor.Views
 
         private void MainForm_FormClosed(object sender, FormClosedEventArgs e)
         {
-
+            StopDoxyfileIndexing();
         }
 
         private void MainForm_Load(object sender, EventArgs e)
@@ -664,64 +934,102 @@ namespace TSP.DoxygenEditor.Views
             DoxygenBlockEntityKind.SubSubSection,
         };
 
-        private List<TreeNode> BuildSymbolTree(IBaseNode rootEntityNode, TreeNode rootTreeNode, IBaseNode selectedEntityNode)
+        private static void CollectSymbolNodes(IBaseNode rootEntityNode, List<DoxygenBlockNode> result)
         {
-            List<TreeNode> result = new List<TreeNode>();
             foreach (IBaseNode childEntityNode in rootEntityNode.Children)
             {
                 if (typeof(DoxygenBlockNode).Equals(childEntityNode.GetType()))
                 {
                     DoxygenBlockNode doxyNode = (DoxygenBlockNode)childEntityNode;
-                    DoxygenBlockEntity entity = doxyNode.Entity;
-                    if (!AllowedDoxyEntities.Contains(entity.Kind))
+                    if (!AllowedDoxyEntities.Contains(doxyNode.Entity.Kind))
                         continue;
 
-                    TreeNode parentNode;
-                    if (childEntityNode.ShowChildren)
+                    // Nodes which do not show their children are not shown at all, their children are placed in the parent instead
+                    if (doxyNode.ShowChildren)
+                        result.Add(doxyNode);
+                    else
+                        CollectSymbolNodes(doxyNode, result);
+                }
+            }
+        }
+
+        private void UpdateSymbolNodes(TreeNode parentTreeNode, IBaseNode parentEntityNode)
+        {
+            List<DoxygenBlockNode> entityNodes = new List<DoxygenBlockNode>();
+            if (parentEntityNode != null)
+                CollectSymbolNodes(parentEntityNode, entityNodes);
+
+            // @NOTE(final): A tree node is identified by the kind and symbol name of its entity, so inserting or removing a sibling does not change it.
+            // Unnamed nodes (blocks, groups without a name) use the command name and the ordinal among the siblings with the same kind and command instead.
+            // Unchanged nodes are kept as they are, so the expansion state and the selection stays the same.
+            string[] keys = new string[entityNodes.Count];
+            Dictionary<string, int> ordinals = new Dictionary<string, int>();
+            for (int i = 0; i < entityNodes.Count; ++i)
+            {
+                DoxygenBlockEntity entity = entityNodes[i].Entity;
+                string symbolName = entity.GetParameterValue("name", "id");
+                bool isNamed = !string.IsNullOrWhiteSpace(symbolName);
+                string key = isNamed ? $"{entity.Kind}:{symbolName}" : $"{entity.Kind}:{entity.Id}";
+                int ordinal;
+                ordinals.TryGetValue(key, out ordinal);
+                ordinals[key] = ordinal + 1;
+                // A duplicated name gets an ordinal as well, so every key is unique
+                keys[i] = isNamed && ordinal == 0 ? key : $"{key}#{ordinal}";
+            }
+
+            // Remove the nodes which are gone
+            HashSet<string> newKeys = new HashSet<string>(keys);
+            Dictionary<string, TreeNode> existingNodes = new Dictionary<string, TreeNode>();
+            for (int i = parentTreeNode.Nodes.Count - 1; i >= 0; --i)
+            {
+                TreeNode treeNode = parentTreeNode.Nodes[i];
+                if (newKeys.Contains(treeNode.Name))
+                    existingNodes[treeNode.Name] = treeNode;
+                else
+                    parentTreeNode.Nodes.RemoveAt(i);
+            }
+
+            // Add the new nodes and rename or move the existing ones, all nodes before the current index are already in place
+            for (int i = 0; i < entityNodes.Count; ++i)
+            {
+                DoxygenBlockNode entityNode = entityNodes[i];
+                string text = entityNode.Entity.DisplayName;
+                TreeNode treeNode;
+                if (existingNodes.TryGetValue(keys[i], out treeNode))
+                {
+                    if (!string.Equals(treeNode.Text, text))
+                        treeNode.Text = text;
+                    if (treeNode.Index != i)
                     {
-                        parentNode = new TreeNode(entity.DisplayName);
-                        parentNode.Tag = childEntityNode;
-                        rootTreeNode.Nodes.Add(parentNode);
-                        if (selectedEntityNode != null)
-                        {
-                            if (selectedEntityNode.CompareTo(childEntityNode) == 0)
-                                result.Add(parentNode);
-                        }
+                        treeNode.Remove();
+                        parentTreeNode.Nodes.Insert(i, treeNode);
                     }
-                    else
-                        parentNode = rootTreeNode;
-                    result.AddRange(BuildSymbolTree(childEntityNode, parentNode, selectedEntityNode));
                 }
+                else
+                {
+                    treeNode = new TreeNode(text) { Name = keys[i] };
+                    parentTreeNode.Nodes.Insert(i, treeNode);
+                }
+                treeNode.Tag = entityNode;
+                UpdateSymbolNodes(treeNode, entityNode);
             }
-            return (result);
         }
 
-        private void RebuildSymbolTree(object fileTag, IBaseNode doxyTree)
+        private void UpdateSymbolTree(object fileTag, IBaseNode doxyTree)
         {
-            DoxygenBlockNode lastEntity = null;
-            if (tvTree.SelectedNode != null)
-                lastEntity = tvTree.SelectedNode.Tag as DoxygenBlockNode;
-
-            TreeNode newSelectedNode = null;
+            TreeNode selectedNode = tvTree.SelectedNode;
 
             // Find file node from tag
             TreeNode fileNode = FindRootSymbolNode(fileTag);
             Debug.Assert(fileNode != null);
 
             tvTree.BeginUpdate();
-            fileNode.Nodes.Clear();
-
-            if (doxyTree != null)
-            {
-                List<TreeNode> selNodes = BuildSymbolTree(doxyTree, fileNode, lastEntity);
-                if (selNodes.Count == 1)
-                    newSelectedNode = selNodes.First();
-            }
+            UpdateSymbolNodes(fileNode, doxyTree);
             tvTree.EndUpdate();
 
-            tvTree.SelectedNode = newSelectedNode;
-            if (newSelectedNode != null)
-                newSelectedNode.Expand();
+            // Clear the selection when the selected node was removed
+            if (selectedNode != null && selectedNode.TreeView == null)
+                tvTree.SelectedNode = null;
         }
         #endregion
 
@@ -785,7 +1093,17 @@ namespace TSP.DoxygenEditor.Views
                 if (dlgResult != DialogResult.Yes)
                     return;
             }
-            IOOpenFile(editor, editor.FilePath);
+            string filePath = editor.FilePath;
+            IOOpenFileAsync(editor, filePath, (openRes) =>
+            {
+                if (!openRes.Item1)
+                {
+                    Exception e = openRes.Item2;
+                    Dictionary<string, string> values = new Dictionary<string, string>() { { "filepath", filePath } };
+                    ErrorMessageModel msg = e.ToErrorMessage("Refresh file", values);
+                    ShowError(msg.Caption, msg.ShortText, msg.Details);
+                }
+            });
         }
         private void MenuActionFileNew(object sender, EventArgs e)
         {
@@ -942,23 +1260,10 @@ namespace TSP.DoxygenEditor.Views
             Debug.Assert(tcFiles.SelectedTab != null);
             IEditor editor = (IEditor)tcFiles.SelectedTab.Tag;
 
-            // @SPEED(final): Cache conversion to SymbolItemModel and types as well
-            List<SymbolItemModel> symbols = new List<SymbolItemModel>();
-            HashSet<string> types = new HashSet<string>();
-            IEnumerable<SourceSymbol> allSources = GlobalSymbolCache.GetSources(editor);
-            foreach (SourceSymbol source in allSources)
-            {
-                if (source.Node == null) continue;
-                symbols.Add(new SymbolItemModel()
-                {
-                    Caption = source.Caption,
-                    Id = source.Name,
-                    Type = source.Kind.ToString(),
-                    Position = source.Range.Position,
-                });
-                types.Add(source.Kind.ToString());
-            }
-            SymbolSearchForm form = new SymbolSearchForm(symbols, types);
+            // Only the symbols of the current editor are searched, using the kinds that actually exist in it
+            Func<SymbolSearchEntry, bool> scopeFilter = (entry) => entry.Symbol.Node != null;
+            List<SourceSymbolKind> types = GlobalSymbolCache.SearchIndex.GetKinds(editor);
+            SymbolSearchForm form = new SymbolSearchForm(GlobalSymbolCache.SearchIndex, editor, scopeFilter, types);
             if (form.ShowDialog(this) == DialogResult.OK)
             {
                 SymbolItemModel selectedItem = form.SelectedItem;
@@ -966,6 +1271,33 @@ namespace TSP.DoxygenEditor.Views
             }
         }
 
+        private void MenuActionEditGoToReferences(object sender, EventArgs e)
+        {
+            Debug.Assert(tcFiles.SelectedTab != null);
+            IEditor editor = (IEditor)tcFiles.SelectedTab.Tag;
+            string symbolName = editor.GetSymbolName(editor.CaretPosition);
+            if (string.IsNullOrWhiteSpace(symbolName))
+                return;
+
+            // @NOTE(final): References are streamed per table, only tables of open editors can be jumped to
+            lvReferences.BeginUpdate();
+            lvReferences.ClearSelection();
+            lvReferences.ClearItems();
+            foreach (KeyValuePair<ISymbolTableId, IReadOnlyList<ReferenceSymbol>> tablePair in GlobalSymbolCache.FindReferences(symbolName, (id) => id is IEditor))
+            {
+                IEditor referenceEditor = (IEditor)tablePair.Key;
+                foreach (ReferenceSymbol reference in tablePair.Value)
+                {
+                    TextPosition pos = reference.Range.Position;
+                    AddIssue(lvReferences, new IssueTag(referenceEditor, pos, IssueType.Info), reference.Name, reference.Name, reference.Kind.ToString(), reference.Lang.ToString(), pos.Line + 1, referenceEditor.Name);
+                }
+            }
+            lvReferences.RefreshItems();
+            lvReferences.EndUpdate();
+            tpReferences.Text = $"References [{lvReferences.ItemCount}]";
+            tcBottom.SelectedTab = tpReferences;
+        }
+
         private void MenuActionViewShowWhitespaces(object sender, EventArgs e)
         {
             ToolStripMenuItem item = (ToolStripMenuItem)sender;
@@ -1088,6 +1420,16 @@ namespace TSP.DoxygenEditor.Views
             public TimeSpan TotalDuration { get; set; }
         }
 
+        private GlobalSymbolCache.ValidationConfigration CreateValidationConfig()
+        {
+            GlobalSymbolCache.ValidationConfigration result = new GlobalSymbolCache.ValidationConfigration()
+            {
+                ExcludeCppPreprocessorMatch = _workspace.ValidationCpp.ExcludePreprocessorMatch,
+                ExcludeCppPreprocessorUsage = _workspace.ValidationCpp.ExcludePreprocessorUsage,
+            };
+            return (result);
+        }
+
         private IssuesTimings RefreshIssues(IEnumerable<IEditor> editors)
         {
             Stopwatch total = Stopwatch.StartNew();
@@ -1096,11 +1438,7 @@ namespace TSP.DoxygenEditor.Views
 
             // Validate symbols from cache
             w.Restart();
-            GlobalSymbolCache.ValidationConfigration validationConfig = new GlobalSymbolCache.ValidationConfigration()
-            {
-                ExcludeCppPreprocessorMatch = _workspace.ValidationCpp.ExcludePreprocessorMatch,
-                ExcludeCppPreprocessorUsage = _workspace.ValidationCpp.ExcludePreprocessorUsage,
-            };
+            GlobalSymbolCache.ValidationConfigration validationConfig = CreateValidationConfig();
             IEnumerable<KeyValuePair<ISymbolTableId, TextError>> symbolErrors = GlobalSymbolCache.Validate(validationConfig);
             result.ValidationDuration = w.StopAndReturn();
 
@@ -1129,8 +1467,11 @@ namespace TSP.DoxygenEditor.Views
             w.Restart();
             foreach (KeyValuePair<ISymbolTableId, TextError> errorPair in symbolErrors)
             {
+                // Include files, symbol packs and indexed Doxyfile sources have no editor to show issues in
+                IEditor editor = errorPair.Key as IEditor;
+                if (editor == null)
+                    continue;
                 TextError error = errorPair.Value;
-                IEditor editor = (IEditor)errorPair.Key;
                 ReferenceSymbol symbol = (ReferenceSymbol)error.Tag;
                 Type nodeType = symbol.Node.GetType();
                 if (typeof(CppNode).Equals(nodeType))
@@ -1144,7 +1485,9 @@ namespace TSP.DoxygenEditor.Views
                 IParseInfo parseInfo = editor.ParseInfo;
                 foreach (TextError error in parseInfo.Errors)
                 {
-                    Type errorType = error.Tag.GetType();
+                    if (error.Tag == null)
+                        continue;
+                    Type errorType = error.Tag as Type ?? error.Tag.GetType();
                     if (typeof(CppLexer).Equals(errorType) || typeof(CppParser).Equals(errorType))
                         AddIssue(lvCppIssues, new IssueTag(editor, error.Pos, IssueType.Error), error.Message, null, null, error.Category, error.Pos.Line + 1, editor.Name);
                     else if (typeof(DoxygenBlockLexer).Equals(errorType) || typeof(DoxygenConfigLexer).Equals(errorType) || typeof(DoxygenBlockParser).Equals(errorType))
@@ -1273,6 +1616,7 @@ namespace TSP.DoxygenEditor.Views
             AddPerformanceItem(new PerformanceItemModel(_performanceItemsSummaryRoot, "Summary", -1, "", $"", "Issues (Collect)", timings.CollectDuration), newGroup);
             AddPerformanceItem(new PerformanceItemModel(_performanceItemsSummaryRoot, "Summary", -1, "", $"", "Issues (Refresh)", timings.RefreshDuration), newGroup);
             AddPerformanceItem(new PerformanceItemModel(_performanceItemsSummaryRoot, "Summary", -1, "", $"", "Issues (Select)", timings.SelectDuration), newGroup);
+            AddPerformanceItem(new PerformanceItemModel(_performanceItemsSummaryRoot, "Summary", -1, $"{_workspace.Memory.ParseStateBudget} MB budget", $"{_parseStateManager.RetainedSize / (1024 * 1024)} MB used, {_parseStateManager.ReleasedCount} files released", "Parse state memory", new TimeSpan()), newGroup);
             lvPerformance.EndUpdate();
         }
         #endregion
@@ -1284,6 +1628,8 @@ namespace TSP.DoxygenEditor.Views
             if (r == DialogResult.OK)
             {
                 _workspace.Assign(dlg.Workspace);
+                ResetDoxyfileIndex();
+                LoadSymbolPacks();
                 IEnumerable<IEditor> editors = GetAllEditors();
                 foreach (IEditor editor in editors)
                 {
@@ -1292,6 +1638,30 @@ namespace TSP.DoxygenEditor.Views
             }
         }
 
+        private void miWorkspaceWriteSymbolPack_Click(object sender, EventArgs e)
+        {
+            // The refresher replaces the tables of changed files in the global cache, so the pack is written from there
+            List<SymbolTable> tables = _doxyfileTableIds
+                .Select(id => GlobalSymbolCache.GetTable(id))
+                .Where(t => t != null)
+                .ToList();
+            if (tables.Count == 0)
+                return;
+            dlgSaveSymbolPack.FileName = null;
+            if (dlgSaveSymbolPack.ShowDialog(this) != DialogResult.OK)
+                return;
+            string packFilePath = dlgSaveSymbolPack.FileName;
+            SetParseStatus($"Writing symbol pack '{Path.GetFileName(packFilePath)}'");
+            Task.Run(() => SymbolPack.Write(packFilePath, tables)).ContinueWith((task) =>
+            {
+                SetParseStatus("");
+                if (task.IsFaulted)
+                    ShowError("Symbol pack", $"Symbol pack '{Path.GetFileName(packFilePath)}' could not be written", task.Exception.InnerException.Message);
+                else
+                    SetParseStatus($"Written {tables.Count} tables to symbol pack '{Path.GetFileName(packFilePath)}'");
+            }, TaskScheduler.FromCurrentSynchronizationContext());
+        }
+
         private void miWorkspaceNew_Click(object sender, EventArgs e)
         {
             dlgSaveWorkspace.FileName = null;
@@ -29,15 +29,18 @@
         private void InitializeComponent()
         {
             System.Windows.Forms.TreeNode treeNode1 = new System.Windows.Forms.TreeNode("C/C++");
-            System.Windows.Forms.TreeNode treeNode2 = new System.Windows.Forms.TreeNode("Parser", new System.Windows.Forms.TreeNode[] {
-            treeNode1});
-            System.Windows.Forms.TreeNode treeNode3 = new System.Windows.Forms.TreeNode("C/C++");
-            System.Windows.Forms.TreeNode treeNode4 = new System.Windows.Forms.TreeNode("Validation", new System.Windows.Forms.TreeNode[] {
-            treeNode3});
-            System.Windows.Forms.TreeNode treeNode5 = new System.Windows.Forms.TreeNode("Syntax-Highlighting");
-            System.Windows.Forms.TreeNode treeNode6 = new System.Windows.Forms.TreeNode("Editor", new System.Windows.Forms.TreeNode[] {
-            treeNode5});
-            System.Windows.Forms.TreeNode treeNode7 = new System.Windows.Forms.TreeNode("Build");
+            System.Windows.Forms.TreeNode treeNode2 = new System.Windows.Forms.TreeNode("Symbol Packs");
+            System.Windows.Forms.TreeNode treeNode3 = new System.Windows.Forms.TreeNode("Parser", new System.Windows.Forms.TreeNode[] {
+            treeNode1,
+            treeNode2});
+            System.Windows.Forms.TreeNode treeNode4 = new System.Windows.Forms.TreeNode("C/C++");
+            System.Windows.Forms.TreeNode treeNode5 = new System.Windows.Forms.TreeNode("Validation", new System.Windows.Forms.TreeNode[] {
+            treeNode4});
+            System.Windows.Forms.TreeNode treeNode6 = new System.Windows.Forms.TreeNode("Syntax-Highlighting");
+            System.Windows.Forms.TreeNode treeNode7 = new System.Windows.Forms.TreeNode("Editor", new System.Windows.Forms.TreeNode[] {
+            treeNode6});
+            System.Windows.Forms.TreeNode treeNode8 = new System.Windows.Forms.TreeNode("Build");
+            System.Windows.Forms.TreeNode treeNode9 = new System.Windows.Forms.TreeNode("Memory");
             this.panControls = new System.Windows.Forms.Panel();
             this.btnOk = new System.Windows.Forms.Button();
             this.btnCancel = new System.Windows.Forms.Button();
@@ -53,6 +56,15 @@
             this.cbParserCppExcludeFunctionCallSymbols = new System.Windows.Forms.CheckBox();
             this.gbParserCppExcludedNodes = new System.Windows.Forms.GroupBox();
             this.cbParserCppSkipFunctionBodies = new System.Windows.Forms.CheckBox();
+            this.gbParserCppPreprocessor = new System.Windows.Forms.GroupBox();
+            this.tbParserCppPreprocessorDefines = new System.Windows.Forms.TextBox();
+            this.lblParserCppPreprocessorDefines = new System.Windows.Forms.Label();
+            this.cbParserCppEvaluatePreprocessorConditions = new System.Windows.Forms.CheckBox();
+            this.tpParserSymbolPacks = new System.Windows.Forms.TabPage();
+            this.gbParserSymbolPacks = new System.Windows.Forms.GroupBox();
+            this.btnAddParserSymbolPack = new System.Windows.Forms.Button();
+            this.tbParserSymbolPackFiles = new System.Windows.Forms.TextBox();
+            this.lblParserSymbolPackFiles = new System.Windows.Forms.Label();
             this.tpValidationCpp = new System.Windows.Forms.TabPage();
             this.gbValidationCppDocumentation = new System.Windows.Forms.GroupBox();
             this.cbValidationCppRequireDoxygenReference = new System.Windows.Forms.CheckBox();
@@ -61,6 +73,11 @@
             this.cbValidationCppExcludePreprocessorMatch = new System.Windows.Forms.CheckBox();
             this.tpEditorSyntaxHighlighting = new System.Windows.Forms.TabPage();
             this.tpBuildOptions = new System.Windows.Forms.TabPage();
+            this.tpMemory = new System.Windows.Forms.TabPage();
+            this.gbMemoryParseState = new System.Windows.Forms.GroupBox();
+            this.lblMemoryParseStateBudgetHint = new System.Windows.Forms.Label();
+            this.nudMemoryParseStateBudget = new System.Windows.Forms.NumericUpDown();
+            this.lblMemoryParseStateBudget = new System.Windows.Forms.Label();
             this.groupBox1 = new System.Windows.Forms.GroupBox();
             this.btnSelectBuildDoxygenConfigPath = new System.Windows.Forms.Button();
             this.btnSelectBuildSourcePath = new System.Windows.Forms.Button();
@@ -81,10 +98,16 @@
             this.tpParserCpp.SuspendLayout();
             this.gbParserCppExcludedSymbols.SuspendLayout();
             this.gbParserCppExcludedNodes.SuspendLayout();
+            this.gbParserCppPreprocessor.SuspendLayout();
+            this.tpParserSymbolPacks.SuspendLayout();
+            this.gbParserSymbolPacks.SuspendLayout();
             this.tpValidationCpp.SuspendLayout();
             this.gbValidationCppDocumentation.SuspendLayout();
             this.gbValidationCppExcludedTypes.SuspendLayout();
             this.tpBuildOptions.SuspendLayout();
+            this.tpMemory.SuspendLayout();
+            this.gbMemoryParseState.SuspendLayout();
+            ((System.ComponentModel.ISupportInitialize)(this.nudMemoryParseStateBudget)).BeginInit();
             this.groupBox1.SuspendLayout();
             this.panOptionsTitleTop.SuspendLayout();
             this.SuspendLayout();
@@ -147,24 +170,29 @@
             treeNode1.Name = "nodeParserCpp";
             treeNode1.Tag = "";
             treeNode1.Text = "C/C++";
-            treeNode2.Name = "nodeParser";
-            treeNode2.Tag = "";
-            treeNode2.Text = "Parser";
-            treeNode3.Name = "nodeValidationCpp";
-            treeNode3.Text = "C/C++";
-            treeNode4.Name = "nodeValidation";
-            treeNode4.Text = "Validation";
-            treeNode5.Name = "nodeEditorSyntaxHighlighting";
-            treeNode5.Text = "Syntax-Highlighting";
-            treeNode6.Name = "nodeEditor";
-            treeNode6.Text = "Editor";
-            treeNode7.Name = "nodeBuild";
-            treeNode7.Text = "Build";
+            treeNode2.Name = "nodeParserSymbolPacks";
+            treeNode2.Text = "Symbol Packs";
+            treeNode3.Name = "nodeParser";
+            treeNode3.Tag = "";
+            treeNode3.Text = "Parser";
+            treeNode4.Name = "nodeValidationCpp";
+            treeNode4.Text = "C/C++";
+            treeNode5.Name = "nodeValidation";
+            treeNode5.Text = "Validation";
+            treeNode6.Name = "nodeEditorSyntaxHighlighting";
+            treeNode6.Text = "Syntax-Highlighting";
+            treeNode7.Name = "nodeEditor";
+            treeNode7.Text = "Editor";
+            treeNode8.Name = "nodeBuild";
+            treeNode8.Text = "Build";
+            treeNode9.Name = "nodeMemory";
+            treeNode9.Text = "Memory";
             this.tvOptions.Nodes.AddRange(new System.Windows.Forms.TreeNode[] {
-            treeNode2,
-            treeNode4,
-            treeNode6,
-            treeNode7});
+            treeNode3,
+            treeNode5,
+            treeNode7,
+            treeNode8,
+            treeNode9});
             this.tvOptions.Size = new System.Drawing.Size(170, 355);
             this.tvOptions.TabIndex = 1;
             this.tvOptions.AfterSelect += new System.Windows.Forms.TreeViewEventHandler(this.tvOptions_AfterSelect);
@@ -199,9 +227,11 @@
             // tcMain
             // 
             this.tcMain.Controls.Add(this.tpParserCpp);
+            this.tcMain.Controls.Add(this.tpParserSymbolPacks);
             this.tcMain.Controls.Add(this.tpValidationCpp);
             this.tcMain.Controls.Add(this.tpEditorSyntaxHighlighting);
             this.tcMain.Controls.Add(this.tpBuildOptions);
+            this.tcMain.Controls.Add(this.tpMemory);
             this.tcMain.Dock = System.Windows.Forms.DockStyle.Fill;
             this.tcMain.ItemSize = new System.Drawing.Size(91, 25);
             this.tcMain.Location = new System.Drawing.Point(0, 24);
@@ -215,6 +245,7 @@
             // 
             // tpParserCpp
             // 
+            this.tpParserCpp.Controls.Add(this.gbParserCppPreprocessor);
             this.tpParserCpp.Controls.Add(this.gbParserCppExcludedSymbols);
             this.tpParserCpp.Controls.Add(this.gbParserCppExcludedNodes);
             this.tpParserCpp.Location = new System.Drawing.Point(4, 29);
@@ -287,6 +318,114 @@
             this.cbParserCppSkipFunctionBodies.Text = "Function Bodies";
             this.cbParserCppSkipFunctionBodies.UseVisualStyleBackColor = true;
             // 
+            // gbParserCppPreprocessor
+            // 
+            this.gbParserCppPreprocessor.AutoSize = true;
+            this.gbParserCppPreprocessor.Controls.Add(this.tbParserCppPreprocessorDefines);
+            this.gbParserCppPreprocessor.Controls.Add(this.lblParserCppPreprocessorDefines);
+            this.gbParserCppPreprocessor.Controls.Add(this.cbParserCppEvaluatePreprocessorConditions);
+            this.gbParserCppPreprocessor.Dock = System.Windows.Forms.DockStyle.Top;
+            this.gbParserCppPreprocessor.Location = new System.Drawing.Point(0, 129);
+            this.gbParserCppPreprocessor.Margin = new System.Windows.Forms.Padding(0);
+            this.gbParserCppPreprocessor.Name = "gbParserCppPreprocessor";
+            this.gbParserCppPreprocessor.Padding = new System.Windows.Forms.Padding(5, 6, 5, 6);
+            this.gbParserCppPreprocessor.Size = new System.Drawing.Size(446, 152);
+            this.gbParserCppPreprocessor.TabIndex = 2;
+            this.gbParserCppPreprocessor.TabStop = false;
+            this.gbParserCppPreprocessor.Text = "Preprocessor";
+            // 
+            // tbParserCppPreprocessorDefines
+            // 
+            this.tbParserCppPreprocessorDefines.AcceptsReturn = true;
+            this.tbParserCppPreprocessorDefines.Dock = System.Windows.Forms.DockStyle.Top;
+            this.tbParserCppPreprocessorDefines.Location = new System.Drawing.Point(5, 66);
+            this.tbParserCppPreprocessorDefines.Multiline = true;
+            this.tbParserCppPreprocessorDefines.Name = "tbParserCppPreprocessorDefines";
+            this.tbParserCppPreprocessorDefines.ScrollBars = System.Windows.Forms.ScrollBars.Vertical;
+            this.tbParserCppPreprocessorDefines.Size = new System.Drawing.Size(436, 80);
+            this.tbParserCppPreprocessorDefines.TabIndex = 2;
+            this.tbParserCppPreprocessorDefines.WordWrap = false;
+            // 
+            // lblParserCppPreprocessorDefines
+            // 
+            this.lblParserCppPreprocessorDefines.AutoSize = true;
+            this.lblParserCppPreprocessorDefines.Dock = System.Windows.Forms.DockStyle.Top;
+            this.lblParserCppPreprocessorDefines.Location = new System.Drawing.Point(5, 47);
+            this.lblParserCppPreprocessorDefines.Name = "lblParserCppPreprocessorDefines";
+            this.lblParserCppPreprocessorDefines.Size = new System.Drawing.Size(436, 19);
+            this.lblParserCppPreprocessorDefines.TabIndex = 1;
+            this.lblParserCppPreprocessorDefines.Text = "Defines (one per line, NAME or NAME=VALUE):";
+            // 
+            // cbParserCppEvaluatePreprocessorConditions
+            // 
+            this.cbParserCppEvaluatePreprocessorConditions.AutoSize = true;
+            this.cbParserCppEvaluatePreprocessorConditions.Dock = System.Windows.Forms.DockStyle.Top;
+            this.cbParserCppEvaluatePreprocessorConditions.Location = new System.Drawing.Point(5, 24);
+            this.cbParserCppEvaluatePreprocessorConditions.Name = "cbParserCppEvaluatePreprocessorConditions";
+            this.cbParserCppEvaluatePreprocessorConditions.Size = new System.Drawing.Size(436, 23);
+            this.cbParserCppEvaluatePreprocessorConditions.TabIndex = 0;
+            this.cbParserCppEvaluatePreprocessorConditions.Text = "Evaluate Conditions (skip inactive branches)";
+            this.cbParserCppEvaluatePreprocessorConditions.UseVisualStyleBackColor = true;
+            // 
+            // tpParserSymbolPacks
+            // 
+            this.tpParserSymbolPacks.Controls.Add(this.gbParserSymbolPacks);
+            this.tpParserSymbolPacks.Location = new System.Drawing.Point(4, 29);
+            this.tpParserSymbolPacks.Margin = new System.Windows.Forms.Padding(0);
+            this.tpParserSymbolPacks.Name = "tpParserSymbolPacks";
+            this.tpParserSymbolPacks.Size = new System.Drawing.Size(446, 334);
+            this.tpParserSymbolPacks.TabIndex = 1;
+            this.tpParserSymbolPacks.Text = "Parser\\Symbol Packs";
+            this.tpParserSymbolPacks.UseVisualStyleBackColor = true;
+            // 
+            // gbParserSymbolPacks
+            // 
+            this.gbParserSymbolPacks.Controls.Add(this.btnAddParserSymbolPack);
+            this.gbParserSymbolPacks.Controls.Add(this.tbParserSymbolPackFiles);
+            this.gbParserSymbolPacks.Controls.Add(this.lblParserSymbolPackFiles);
+            this.gbParserSymbolPacks.Dock = System.Windows.Forms.DockStyle.Top;
+            this.gbParserSymbolPacks.Location = new System.Drawing.Point(0, 0);
+            this.gbParserSymbolPacks.Margin = new System.Windows.Forms.Padding(0);
+            this.gbParserSymbolPacks.Name = "gbParserSymbolPacks";
+            this.gbParserSymbolPacks.Padding = new System.Windows.Forms.Padding(5, 6, 5, 6);
+            this.gbParserSymbolPacks.Size = new System.Drawing.Size(446, 206);
+            this.gbParserSymbolPacks.TabIndex = 0;
+            this.gbParserSymbolPacks.TabStop = false;
+            this.gbParserSymbolPacks.Text = "Symbol Pack Files";
+            // 
+            // btnAddParserSymbolPack
+            // 
+            this.btnAddParserSymbolPack.Anchor = ((System.Windows.Forms.AnchorStyles)((System.Windows.Forms.AnchorStyles.Top | System.Windows.Forms.AnchorStyles.Right)));
+            this.btnAddParserSymbolPack.Location = new System.Drawing.Point(353, 169);
+            this.btnAddParserSymbolPack.Name = "btnAddParserSymbolPack";
+            this.btnAddParserSymbolPack.Size = new System.Drawing.Size(88, 30);
+            this.btnAddParserSymbolPack.TabIndex = 2;
+            this.btnAddParserSymbolPack.Text = "Add...";
+            this.btnAddParserSymbolPack.UseVisualStyleBackColor = true;
+            this.btnAddParserSymbolPack.Click += new System.EventHandler(this.btnAddParserSymbolPack_Click);
+            // 
+            // tbParserSymbolPackFiles
+            // 
+            this.tbParserSymbolPackFiles.AcceptsReturn = true;
+            this.tbParserSymbolPackFiles.Dock = System.Windows.Forms.DockStyle.Top;
+            this.tbParserSymbolPackFiles.Location = new System.Drawing.Point(5, 43);
+            this.tbParserSymbolPackFiles.Multiline = true;
+            this.tbParserSymbolPackFiles.Name = "tbParserSymbolPackFiles";
+            this.tbParserSymbolPackFiles.ScrollBars = System.Windows.Forms.ScrollBars.Both;
+            this.tbParserSymbolPackFiles.Size = new System.Drawing.Size(436, 120);
+            this.tbParserSymbolPackFiles.TabIndex = 1;
+            this.tbParserSymbolPackFiles.WordWrap = false;
+            // 
+            // lblParserSymbolPackFiles
+            // 
+            this.lblParserSymbolPackFiles.AutoSize = true;
+            this.lblParserSymbolPackFiles.Dock = System.Windows.Forms.DockStyle.Top;
+            this.lblParserSymbolPackFiles.Location = new System.Drawing.Point(5, 24);
+            this.lblParserSymbolPackFiles.Name = "lblParserSymbolPackFiles";
+            this.lblParserSymbolPackFiles.Size = new System.Drawing.Size(436, 19);
+            this.lblParserSymbolPackFiles.TabIndex = 0;
+            this.lblParserSymbolPackFiles.Text = "One file per line, relative to the workspace file:";
+            // 
             // tpValidationCpp
             // 
             this.tpValidationCpp.Controls.Add(this.gbValidationCppDocumentation);
@@ -295,7 +434,7 @@
             this.tpValidationCpp.Margin = new System.Windows.Forms.Padding(0);
             this.tpValidationCpp.Name = "tpValidationCpp";
             this.tpValidationCpp.Size = new System.Drawing.Size(446, 334);
-            this.tpValidationCpp.TabIndex = 1;
+            this.tpValidationCpp.TabIndex = 2;
             this.tpValidationCpp.Text = "Validation\\C/C++";
             this.tpValidationCpp.UseVisualStyleBackColor = true;
             // 
@@ -367,7 +506,7 @@
             this.tpEditorSyntaxHighlighting.Margin = new System.Windows.Forms.Padding(0);
             this.tpEditorSyntaxHighlighting.Name = "tpEditorSyntaxHighlighting";
             this.tpEditorSyntaxHighlighting.Size = new System.Drawing.Size(446, 334);
-            this.tpEditorSyntaxHighlighting.TabIndex = 2;
+            this.tpEditorSyntaxHighlighting.TabIndex = 3;
             this.tpEditorSyntaxHighlighting.Text = "Editor\\Syntax-Highlighting";
             this.tpEditorSyntaxHighlighting.UseVisualStyleBackColor = true;
             // 
@@ -378,7 +517,7 @@
             this.tpBuildOptions.Name = "tpBuildOptions";
             this.tpBuildOptions.Padding = new System.Windows.Forms.Padding(3);
             this.tpBuildOptions.Size = new System.Drawing.Size(446, 334);
-            this.tpBuildOptions.TabIndex = 3;
+            this.tpBuildOptions.TabIndex = 4;
             this.tpBuildOptions.Text = "Build";
             this.tpBuildOptions.UseVisualStyleBackColor = true;
             // 
@@ -481,6 +620,72 @@
             this.tbBuildDoxygenExecutablePath.Size = new System.Drawing.Size(228, 25);
             this.tbBuildDoxygenExecutablePath.TabIndex = 0;
             // 
+            // tpMemory
+            // 
+            this.tpMemory.Controls.Add(this.gbMemoryParseState);
+            this.tpMemory.Location = new System.Drawing.Point(4, 29);
+            this.tpMemory.Name = "tpMemory";
+            this.tpMemory.Padding = new System.Windows.Forms.Padding(3);
+            this.tpMemory.Size = new System.Drawing.Size(446, 334);
+            this.tpMemory.TabIndex = 5;
+            this.tpMemory.Text = "Memory";
+            this.tpMemory.UseVisualStyleBackColor = true;
+            // 
+            // gbMemoryParseState
+            // 
+            this.gbMemoryParseState.Controls.Add(this.lblMemoryParseStateBudgetHint);
+            this.gbMemoryParseState.Controls.Add(this.nudMemoryParseStateBudget);
+            this.gbMemoryParseState.Controls.Add(this.lblMemoryParseStateBudget);
+            this.gbMemoryParseState.Dock = System.Windows.Forms.DockStyle.Top;
+            this.gbMemoryParseState.Location = new System.Drawing.Point(3, 3);
+            this.gbMemoryParseState.Margin = new System.Windows.Forms.Padding(0);
+            this.gbMemoryParseState.Name = "gbMemoryParseState";
+            this.gbMemoryParseState.Padding = new System.Windows.Forms.Padding(5, 6, 5, 6);
+            this.gbMemoryParseState.Size = new System.Drawing.Size(440, 86);
+            this.gbMemoryParseState.TabIndex = 0;
+            this.gbMemoryParseState.TabStop = false;
+            this.gbMemoryParseState.Text = "Parse State";
+            // 
+            // lblMemoryParseStateBudgetHint
+            // 
+            this.lblMemoryParseStateBudgetHint.AutoSize = true;
+            this.lblMemoryParseStateBudgetHint.Location = new System.Drawing.Point(8, 56);
+            this.lblMemoryParseStateBudgetHint.Name = "lblMemoryParseStateBudgetHint";
+            this.lblMemoryParseStateBudgetHint.Size = new System.Drawing.Size(318, 19);
+            this.lblMemoryParseStateBudgetHint.TabIndex = 2;
+            this.lblMemoryParseStateBudgetHint.Text = "Tokens and styles of all open files, 0 = unlimited";
+            // 
+            // nudMemoryParseStateBudget
+            // 
+            this.nudMemoryParseStateBudget.Increment = new decimal(new int[] {
+            64,
+            0,
+            0,
+            0});
+            this.nudMemoryParseStateBudget.Location = new System.Drawing.Point(168, 22);
+            this.nudMemoryParseStateBudget.Maximum = new decimal(new int[] {
+            65536,
+            0,
+            0,
+            0});
+            this.nudMemoryParseStateBudget.Name = "nudMemoryParseStateBudget";
+            this.nudMemoryParseStateBudget.Size = new System.Drawing.Size(120, 25);
+            this.nudMemoryParseStateBudget.TabIndex = 1;
+            this.nudMemoryParseStateBudget.Value = new decimal(new int[] {
+            1024,
+            0,
+            0,
+            0});
+            // 
+            // lblMemoryParseStateBudget
+            // 
+            this.lblMemoryParseStateBudget.AutoSize = true;
+            this.lblMemoryParseStateBudget.Location = new System.Drawing.Point(8, 24);
+            this.lblMemoryParseStateBudget.Name = "lblMemoryParseStateBudget";
+            this.lblMemoryParseStateBudget.Size = new System.Drawing.Size(154, 19);
+            this.lblMemoryParseStateBudget.TabIndex = 0;
+            this.lblMemoryParseStateBudget.Text = "Budget (MB):";
+            // 
             // panOptionsTitleTop
             // 
             this.panOptionsTitleTop.Controls.Add(this.lblOptionsTitle);
@@ -531,6 +736,11 @@
             this.gbParserCppExcludedSymbols.PerformLayout();
             this.gbParserCppExcludedNodes.ResumeLayout(false);
             this.gbParserCppExcludedNodes.PerformLayout();
+            this.gbParserCppPreprocessor.ResumeLayout(false);
+            this.gbParserCppPreprocessor.PerformLayout();
+            this.tpParserSymbolPacks.ResumeLayout(false);
+            this.gbParserSymbolPacks.ResumeLayout(false);
+            this.gbParserSymbolPacks.PerformLayout();
             this.tpValidationCpp.ResumeLayout(false);
             this.tpValidationCpp.PerformLayout();
             this.gbValidationCppDocumentation.ResumeLayout(false);
@@ -540,6 +750,10 @@
             this.tpBuildOptions.ResumeLayout(false);
             this.groupBox1.ResumeLayout(false);
             this.groupBox1.PerformLayout();
+            this.tpMemory.ResumeLayout(false);
+            this.gbMemoryParseState.ResumeLayout(false);
+            this.gbMemoryParseState.PerformLayout();
+            ((System.ComponentModel.ISupportInitialize)(this.nudMemoryParseStateBudget)).EndInit();
             this.panOptionsTitleTop.ResumeLayout(false);
             this.ResumeLayout(false);
 
@@ -562,6 +776,15 @@
         private System.Windows.Forms.CheckBox cbParserCppExcludeFunctionCallSymbols;
         private System.Windows.Forms.GroupBox gbParserCppExcludedNodes;
         private System.Windows.Forms.CheckBox cbParserCppSkipFunctionBodies;
+        private System.Windows.Forms.GroupBox gbParserCppPreprocessor;
+        private System.Windows.Forms.CheckBox cbParserCppEvaluatePreprocessorConditions;
+        private System.Windows.Forms.Label lblParserCppPreprocessorDefines;
+        private System.Windows.Forms.TextBox tbParserCppPreprocessorDefines;
+        private System.Windows.Forms.TabPage tpParserSymbolPacks;
+        private System.Windows.Forms.GroupBox gbParserSymbolPacks;
+        private System.Windows.Forms.Label lblParserSymbolPackFiles;
+        private System.Windows.Forms.TextBox tbParserSymbolPackFiles;
+        private System.Windows.Forms.Button btnAddParserSymbolPack;
         private System.Windows.Forms.TabPage tpValidationCpp;
         private System.Windows.Forms.TabPage tpEditorSyntaxHighlighting;
         private System.Windows.Forms.Panel panOptionsTitleTop;
@@ -572,6 +795,11 @@
         private System.Windows.Forms.GroupBox gbValidationCppDocumentation;
         private System.Windows.Forms.CheckBox cbValidationCppRequireDoxygenReference;
         private System.Windows.Forms.TabPage tpBuildOptions;
+        private System.Windows.Forms.TabPage tpMemory;
+        private System.Windows.Forms.GroupBox gbMemoryParseState;
+        private System.Windows.Forms.Label lblMemoryParseStateBudget;
+        private System.Windows.Forms.NumericUpDown nudMemoryParseStateBudget;
+        private System.Windows.Forms.Label lblMemoryParseStateBudgetHint;
         private System.Windows.Forms.GroupBox groupBox1;
         private System.Windows.Forms.TextBox tbBuildDoxygenExecutablePath;
         private System.Windows.Forms.Label label1;
@@ -1,5 +1,7 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.Drawing;
+using System.Linq;
 using System.Windows.Forms;
 using TSP.DoxygenEditor.Models;
 
@@ -30,6 +32,9 @@ namespace TSP.DoxygenEditor.Views
             cbParserCppSkipFunctionBodies.Checked = Workspace.ParserCpp.ExcludeFunctionBodies;
             cbParserCppExcludeFunctionBodySymbols.Checked = Workspace.ParserCpp.ExcludeFunctionBodySymbols;
             cbParserCppExcludeFunctionCallSymbols.Checked = Workspace.ParserCpp.ExcludeFunctionCallSymbols;
+            cbParserCppEvaluatePreprocessorConditions.Checked = Workspace.ParserCpp.EvaluatePreprocessorConditions;
+            tbParserCppPreprocessorDefines.Lines = Workspace.ParserCpp.PreprocessorDefines.ToArray();
+            tbParserSymbolPackFiles.Lines = Workspace.ParserCpp.SymbolPackFiles.ToArray();
 
             cbValidationCppExcludePreprocessorMatch.Checked = Workspace.ValidationCpp.ExcludePreprocessorMatch;
             cbValidationCppExcludePreprocessorUsage.Checked = Workspace.ValidationCpp.ExcludePreprocessorUsage;
@@ -38,12 +43,17 @@ namespace TSP.DoxygenEditor.Views
             tbBuildSourcePath.Text = Workspace.Build.BaseDirectory;
             tbBuildDoxygenConfigFilePath.Text = Workspace.Build.ConfigFile;
             tbBuildDoxygenExecutablePath.Text = Workspace.Build.PathToDoxygen;
+
+            nudMemoryParseStateBudget.Value = Math.Max(nudMemoryParseStateBudget.Minimum, Math.Min(nudMemoryParseStateBudget.Maximum, Workspace.Memory.ParseStateBudget));
         }
         private void VisualToWorkspace()
         {
             Workspace.ParserCpp.ExcludeFunctionBodies = cbParserCppSkipFunctionBodies.Checked;
             Workspace.ParserCpp.ExcludeFunctionBodySymbols = cbParserCppExcludeFunctionBodySymbols.Checked;
             Workspace.ParserCpp.ExcludeFunctionCallSymbols = cbParserCppExcludeFunctionCallSymbols.Checked;
+            Workspace.ParserCpp.EvaluatePreprocessorConditions = cbParserCppEvaluatePreprocessorConditions.Checked;
+            Workspace.ParserCpp.UpdatePreprocessorDefines(GetLines(tbParserCppPreprocessorDefines));
+            Workspace.ParserCpp.UpdateSymbolPackFiles(GetLines(tbParserSymbolPackFiles));
 
             Workspace.ValidationCpp.ExcludePreprocessorMatch = cbValidationCppExcludePreprocessorMatch.Checked;
             Workspace.ValidationCpp.ExcludePreprocessorUsage = cbValidationCppExcludePreprocessorUsage.Checked;
@@ -52,6 +62,13 @@ namespace TSP.DoxygenEditor.Views
             Workspace.Build.BaseDirectory = tbBuildSourcePath.Text;
             Workspace.Build.ConfigFile = tbBuildDoxygenConfigFilePath.Text;
             Workspace.Build.PathToDoxygen = tbBuildDoxygenExecutablePath.Text;
+
+            Workspace.Memory.ParseStateBudget = (int)nudMemoryParseStateBudget.Value;
+        }
+
+        private static IEnumerable<string> GetLines(TextBox textBox)
+        {
+            return (textBox.Lines.Select(l => l.Trim()).Where(l => l.Length > 0));
         }
 
         private TabPage FindTabByOptionTag(string option)
@@ -113,6 +130,21 @@ namespace TSP.DoxygenEditor.Views
             }
         }
 
+        private void btnAddParserSymbolPack_Click(object sender, EventArgs e)
+        {
+            using (OpenFileDialog dlg = new OpenFileDialog())
+            {
+                dlg.Filter = "Symbol packs (*.dxsp)|*.dxsp";
+                dlg.Multiselect = true;
+                if (dlg.ShowDialog(this) == DialogResult.OK)
+                {
+                    List<string> lines = GetLines(tbParserSymbolPackFiles).ToList();
+                    lines.AddRange(dlg.FileNames.Where(f => !lines.Contains(f)));
+                    tbParserSymbolPackFiles.Lines = lines.ToArray();
+                }
+            }
+        }
+
         private void btnSelectBuildDoxygenConfigPath_Click(object sender, EventArgs e)
         {
             using (OpenFileDialog dlg = new OpenFileDialog())
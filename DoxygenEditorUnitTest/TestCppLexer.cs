@@ -21,5 +21,164 @@ namespace TSP.DoxygenEditor
                 Assert.IsTrue(tokens.Any());
             }
         }
+
+        private static List<CppToken> TokenizeWindows(string source, int windowLength)
+        {
+            List<CppToken> result = new List<CppToken>();
+            using (CppLexer lexer = new CppLexer(source, 0, source.Length, new TextPosition(), LanguageKind.Cpp))
+            {
+                IEnumerable<CppToken> tokens;
+                while (lexer.TokenizeWindow(windowLength, out tokens))
+                    result.AddRange(tokens);
+            }
+            return (result);
+        }
+
+        [TestMethod]
+        public void TokenizeWindows()
+        {
+            // Windows of any size must produce the same tokens as a full pass
+            foreach (string source in new[] { TSP.DoxygenEditor.Properties.Resources.final_platform_layer_h, TSP.DoxygenEditor.Properties.Resources.final_platform_layer_docs })
+            {
+                List<CppToken> expected;
+                using (CppLexer lexer = new CppLexer(source, 0, source.Length, new TextPosition(), LanguageKind.Cpp))
+                    expected = lexer.Tokenize().ToList();
+                foreach (int windowLength in new[] { 1, 4096, 64 * 1024 })
+                {
+                    List<CppToken> actual = TokenizeWindows(source, windowLength);
+                    Assert.AreEqual(expected.Count, actual.Count);
+                    for (int i = 0; i < expected.Count; ++i)
+                    {
+                        Assert.AreEqual(expected[i].Kind, actual[i].Kind);
+                        Assert.AreEqual(expected[i].Index, actual[i].Index);
+                        Assert.AreEqual(expected[i].Length, actual[i].Length);
+                        Assert.AreEqual(expected[i].Position.Line, actual[i].Position.Line);
+                    }
+                }
+            }
+        }
+
+        [TestMethod]
+        public void SkipInactivePreprocessorBranches()
+        {
+            string source =
+                "#if defined(PLATFORM_A)\n" +
+                "int a;\n" +
+                "const char *s = \"a/*b\";\n" +
+                "#\tif 1\n" +
+                "int nested;\n" +
+                "#\tendif\n" +
+                "#elif VERSION >= 2 && !defined(PLATFORM_C)\n" +
+                "int b;\n" +
+                "#else\n" +
+                "int c;\n" +
+                "#endif\n" +
+                "int d;\n";
+            CppPreprocessorDefines defines = CppPreprocessorDefines.Parse(new[] { "PLATFORM_B", "VERSION=2" });
+            using (CppLexer lexer = new CppLexer(source, 0, source.Length, new TextPosition(), LanguageKind.Cpp, CppLexer.LexMode.Full, defines))
+            {
+                List<CppToken> tokens = lexer.Tokenize().ToList();
+                Assert.IsFalse(lexer.LexErrors.Any());
+                string[] idents = tokens.Where(t => t.Kind == CppTokenKind.IdentLiteral).Select(t => t.Value).ToArray();
+                CollectionAssert.AreEqual(new[] { "VERSION", "b", "d" }, idents);
+                List<CppToken> inactiveTokens = tokens.Where(t => t.Kind == CppTokenKind.PreprocessorInactive).ToList();
+                Assert.AreEqual(2, inactiveTokens.Count);
+                Assert.AreEqual(1, inactiveTokens[0].Position.Line);
+                Assert.AreEqual(9, inactiveTokens[1].Position.Line);
+                CppToken lastToken = tokens.Last(t => t.Kind == CppTokenKind.IdentLiteral);
+                Assert.AreEqual(11, lastToken.Position.Line);
+            }
+        }
+
+        [TestMethod]
+        public void KeepUnknownPreprocessorBranches()
+        {
+            string source =
+                "#if VERSION_STRING > 1\n" +
+                "int a;\n" +
+                "#elif 0\n" +
+                "int b;\n" +
+                "#else\n" +
+                "int c;\n" +
+                "#endif\n" +
+                "#if defined(OTHER) && VERSION_STRING > 1\n" +
+                "int d;\n" +
+                "#elif VERSION_STRING > 2\n" +
+                "int e;\n" +
+                "#elif 1\n" +
+                "int f;\n" +
+                "#else\n" +
+                "int g;\n" +
+                "#endif\n";
+            CppPreprocessorDefines defines = CppPreprocessorDefines.Parse(new[] { "VERSION_STRING=\"1.0\"" });
+            using (CppLexer lexer = new CppLexer(source, 0, source.Length, new TextPosition(), LanguageKind.Cpp, CppLexer.LexMode.Full, defines))
+            {
+                List<CppToken> tokens = lexer.Tokenize().ToList();
+
+                // Unknown conditions keep their arm and the following #elif/#else arms active, until a known arm is taken
+                string[] idents = tokens.Where(t => t.Kind == CppTokenKind.IdentLiteral && t.Length == 1).Select(t => t.Value).ToArray();
+                CollectionAssert.AreEqual(new[] { "a", "c", "e", "f" }, idents);
+
+                // The right side of && is not evaluated when the left side is false
+                Assert.AreEqual(2, lexer.LexErrors.Count());
+            }
+        }
+
+        [TestMethod]
+        public void LexIncludes()
+        {
+            string source =
+                "#include \"local.h\"\n" +
+                "#include <system.h>\n" +
+                "#include CONFIG_H\n";
+            using (CppLexer lexer = new CppLexer(source, 0, source.Length, new TextPosition(), LanguageKind.Cpp))
+            {
+                List<CppToken> tokens = lexer.Tokenize().ToList();
+                Assert.IsFalse(lexer.LexErrors.Any());
+                string[] includes = tokens.Where(t => t.Kind == CppTokenKind.PreprocessorInclude && t.IsComplete).Select(t => t.Value).ToArray();
+                CollectionAssert.AreEqual(new[] { "\"local.h\"", "<system.h>", "CONFIG_H" }, includes);
+            }
+        }
+
+        [TestMethod]
+        public void SkipFunctionBodies()
+        {
+            string source =
+                "struct __attribute__((packed)) { int packedMember; };\n" +
+                "struct alignas(8) AlignedStruct { int alignedMember; };\n" +
+                "typedef struct PACKED(MacroStruct) { int macroMember; } MacroStruct;\n" +
+                "struct AlignedStruct *GetStruct(void) {\n" +
+                "  const char *s = R\"x(}\n{{)\" )x\";\n" +
+                "  return 0;\n" +
+                "}\n" +
+                "void Conditional(int a) {\n" +
+                "#if defined(A)\n" +
+                "  if (innerA) {\n" +
+                "#else\n" +
+                "  if (!innerB) {\n" +
+                "#endif\n" +
+                "  }\n" +
+                "}\n" +
+                "int afterValue;\n";
+            using (CppLexer lexer = new CppLexer(source, 0, source.Length, new TextPosition(), LanguageKind.Cpp, CppLexer.LexMode.DeclarationsOnly, null))
+            {
+                List<CppToken> tokens = lexer.Tokenize().ToList();
+                Assert.IsFalse(lexer.LexErrors.Any());
+                string[] idents = tokens.Where(t => t.Kind == CppTokenKind.IdentLiteral).Select(t => t.Value).ToArray();
+                foreach (string ident in new[] { "packedMember", "alignedMember", "macroMember", "GetStruct", "Conditional", "afterValue" })
+                    CollectionAssert.Contains(idents, ident);
+                CollectionAssert.DoesNotContain(idents, "s");
+                CollectionAssert.DoesNotContain(idents, "innerA");
+                CollectionAssert.DoesNotContain(idents, "innerB");
+                List<CppToken> bodies = tokens.Where(t => t.Kind == CppTokenKind.SkippedBody).ToList();
+                Assert.AreEqual(2, bodies.Count);
+                Assert.AreEqual(3, bodies[0].Position.Line);
+                Assert.AreEqual(8, bodies[1].Position.Line);
+                CppToken lastToken = tokens.Last(t => t.Kind == CppTokenKind.IdentLiteral);
+                Assert.AreEqual("afterValue", lastToken.Value);
+                Assert.AreEqual(16, lastToken.Position.Line);
+                Assert.AreEqual(4, lastToken.Position.Column);
+            }
+        }
     }
 }
\ No newline at end of file
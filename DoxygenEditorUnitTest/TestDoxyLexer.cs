@@ -73,6 +73,35 @@ namespace TSP.DoxygenEditor
             Lex($"//!@bri{Environment.NewLine}//!");
         }
 
+        [TestMethod]
+        public void TestCodeBlocks()
+        {
+            // C/C++ code blocks have a code range for the content
+            Lex("/** @code{.c} int a; @endcode */",
+                new ExpectToken(DoxygenTokenKind.DoxyBlockStartMulti, "/**"),
+                new ExpectToken(DoxygenTokenKind.TextStart, 0),
+                new ExpectToken(DoxygenTokenKind.TextEnd, 0),
+                new ExpectToken(DoxygenTokenKind.CommandStart, "@code"),
+                new ExpectToken(DoxygenTokenKind.ArgumentCaption, "{.c}"),
+                new ExpectToken(DoxygenTokenKind.Code, " int a; "),
+                new ExpectToken(DoxygenTokenKind.CommandEnd, "@endcode"),
+                new ExpectToken(DoxygenTokenKind.TextStart, 0),
+                new ExpectToken(DoxygenTokenKind.TextEnd, 0),
+                new ExpectToken(DoxygenTokenKind.DoxyBlockEnd, "*/"));
+
+            // Other code blocks have no code range
+            Lex("/** @code int a; @endcode */",
+                new ExpectToken(DoxygenTokenKind.DoxyBlockStartMulti, "/**"),
+                new ExpectToken(DoxygenTokenKind.TextStart, 0),
+                new ExpectToken(DoxygenTokenKind.TextEnd, 0),
+                new ExpectToken(DoxygenTokenKind.CommandStart, "@code"),
+                new ExpectToken(DoxygenTokenKind.ArgumentCaption, 0),
+                new ExpectToken(DoxygenTokenKind.CommandEnd, "@endcode"),
+                new ExpectToken(DoxygenTokenKind.TextStart, 0),
+                new ExpectToken(DoxygenTokenKind.TextEnd, 0),
+                new ExpectToken(DoxygenTokenKind.DoxyBlockEnd, "*/"));
+        }
+
         [TestMethod]
         public void ParseFPLDocs()
         {
@@ -0,0 +1,133 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using TSP.DoxygenEditor.Includes;
+using TSP.DoxygenEditor.Languages.Doxygen;
+using TSP.DoxygenEditor.Parsers;
+using TSP.DoxygenEditor.TextAnalysis;
+
+namespace TSP.DoxygenEditor
+{
+    [TestClass]
+    public class TestDoxyfileBootstrap
+    {
+        private string _tempPath;
+
+        [TestInitialize]
+        public void Setup()
+        {
+            _tempPath = Path.Combine(Path.GetTempPath(), "doxyedit_bootstrap_" + Guid.NewGuid().ToString("N"));
+            Directory.CreateDirectory(_tempPath);
+        }
+
+        [TestCleanup]
+        public void Cleanup()
+        {
+            if (Directory.Exists(_tempPath))
+                Directory.Delete(_tempPath, true);
+        }
+
+        private string WriteFile(string name, string content = "")
+        {
+            string filePath = Path.Combine(_tempPath, name);
+            Directory.CreateDirectory(Path.GetDirectoryName(filePath));
+            File.WriteAllText(filePath, content);
+            return (Path.GetFullPath(filePath));
+        }
+
+        private static IBaseNode ParseConfig(string config)
+        {
+            List<DoxygenToken> tokens = new List<DoxygenToken>();
+            using (DoxygenConfigLexer lexer = new DoxygenConfigLexer(config, 0, config.Length, new TextPosition()))
+                tokens.AddRange(lexer.Tokenize());
+            using (DoxygenConfigParser parser = new DoxygenConfigParser(null))
+            {
+                parser.ParseTokens(config, tokens);
+                return (parser.Root);
+            }
+        }
+
+        [TestMethod]
+        public void DiscoverFiles()
+        {
+            List<string> expected = new List<string>()
+            {
+                WriteFile(Path.Combine("src", "a.h")),
+                WriteFile(Path.Combine("src", "b.c")),
+                WriteFile(Path.Combine("src", "sub", "c.hpp")),
+                WriteFile(Path.Combine("src", "sub", "e.cpp")),
+            };
+            WriteFile(Path.Combine("src", "a.txt"));
+            WriteFile(Path.Combine("src", "test_a.h"));
+            WriteFile(Path.Combine("src", "sub", "e.xpp"));
+            WriteFile(Path.Combine("src", "skip", "d.h"));
+            WriteFile(Path.Combine("other", "f.h"));
+
+            // A link back to the input directory must not be followed again
+            try
+            {
+                Directory.CreateSymbolicLink(Path.Combine(_tempPath, "src", "sub", "loop"), Path.Combine(_tempPath, "src"));
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+            {
+            }
+
+            string config =
+                "INPUT = src\n" +
+                "FILE_PATTERNS = *.h \\\n" +
+                "                *.[!x]pp\n" +
+                "FILE_PATTERNS += *.c\n" +
+                "RECURSIVE = YES\n" +
+                "EXCLUDE = src/skip\n" +
+                "EXCLUDE_PATTERNS = */test_*\n";
+            DoxyfileBootstrap bootstrap = new DoxyfileBootstrap(ParseConfig(config), _tempPath);
+            CollectionAssert.AreEqual(new[] { "*.h", "*.[!x]pp", "*.c" }, bootstrap.FilePatterns.ToArray());
+            IReadOnlyList<string> files = bootstrap.DiscoverFiles();
+            CollectionAssert.AreEquivalent(expected, files.ToArray());
+            Assert.AreEqual(expected.Count, bootstrap.DiscoverStage.ItemCount);
+
+            // Without RECURSIVE only the top level is enumerated
+            DoxyfileBootstrap flatBootstrap = new DoxyfileBootstrap(ParseConfig(config.Replace("RECURSIVE = YES", "RECURSIVE = NO")), _tempPath);
+            CollectionAssert.AreEquivalent(expected.Take(2).ToArray(), flatBootstrap.DiscoverFiles().ToArray());
+        }
+
+        [TestMethod]
+        public void DiscoverFilesWithDanglingLink()
+        {
+            List<string> expected = new List<string>();
+            for (int i = 0; i < 32; ++i)
+                expected.Add(WriteFile(Path.Combine("src", $"file{i}.h")));
+
+            // A link to a missing file is skipped, without losing the other files of the directory
+            try
+            {
+                File.CreateSymbolicLink(Path.Combine(_tempPath, "src", "dangling.h"), Path.Combine(_tempPath, "missing.h"));
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+            {
+                Assert.Inconclusive($"Symbolic links are not supported: {e.Message}");
+            }
+
+            DoxyfileBootstrap bootstrap = new DoxyfileBootstrap(ParseConfig("INPUT = src\nFILE_PATTERNS = *.h\n"), _tempPath);
+            IReadOnlyList<string> files = bootstrap.DiscoverFiles();
+            CollectionAssert.AreEquivalent(expected, files.ToArray());
+            Assert.AreEqual(expected.Count, bootstrap.DiscoverStage.ItemCount);
+        }
+
+        [TestMethod]
+        public void CompareSignatures()
+        {
+            string config = "PROJECT_NAME = A\nINPUT = src\nFILE_PATTERNS = *.h\n";
+            string signature = DoxyfileBootstrap.GetSignature(ParseConfig(config), _tempPath);
+            Assert.AreEqual(signature, new DoxyfileBootstrap(ParseConfig(config), _tempPath).Signature);
+
+            // Settings which do not change the discovered files keep the signature
+            Assert.AreEqual(signature, DoxyfileBootstrap.GetSignature(ParseConfig(config.Replace("PROJECT_NAME = A", "PROJECT_NAME = B")), _tempPath));
+            Assert.AreNotEqual(signature, DoxyfileBootstrap.GetSignature(ParseConfig(config + "FILE_PATTERNS += *.c\n"), _tempPath));
+            Assert.AreNotEqual(signature, DoxyfileBootstrap.GetSignature(ParseConfig(config + "EXCLUDE_PATTERNS = */test_*\n"), _tempPath));
+            Assert.AreNotEqual(signature, DoxyfileBootstrap.GetSignature(ParseConfig(config), Path.Combine(_tempPath, "other")));
+        }
+    }
+}
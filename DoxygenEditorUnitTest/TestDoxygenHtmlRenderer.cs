@@ -0,0 +1,104 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using TSP.DoxygenEditor.Languages;
+using TSP.DoxygenEditor.Languages.Doxygen;
+using TSP.DoxygenEditor.Lexers;
+using TSP.DoxygenEditor.Symbols;
+using TSP.DoxygenEditor.TextAnalysis;
+
+namespace TSP.DoxygenEditor
+{
+    [TestClass]
+    public class TestDoxygenHtmlRenderer
+    {
+        class SimpleSymbolTableId : ISymbolTableId
+        {
+            public object SymbolTableId { get; }
+
+            public SimpleSymbolTableId(object id)
+            {
+                SymbolTableId = id;
+            }
+        }
+
+        private static string Render(string source, Func<string, Tuple<SourceSymbol, ISymbolTableId>> resolveReference)
+        {
+            List<IBaseToken> tokens;
+            using (DoxygenBlockLexer lexer = new DoxygenBlockLexer(source, 0, source.Length, new TextPosition(0)))
+                tokens = new List<IBaseToken>(lexer.Tokenize());
+            using (DoxygenBlockParser parser = new DoxygenBlockParser(new SimpleSymbolTableId(42)))
+            {
+                parser.ParseTokens(source, tokens.Where(t => !t.IsEOF));
+                DoxygenBlockNode blockNode = DoxygenHtmlRenderer.FindBlockAt(parser.Root, 0);
+                Assert.IsNotNull(blockNode);
+                DoxygenHtmlRenderer renderer = new DoxygenHtmlRenderer() { ResolveReference = resolveReference };
+                return (renderer.RenderBlock(blockNode));
+            }
+        }
+
+        [TestMethod]
+        public void RenderCommands()
+        {
+            string source =
+                "/**\n" +
+                " * @brief Initializes the platform\n" +
+                " * @param flags The init flags\n" +
+                " * @note Call it once\n" +
+                " * @code{.c}\n" +
+                " * int x = a < b;\n" +
+                " * @endcode\n" +
+                " */";
+            string html = Render(source, (name) => null);
+            StringAssert.Contains(html, "<p class=\"brief\">Initializes the platform");
+            StringAssert.Contains(html, "<dt>Note</dt><dd>Call it once");
+            StringAssert.Contains(html, "<b>flags</b>");
+            StringAssert.Contains(html, "<pre class=\"fragment\"><code>int x = a &lt; b;</code></pre>");
+        }
+
+        [TestMethod]
+        public void RenderEquivalentCommands()
+        {
+            string source =
+                "/**\n" +
+                " * @short Releases the platform\n" +
+                " * @returns True when @p force was set\n" +
+                " * @throws Nothing\n" +
+                " * @see fplPlatformInit\n" +
+                " */";
+            string html = Render(source, (name) => null);
+            StringAssert.Contains(html, "<p class=\"brief\">Releases the platform");
+            StringAssert.Contains(html, "<dt>Returns</dt><dd>True when <code>force</code>");
+            StringAssert.Contains(html, "<dt>Exceptions</dt><dd><b>Nothing</b>");
+            StringAssert.Contains(html, "<dt>See also</dt><dd>fplPlatformInit");
+        }
+
+        [TestMethod]
+        public void RenderReferences()
+        {
+            SourceSymbol releaseSymbol = new SourceSymbol(LanguageKind.DoxygenCode, SourceSymbolKind.DoxygenSection, "fplPlatformRelease", "Release the platform", new TextRange(new TextPosition(0), 1));
+            Func<string, Tuple<SourceSymbol, ISymbolTableId>> resolve = (name) => "fplPlatformRelease".Equals(name) ? Tuple.Create(releaseSymbol, (ISymbolTableId)new SimpleSymbolTableId(1)) : null;
+            string source = "/** See @ref fplPlatformRelease and @ref fplMissing */";
+            string html = Render(source, resolve);
+            StringAssert.Contains(html, "<a href=\"symbol:fplPlatformRelease\">Release the platform</a>");
+            StringAssert.Contains(html, "<span class=\"unresolved\" title=\"Unresolved reference\">fplMissing</span>");
+        }
+
+        [TestMethod]
+        public void RenderSafeHtml()
+        {
+            string source = "/** Call <b onclick=\"evil()\">once</b> <script>alert(1)</script> <a href=\"javascript:alert(1)\">x</a> <a href='symbol:fplX'>y</a> <img src=\"http://example.com/a.png\" alt=\"A\"/> a < b &amp; c */";
+            string html = Render(source, (name) => null);
+            StringAssert.Contains(html, "<b>once</b>");
+            StringAssert.Contains(html, "&lt;script&gt;alert(1)&lt;/script&gt;");
+            StringAssert.Contains(html, "<a>x</a>");
+            StringAssert.Contains(html, "<a href=\"symbol:fplX\">y</a>");
+            StringAssert.Contains(html, "<img alt=\"A\"/>");
+            StringAssert.Contains(html, "a &lt; b &amp; c");
+            Assert.IsFalse(html.Contains("onclick"));
+            Assert.IsFalse(html.Contains("javascript"));
+            Assert.IsFalse(html.Contains("example.com"));
+        }
+    }
+}
@@ -1,9 +1,11 @@
 ﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
 using System.Collections.Generic;
+using System.Linq;
 using TSP.DoxygenEditor.Languages;
 using TSP.DoxygenEditor.Languages.Cpp;
 using TSP.DoxygenEditor.Languages.Doxygen;
 using TSP.DoxygenEditor.Lexers;
+using TSP.DoxygenEditor.Parsers;
 using TSP.DoxygenEditor.Symbols;
 using TSP.DoxygenEditor.TextAnalysis;
 
@@ -74,6 +76,143 @@ namespace TSP.DoxygenEditor
             }
         }
 
+        private DoxygenBlockParser ParseBlock(DoxygenBlockCache cache, string source, int index, int length, TextPosition pos)
+        {
+            List<IBaseToken> tokens;
+            List<TextError> errors;
+            if (!cache.TryGetTokens(source, index, length, pos, null, out tokens, out errors))
+            {
+                using (DoxygenBlockLexer doxyLexer = new DoxygenBlockLexer(source, index, length, pos))
+                {
+                    tokens = new List<IBaseToken>(doxyLexer.Tokenize());
+                    cache.AddTokens(source, index, length, pos, tokens, doxyLexer.LexErrors);
+                }
+            }
+            DoxygenBlockParser doxyParser = new DoxygenBlockParser(new SimpleSymbolTableId(42)) { BlockCache = cache };
+            doxyParser.ParseTokens(source, tokens.Where(t => !t.IsEOF));
+            return (doxyParser);
+        }
+
+        [TestMethod]
+        public void ParseCachedBlocks()
+        {
+            const string block = "/**\n * @brief Initializes the platform\n * @param flags The init flags\n * See @ref fplPlatformRelease for more details\n */";
+            string source = block;
+            string movedSource = "\n\nint x;\n" + block;
+            int movedIndex = movedSource.Length - block.Length;
+            TextPosition movedPos = new TextPosition(movedIndex, 3, 0);
+
+            DoxygenBlockCache cache = new DoxygenBlockCache();
+            cache.BeginParse();
+            IBaseNode firstBlockNode;
+            using (DoxygenBlockParser firstParser = ParseBlock(cache, source, 0, source.Length, new TextPosition(0)))
+            {
+                firstBlockNode = firstParser.Root.Children.First();
+                cache.EndParse();
+                Assert.AreEqual(0, cache.ParseHits);
+                Assert.AreEqual(1, cache.Count);
+                Assert.IsTrue(cache.EstimatedSize >= block.Length * sizeof(char));
+            }
+
+            cache.BeginParse();
+            using (DoxygenBlockParser cachedParser = ParseBlock(cache, movedSource, movedIndex, block.Length, movedPos))
+            {
+                cache.EndParse();
+                Assert.AreEqual(1, cache.TokenHits);
+                Assert.AreEqual(1, cache.ParseHits);
+                using (DoxygenBlockParser freshParser = ParseBlock(new DoxygenBlockCache(), movedSource, movedIndex, block.Length, movedPos))
+                {
+                    Assert.AreEqual(freshParser.TotalNodeCount, cachedParser.TotalNodeCount);
+
+                    // The cache keeps its own copy, so the nodes of the first parse are never handed out again
+                    Assert.AreNotSame(firstBlockNode, cachedParser.Root.Children.First());
+                    CollectionAssert.AreEqual(DumpParser(freshParser), DumpParser(cachedParser));
+                    string[] freshSymbols = freshParser.LocalSymbolTable.ReferenceMap.SelectMany(r => r.Value).Select(r => $"{r.Name}:{r.Range}").ToArray();
+                    string[] cachedSymbols = cachedParser.LocalSymbolTable.ReferenceMap.SelectMany(r => r.Value).Select(r => $"{r.Name}:{r.Range}").ToArray();
+                    CollectionAssert.AreEqual(freshSymbols, cachedSymbols);
+                }
+            }
+
+            cache.Clear();
+            Assert.AreEqual(0, cache.Count);
+            Assert.AreEqual(0L, cache.EstimatedSize);
+        }
+
+        private List<IBaseToken> LexDocumentation(string source)
+        {
+            // Doxygen tokens are placed behind their comment token, just like the editor does
+            List<IBaseToken> result = new List<IBaseToken>();
+            using (CppLexer cppLexer = new CppLexer(source, 0, source.Length, new TextPosition(), LanguageKind.Cpp))
+            {
+                foreach (CppToken token in cppLexer.Tokenize())
+                {
+                    result.Add(token);
+                    if (token.Kind == CppTokenKind.MultiLineCommentDoc || token.Kind == CppTokenKind.SingleLineCommentDoc)
+                    {
+                        using (DoxygenBlockLexer doxyLexer = new DoxygenBlockLexer(source, token.Index, token.Length, token.Position))
+                            result.AddRange(doxyLexer.Tokenize().Where(t => !t.IsEOF));
+                    }
+                }
+            }
+            return (result);
+        }
+
+        private static void DumpNode(IBaseNode node, List<string> lines)
+        {
+            foreach (IBaseNode child in node.Children)
+            {
+                DoxygenBlockEntity entity = ((DoxygenBlockNode)child).Entity;
+                string parentKind = child.Parent != null ? ((DoxygenBlockNode)child.Parent).Entity.Kind.ToString() : "";
+                string parameters = string.Join(",", entity.Parameters.Select(p => $"{p.Name}={p.Value}"));
+                lines.Add($"{child.Level} {parentKind} {entity.Kind} {entity.StartRange} {entity.EndRange} {entity.Id} {entity.Value} {parameters}");
+                DumpNode(child, lines);
+            }
+        }
+
+        private static List<string> DumpParser(DoxygenBlockParser parser)
+        {
+            List<string> result = new List<string>();
+            result.Add($"Nodes: {parser.TotalNodeCount}");
+            DumpNode(parser.Root, result);
+            foreach (KeyValuePair<string, List<SourceSymbol>> sourcePair in parser.LocalSymbolTable.SourceMap)
+                result.AddRange(sourcePair.Value.Select(s => $"Source {s.Kind} {s.Name} {s.Range} {((DoxygenBlockNode)s.Node)?.Entity.StartRange}"));
+            foreach (KeyValuePair<string, List<ReferenceSymbol>> referencePair in parser.LocalSymbolTable.ReferenceMap)
+                result.AddRange(referencePair.Value.Select(r => $"Reference {r.Kind} {r.Name} {r.Range} {((DoxygenBlockNode)r.Node)?.Entity.StartRange}"));
+            result.AddRange(parser.ParseErrors.Select(e => $"Error {e.Pos} {e.Message} {e.Tag == parser}"));
+            return (result);
+        }
+
+        private void ParseParallel(string source)
+        {
+            List<IBaseToken> tokens = LexDocumentation(source);
+            using (DoxygenBlockParser sequentialParser = new DoxygenBlockParser(new SimpleSymbolTableId(42)))
+            using (DoxygenBlockParser parallelParser = new DoxygenBlockParser(new SimpleSymbolTableId(42)) { IsParallel = true })
+            {
+                sequentialParser.ParseTokens(source, tokens);
+                parallelParser.ParseTokens(source, tokens);
+                CollectionAssert.AreEqual(DumpParser(sequentialParser), DumpParser(parallelParser));
+            }
+        }
+
+        [TestMethod]
+        public void ParseParallelBlocks()
+        {
+            // Groups, sections and blocks which leave entities open must end up exactly like the sequential parse
+            List<string> blocks = new List<string>();
+            for (int i = 0; i < 40; ++i)
+            {
+                blocks.Add($"/**\n * @defgroup Group{i} Group {i}\n * @brief Group {i}\n * @{{\n */\n");
+                blocks.Add($"/// @brief Function {i}, see @ref Function{i + 1}\nvoid Function{i}();\n");
+                blocks.Add($"//! @param x Leaks the brief @warning {i}\nvoid Leak{i}(int x);\n");
+                blocks.Add($"/**\n * @page Page{i} Page {i}\n * @section Section{i} Section {i}\n * Text <b>{i}</b>\n * @code{{.c}}\n int a;\n @endcode\n */\n");
+                blocks.Add("/** @} */\n");
+            }
+            ParseParallel(string.Join("", blocks));
+
+            ParseParallel(TSP.DoxygenEditor.Properties.Resources.final_platform_layer_h);
+            ParseParallel(TSP.DoxygenEditor.Properties.Resources.final_platform_layer_docs);
+        }
+
         [TestMethod]
         public void ParseFPLSources()
         {
@@ -0,0 +1,121 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using TSP.DoxygenEditor.Languages.Html;
+using TSP.DoxygenEditor.Lexers;
+using TSP.DoxygenEditor.TextAnalysis;
+
+namespace TSP.DoxygenEditor
+{
+    [TestClass]
+    public class TestHtmlScanner
+    {
+        class ExpectToken
+        {
+            public HtmlTokenKind Kind { get; }
+            public int Length { get; }
+            public string Name { get; }
+            public ExpectToken(HtmlTokenKind kind, int length, string name = null)
+            {
+                Kind = kind;
+                Length = length;
+                Name = name;
+            }
+        }
+
+        private List<HtmlToken> Scan(string source, params ExpectToken[] expectedTokens)
+        {
+            HtmlScanner scanner = new HtmlScanner();
+            List<IBaseToken> tokens = new List<IBaseToken>();
+            int count = scanner.Scan(source, 0, source.Length, new TextPosition(0), tokens);
+            Assert.AreEqual(tokens.Count, count);
+            List<HtmlToken> result = tokens.Cast<HtmlToken>().ToList();
+            Assert.AreEqual(expectedTokens.Length, result.Count);
+            for (int i = 0; i < expectedTokens.Length; ++i)
+            {
+                ExpectToken et = expectedTokens[i];
+                HtmlToken token = result[i];
+                Assert.AreEqual(et.Kind, token.Kind);
+                Assert.AreEqual(et.Length, token.Length);
+                if (et.Name != null)
+                    Assert.AreEqual(et.Name, token.Value);
+            }
+            return (result);
+        }
+
+        [TestMethod]
+        public void TestPlainText()
+        {
+            // Text without any tags produces no tokens at all, not even the EOF
+            Scan("");
+            Scan("Hello world");
+            Scan("a > b");
+        }
+
+        [TestMethod]
+        public void TestTags()
+        {
+            Scan("<b>bold</b>",
+                new ExpectToken(HtmlTokenKind.MetaTagStart, 3),
+                new ExpectToken(HtmlTokenKind.TagChars, 1),
+                new ExpectToken(HtmlTokenKind.TagName, 1, "b"),
+                new ExpectToken(HtmlTokenKind.TagChars, 1),
+                new ExpectToken(HtmlTokenKind.MetaTagClose, 4),
+                new ExpectToken(HtmlTokenKind.TagChars, 2),
+                new ExpectToken(HtmlTokenKind.TagName, 1, "b"),
+                new ExpectToken(HtmlTokenKind.TagChars, 1),
+                new ExpectToken(HtmlTokenKind.EOF, 0));
+            Scan("<BR />",
+                new ExpectToken(HtmlTokenKind.MetaTagStartAndClose, 6),
+                new ExpectToken(HtmlTokenKind.TagChars, 1),
+                new ExpectToken(HtmlTokenKind.TagName, 2, "br"),
+                new ExpectToken(HtmlTokenKind.TagChars, 1),
+                new ExpectToken(HtmlTokenKind.EOF, 0));
+        }
+
+        [TestMethod]
+        public void TestAttributes()
+        {
+            List<HtmlToken> tokens = Scan("<a href=\"#top\" target=_blank data=1>",
+                new ExpectToken(HtmlTokenKind.MetaTagStart, 36),
+                new ExpectToken(HtmlTokenKind.TagChars, 1),
+                new ExpectToken(HtmlTokenKind.TagName, 1, "a"),
+                new ExpectToken(HtmlTokenKind.AttrName, 4, "href"),
+                new ExpectToken(HtmlTokenKind.AttrChars, 1),
+                new ExpectToken(HtmlTokenKind.AttrValue, 6),
+                new ExpectToken(HtmlTokenKind.AttrName, 6, "target"),
+                new ExpectToken(HtmlTokenKind.AttrChars, 1),
+                new ExpectToken(HtmlTokenKind.AttrValue, 6),
+                new ExpectToken(HtmlTokenKind.AttrName, 4),
+                new ExpectToken(HtmlTokenKind.AttrChars, 1),
+                new ExpectToken(HtmlTokenKind.AttrValue, 1),
+                new ExpectToken(HtmlTokenKind.TagChars, 1),
+                new ExpectToken(HtmlTokenKind.EOF, 0));
+            Assert.AreEqual(HtmlSyntax.GetTagId("a"), tokens[2].NameId);
+            Assert.AreEqual(HtmlSyntax.GetAttributeId("HREF"), tokens[3].NameId);
+            // Unknown names are not resolved
+            Assert.AreEqual(HtmlSyntax.InvalidNameId, tokens[9].NameId);
+            Assert.IsNull(tokens[9].Value);
+        }
+
+        [TestMethod]
+        public void TestPositions()
+        {
+            List<HtmlToken> tokens = Scan("first\n\tline <em>x</em>",
+                new ExpectToken(HtmlTokenKind.MetaTagStart, 4),
+                new ExpectToken(HtmlTokenKind.TagChars, 1),
+                new ExpectToken(HtmlTokenKind.TagName, 2, "em"),
+                new ExpectToken(HtmlTokenKind.TagChars, 1),
+                new ExpectToken(HtmlTokenKind.MetaTagClose, 5),
+                new ExpectToken(HtmlTokenKind.TagChars, 2),
+                new ExpectToken(HtmlTokenKind.TagName, 2, "em"),
+                new ExpectToken(HtmlTokenKind.TagChars, 1),
+                new ExpectToken(HtmlTokenKind.EOF, 0));
+            Assert.AreEqual(12, tokens[0].Index);
+            Assert.AreEqual(1, tokens[0].Position.Line);
+            Assert.AreEqual(9, tokens[0].Position.Column);
+            Assert.AreEqual(17, tokens[4].Index);
+            Assert.AreEqual(14, tokens[4].Position.Column);
+        }
+    }
+}
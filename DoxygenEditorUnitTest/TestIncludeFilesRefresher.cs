@@ -0,0 +1,136 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Threading;
+using TSP.DoxygenEditor.Includes;
+using TSP.DoxygenEditor.Symbols;
+
+namespace TSP.DoxygenEditor
+{
+    [TestClass]
+    public class TestIncludeFilesRefresher
+    {
+        private string _tempPath;
+        private readonly List<ISymbolTableId> _tableIds = new List<ISymbolTableId>();
+
+        [TestInitialize]
+        public void Setup()
+        {
+            _tempPath = Path.Combine(Path.GetTempPath(), "doxyedit_refresh_" + Guid.NewGuid().ToString("N"));
+            Directory.CreateDirectory(_tempPath);
+        }
+
+        [TestCleanup]
+        public void Cleanup()
+        {
+            foreach (ISymbolTableId id in _tableIds)
+                GlobalSymbolCache.Remove(id);
+            _tableIds.Clear();
+            if (Directory.Exists(_tempPath))
+                Directory.Delete(_tempPath, true);
+        }
+
+        private List<SymbolTable> Load(IEnumerable<string> files)
+        {
+            List<SymbolTable> result = null;
+            SourceIncludesLoader loader = new SourceIncludesLoader(files, null);
+            using (ManualResetEventSlim completed = new ManualResetEventSlim(false))
+            {
+                loader.IsCompleted = (s, tables) =>
+                {
+                    result = tables.ToList();
+                    completed.Set();
+                };
+                loader.Start();
+                Assert.IsTrue(completed.Wait(TimeSpan.FromSeconds(30)));
+            }
+            _tableIds.AddRange(result.Select(t => t.Id));
+            return (result);
+        }
+
+        [TestMethod]
+        public void ReplaceChangedTable()
+        {
+            string fileA = Path.Combine(_tempPath, "refresh_a.h");
+            string fileB = Path.Combine(_tempPath, "refresh_b.h");
+            File.WriteAllText(fileA, "struct RefreshOldStruct { int value; };\n");
+            File.WriteAllText(fileB, "struct RefreshOtherStruct { int value; };\n");
+            List<SymbolTable> tables = Load(new[] { fileA, fileB });
+            Assert.AreEqual(2, tables.Count);
+            ISymbolTableId idA = tables.First(t => string.Equals((string)t.Id.SymbolTableId, Path.GetFullPath(fileA))).Id;
+            SymbolTable oldTable = GlobalSymbolCache.GetTable(idA);
+            Assert.IsNotNull(oldTable);
+            Assert.IsNotNull(GlobalSymbolCache.FindSource("RefreshOldStruct"));
+
+            using (IncludeFilesRefresher refresher = new IncludeFilesRefresher(new[] { fileA, fileB }))
+            using (ManualResetEventSlim refreshed = new ManualResetEventSlim(false))
+            {
+                IncludeFilesRefresher.RefreshedEventArgs args = null;
+                refresher.QuietPeriod = TimeSpan.FromMilliseconds(50);
+                refresher.Refreshed += (s, e) =>
+                {
+                    args = e;
+                    refreshed.Set();
+                };
+
+                File.WriteAllText(fileA, "struct RefreshNewStruct { int value; };\n");
+                Assert.IsTrue(refreshed.Wait(TimeSpan.FromSeconds(30)));
+
+                CollectionAssert.AreEqual(new[] { Path.GetFullPath(fileA) }, args.ChangedFiles.ToArray());
+                Assert.AreEqual(0, args.RemovedFiles.Count);
+                CollectionAssert.Contains(args.AffectedNames.ToArray(), "RefreshOldStruct");
+                CollectionAssert.Contains(args.AffectedNames.ToArray(), "RefreshNewStruct");
+            }
+
+            // The table of the changed file is replaced, the other one is untouched
+            SymbolTable newTable = GlobalSymbolCache.GetTable(idA);
+            Assert.IsNotNull(newTable);
+            Assert.AreNotEqual(oldTable, newTable);
+            Assert.IsNull(GlobalSymbolCache.FindSource("RefreshOldStruct"));
+            Tuple<SourceSymbol, ISymbolTableId> newSource = GlobalSymbolCache.FindSource("RefreshNewStruct");
+            Assert.IsNotNull(newSource);
+            Assert.AreEqual(idA, newSource.Item2);
+            Assert.IsNotNull(GlobalSymbolCache.FindSource("RefreshOtherStruct"));
+        }
+
+        [TestMethod]
+        public void RetryLockedFile()
+        {
+            string fileA = Path.Combine(_tempPath, "locked_a.h");
+            File.WriteAllText(fileA, "struct LockedOldStruct { int value; };\n");
+            List<SymbolTable> tables = Load(new[] { fileA });
+            Assert.AreEqual(1, tables.Count);
+
+            using (IncludeFilesRefresher refresher = new IncludeFilesRefresher(new[] { fileA }))
+            using (ManualResetEventSlim refreshed = new ManualResetEventSlim(false))
+            {
+                IncludeFilesRefresher.RefreshedEventArgs args = null;
+                refresher.QuietPeriod = TimeSpan.FromMilliseconds(50);
+                refresher.Refreshed += (s, e) =>
+                {
+                    args = e;
+                    refreshed.Set();
+                };
+
+                // A file which can not be read while it is written is not removed, it is read again after it is released
+                using (FileStream stream = new FileStream(fileA, FileMode.Open, FileAccess.ReadWrite, FileShare.None))
+                {
+                    byte[] content = System.Text.Encoding.UTF8.GetBytes("struct LockedNewStruct { int value; };\n");
+                    stream.SetLength(0);
+                    stream.Write(content, 0, content.Length);
+                    stream.Flush();
+                    Assert.IsFalse(refreshed.Wait(TimeSpan.FromMilliseconds(500)));
+                    Assert.IsNotNull(GlobalSymbolCache.FindSource("LockedOldStruct"));
+                }
+                Assert.IsTrue(refreshed.Wait(TimeSpan.FromSeconds(30)));
+
+                CollectionAssert.AreEqual(new[] { Path.GetFullPath(fileA) }, args.ChangedFiles.ToArray());
+                Assert.AreEqual(0, args.RemovedFiles.Count);
+            }
+            Assert.IsNull(GlobalSymbolCache.FindSource("LockedOldStruct"));
+            Assert.IsNotNull(GlobalSymbolCache.FindSource("LockedNewStruct"));
+        }
+    }
+}
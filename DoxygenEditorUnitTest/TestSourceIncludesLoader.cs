@@ -0,0 +1,123 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Threading;
+using TSP.DoxygenEditor.Includes;
+using TSP.DoxygenEditor.Languages.Cpp;
+using TSP.DoxygenEditor.Symbols;
+
+namespace TSP.DoxygenEditor
+{
+    [TestClass]
+    public class TestSourceIncludesLoader
+    {
+        private string _tempPath;
+
+        [TestInitialize]
+        public void Setup()
+        {
+            _tempPath = Path.Combine(Path.GetTempPath(), "doxyedit_includes_" + Guid.NewGuid().ToString("N"));
+            Directory.CreateDirectory(_tempPath);
+        }
+
+        [TestCleanup]
+        public void Cleanup()
+        {
+            if (Directory.Exists(_tempPath))
+                Directory.Delete(_tempPath, true);
+        }
+
+        private string WriteFile(string name, string content)
+        {
+            string filePath = Path.Combine(_tempPath, name);
+            Directory.CreateDirectory(Path.GetDirectoryName(filePath));
+            File.WriteAllText(filePath, content);
+            return (Path.GetFullPath(filePath));
+        }
+
+        private static List<SymbolTable> LoadAll(SourceIncludesLoader loader)
+        {
+            List<SymbolTable> result = null;
+            using (ManualResetEventSlim completed = new ManualResetEventSlim(false))
+            {
+                loader.IsCompleted = (s, tables) =>
+                {
+                    result = tables.ToList();
+                    completed.Set();
+                };
+                loader.Start();
+                Assert.IsTrue(completed.Wait(TimeSpan.FromSeconds(30)));
+            }
+            Assert.IsTrue(loader.IsComplete);
+            return (result);
+        }
+
+        [TestMethod]
+        public void FollowIncludes()
+        {
+            string mainFile = WriteFile("main.h", "#include \"local.h\"\n#include <sys/system.h>\n#include CONFIG_H\n#include UNKNOWN_H\nint mainValue;\n");
+            string localFile = WriteFile("local.h", "#include \"main.h\"\nint localValue;\n");
+            string systemFile = WriteFile(Path.Combine("inc", "sys", "system.h"), "int systemValue;\n");
+            string configFile = WriteFile("config.h", "int configValue;\n");
+
+            SourceIncludesLoader loader = new SourceIncludesLoader(new[] { mainFile }, new[] { Path.Combine(_tempPath, "inc") });
+            loader.PublishToGlobalCache = false;
+            loader.Defines = CppPreprocessorDefines.Parse(new[] { "CONFIG_NAME=\"config.h\"", "CONFIG_H=CONFIG_NAME" });
+            List<SymbolTable> tables = LoadAll(loader);
+
+            Assert.AreEqual(4, tables.Count);
+            Assert.AreEqual(4, loader.TotalFileCount);
+            Assert.AreEqual(4, loader.ParseStage.ItemCount);
+            long totalBytes = new[] { mainFile, localFile, systemFile, configFile }.Sum(f => new FileInfo(f).Length);
+            Assert.AreEqual(totalBytes, loader.ReadStage.ByteCount);
+            Assert.AreEqual(totalBytes, loader.ParseStage.ByteCount);
+
+            IncludeGraph graph = loader.GetIncludeGraph();
+            CollectionAssert.AreEquivalent(new[] { localFile, systemFile, configFile }, graph.GetIncludes(mainFile).ToArray());
+            CollectionAssert.AreEqual(new[] { "UNKNOWN_H" }, graph.GetUnresolvedIncludes(mainFile).ToArray());
+            CollectionAssert.AreEqual(new[] { mainFile }, graph.GetIncludedBy(configFile).ToArray());
+            CollectionAssert.AreEqual(new[] { localFile }, graph.GetIncludedBy(mainFile).ToArray());
+        }
+
+        [TestMethod]
+        public void PauseAndResume()
+        {
+            // A long chain of includes, so the loader is still busy when it gets paused
+            const int fileCount = 400;
+            for (int i = 0; i < fileCount; ++i)
+            {
+                string include = i + 1 < fileCount ? $"#include \"file{i + 1}.h\"\n" : string.Empty;
+                WriteFile($"file{i}.h", $"{include}int value{i};\n");
+            }
+
+            SourceIncludesLoader loader = new SourceIncludesLoader(new[] { Path.Combine(_tempPath, "file0.h") }, null);
+            loader.PublishToGlobalCache = false;
+            List<SymbolTable> tables = null;
+            using (ManualResetEventSlim completed = new ManualResetEventSlim(false))
+            {
+                loader.IsCompleted = (s, t) =>
+                {
+                    tables = t.ToList();
+                    completed.Set();
+                };
+
+                // Resuming right away must not mix up the files of the paused run with the ones of the new run
+                loader.Start();
+                for (int i = 0; i < 3 && loader.IsRunning; ++i)
+                {
+                    loader.Pause();
+                    Assert.IsTrue(loader.IsPaused);
+                    loader.Start();
+                }
+                Assert.IsTrue(completed.Wait(TimeSpan.FromSeconds(60)));
+            }
+
+            Assert.IsTrue(loader.IsComplete);
+            Assert.AreEqual(fileCount, tables.Count);
+            Assert.AreEqual(fileCount, tables.Select(t => t.Id.SymbolTableId).Distinct().Count());
+            Assert.AreEqual(fileCount, loader.ParseStage.ItemCount);
+        }
+    }
+}
@@ -0,0 +1,100 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Threading;
+using TSP.DoxygenEditor.Includes;
+using TSP.DoxygenEditor.Symbols;
+
+namespace TSP.DoxygenEditor
+{
+    [TestClass]
+    public class TestSymbolPack
+    {
+        private string _tempPath;
+        private readonly List<ISymbolTableId> _tableIds = new List<ISymbolTableId>();
+
+        [TestInitialize]
+        public void Setup()
+        {
+            _tempPath = Path.Combine(Path.GetTempPath(), "doxyedit_pack_" + Guid.NewGuid().ToString("N"));
+            Directory.CreateDirectory(_tempPath);
+        }
+
+        [TestCleanup]
+        public void Cleanup()
+        {
+            foreach (ISymbolTableId id in _tableIds)
+                GlobalSymbolCache.Remove(id);
+            _tableIds.Clear();
+            if (Directory.Exists(_tempPath))
+                Directory.Delete(_tempPath, true);
+        }
+
+        private static List<string> Describe(SymbolTable table)
+        {
+            List<string> result = new List<string>();
+            foreach (SourceSymbol source in table.SourceMap.SelectMany(p => p.Value))
+                result.Add($"S|{source.Lang}|{source.Kind}|{source.Name}|{source.Caption}|{source.Range.Position.Index}|{source.Range.Position.Line}|{source.Range.Position.Column}|{source.Range.Length}");
+            foreach (ReferenceSymbol reference in table.ReferenceMap.SelectMany(p => p.Value))
+                result.Add($"R|{reference.Lang}|{reference.Kind}|{reference.Name}|{reference.Range.Position.Index}|{reference.Range.Position.Line}|{reference.Range.Position.Column}|{reference.Range.Length}");
+            result.Sort(StringComparer.Ordinal);
+            return (result);
+        }
+
+        [TestMethod]
+        public void WriteAndLoad()
+        {
+            string mainFile = Path.Combine(_tempPath, "pack_main.h");
+            string otherFile = Path.Combine(_tempPath, "pack_other.h");
+            File.WriteAllText(mainFile, "#include \"pack_other.h\"\n#define PACK_VALUE 42\ntypedef struct PackStruct { int value; } PackStruct;\nPackStruct *PackCreate(int value);\n");
+            File.WriteAllText(otherFile, "enum PackEnum { PackEnum_First, PackEnum_Second };\nvoid PackRelease(PackStruct *s) { PackCreate(PACK_VALUE); }\n");
+
+            List<SymbolTable> tables = null;
+            SourceIncludesLoader loader = new SourceIncludesLoader(new[] { mainFile }, null);
+            using (ManualResetEventSlim completed = new ManualResetEventSlim(false))
+            {
+                loader.IsCompleted = (s, t) =>
+                {
+                    tables = t.ToList();
+                    completed.Set();
+                };
+                loader.Start();
+                Assert.IsTrue(completed.Wait(TimeSpan.FromSeconds(30)));
+            }
+            _tableIds.AddRange(tables.Select(t => t.Id));
+            Assert.AreEqual(2, tables.Count);
+
+            string packFile = Path.Combine(_tempPath, "headers.dxsp");
+            SymbolPack.Write(packFile, tables.Select(t => GlobalSymbolCache.GetTable(t.Id)));
+
+            using (SymbolPack pack = SymbolPack.Open(packFile))
+            {
+                Assert.AreEqual(2, pack.FileCount);
+                List<SymbolTable> packTables = pack.ReadTables().ToList();
+                foreach (SymbolTable packTable in packTables)
+                {
+                    SymbolTable cacheTable = GlobalSymbolCache.GetTable(packTable.Id);
+                    Assert.IsNotNull(cacheTable);
+                    Assert.AreEqual(cacheTable.IsValid, packTable.IsValid);
+                    List<string> expected = Describe(cacheTable);
+                    Assert.IsTrue(expected.Count > 0);
+                    CollectionAssert.AreEqual(expected, Describe(packTable));
+                }
+            }
+        }
+
+        [TestMethod]
+        public void OpenInvalidFiles()
+        {
+            string emptyFile = Path.Combine(_tempPath, "empty.dxsp");
+            File.WriteAllBytes(emptyFile, new byte[0]);
+            Assert.ThrowsException<InvalidDataException>(() => SymbolPack.Open(emptyFile));
+
+            string textFile = Path.Combine(_tempPath, "text.dxsp");
+            File.WriteAllText(textFile, new string('x', 1024));
+            Assert.ThrowsException<InvalidDataException>(() => SymbolPack.Open(textFile));
+        }
+    }
+}
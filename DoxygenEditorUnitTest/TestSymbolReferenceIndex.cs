@@ -0,0 +1,137 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System.Collections.Generic;
+using System.Linq;
+using TSP.DoxygenEditor.Languages;
+using TSP.DoxygenEditor.Symbols;
+using TSP.DoxygenEditor.TextAnalysis;
+
+namespace TSP.DoxygenEditor
+{
+    [TestClass]
+    public class TestSymbolReferenceIndex
+    {
+        class SimpleSymbolTableId : ISymbolTableId
+        {
+            public object SymbolTableId { get; }
+
+            public SimpleSymbolTableId(object id)
+            {
+                SymbolTableId = id;
+            }
+        }
+
+        private static SymbolTable CreateTable(ISymbolTableId id, params string[] names)
+        {
+            SymbolTable result = new SymbolTable(id);
+            int index = 0;
+            foreach (string name in names)
+            {
+                result.AddReference(new ReferenceSymbol(LanguageKind.Cpp, ReferenceSymbolKind.CppFunction, name, new TextRange(new TextPosition(index), name.Length), null));
+                index += name.Length + 1;
+            }
+            return (result);
+        }
+
+        private static Dictionary<ISymbolTableId, int> FindReferences(SymbolReferenceIndex index, string name)
+        {
+            return (index.FindReferences(name).ToDictionary(p => p.Key, p => p.Value.Count));
+        }
+
+        [TestMethod]
+        public void AddTables()
+        {
+            SimpleSymbolTableId idA = new SimpleSymbolTableId(1);
+            SimpleSymbolTableId idB = new SimpleSymbolTableId(2);
+            SymbolReferenceIndex index = new SymbolReferenceIndex();
+            index.ReplaceTable(CreateTable(idA, "fplPlatformInit", "fplPlatformInit", "fplPlatformRelease"));
+            index.ReplaceTables(new[] { CreateTable(idB, "fplPlatformInit") });
+
+            Dictionary<ISymbolTableId, int> refs = FindReferences(index, "fplPlatformInit");
+            Assert.AreEqual(2, refs.Count);
+            Assert.AreEqual(2, refs[idA]);
+            Assert.AreEqual(1, refs[idB]);
+            Assert.AreEqual(3, index.GetReferenceCount("fplPlatformInit"));
+            Assert.AreEqual(1, index.GetReferenceCount("fplPlatformRelease"));
+            Assert.AreEqual(0, FindReferences(index, "fplMissing").Count);
+
+            // Table filter
+            CollectionAssert.AreEqual(new[] { idB }, index.FindReferences("fplPlatformInit", id => id == idB).Select(p => p.Key).ToArray());
+        }
+
+        [TestMethod]
+        public void ReplaceTable()
+        {
+            SimpleSymbolTableId idA = new SimpleSymbolTableId(1);
+            SimpleSymbolTableId idB = new SimpleSymbolTableId(2);
+            SymbolReferenceIndex index = new SymbolReferenceIndex();
+            index.ReplaceTable(CreateTable(idA, "fplPlatformInit", "fplPlatformRelease"));
+            index.ReplaceTable(CreateTable(idB, "fplPlatformInit"));
+
+            // Results which are streamed already are not affected by a replace
+            IEnumerable<KeyValuePair<ISymbolTableId, IReadOnlyList<ReferenceSymbol>>> stream = index.FindReferences("fplPlatformRelease");
+
+            index.ReplaceTable(CreateTable(idA, "fplGetAudioDevices"));
+            Assert.AreEqual(0, index.GetReferenceCount("fplPlatformRelease"));
+            Assert.AreEqual(1, index.GetReferenceCount("fplGetAudioDevices"));
+            Dictionary<ISymbolTableId, int> refs = FindReferences(index, "fplPlatformInit");
+            Assert.AreEqual(1, refs.Count);
+            Assert.AreEqual(1, refs[idB]);
+
+            List<KeyValuePair<ISymbolTableId, IReadOnlyList<ReferenceSymbol>>> streamed = stream.ToList();
+            Assert.AreEqual(1, streamed.Count);
+            Assert.AreSame(idA, streamed[0].Key);
+        }
+
+        [TestMethod]
+        public void ManyTables()
+        {
+            // Thousands of include tables which all reference the same names, published in batches like the include loader does
+            const int tableCount = 4000;
+            const int batchSize = 64;
+            string[] sharedNames = Enumerable.Range(0, 200).Select(i => $"shared{i}").ToArray();
+            SimpleSymbolTableId[] ids = Enumerable.Range(0, tableCount).Select(i => new SimpleSymbolTableId(i)).ToArray();
+            SymbolReferenceIndex index = new SymbolReferenceIndex();
+            List<SymbolTable> tables = ids.Select(id => CreateTable(id, sharedNames)).ToList();
+            for (int i = 0; i < tableCount; i += batchSize)
+                index.ReplaceTables(tables.Skip(i).Take(batchSize));
+            Assert.AreEqual(tableCount, index.GetReferenceCount("shared0"));
+            Assert.AreEqual(tableCount, index.GetReferenceCount("shared199"));
+
+            // Republishing and removing a single table keeps the other tables
+            index.ReplaceTable(CreateTable(ids[10], "shared0"));
+            Assert.AreEqual(tableCount, index.GetReferenceCount("shared0"));
+            Assert.AreEqual(tableCount - 1, index.GetReferenceCount("shared1"));
+            index.RemoveTable(ids[20]);
+            Assert.AreEqual(tableCount - 1, index.GetReferenceCount("shared0"));
+            Assert.AreEqual(tableCount - 1, FindReferences(index, "shared0").Count);
+        }
+
+        [TestMethod]
+        public void RemoveTable()
+        {
+            SimpleSymbolTableId idA = new SimpleSymbolTableId(1);
+            SimpleSymbolTableId idB = new SimpleSymbolTableId(2);
+            SymbolReferenceIndex index = new SymbolReferenceIndex();
+            index.ReplaceTables(new[] {
+                CreateTable(idA, "fplPlatformInit"),
+                CreateTable(idB, "fplPlatformInit", "fplPlatformRelease"),
+            });
+
+            index.RemoveTable(idB);
+            Dictionary<ISymbolTableId, int> refs = FindReferences(index, "fplPlatformInit");
+            Assert.AreEqual(1, refs.Count);
+            Assert.IsTrue(refs.ContainsKey(idA));
+            Assert.AreEqual(0, index.GetReferenceCount("fplPlatformRelease"));
+
+            // Removing an unknown table is fine
+            index.RemoveTable(idB);
+
+            index.RemoveTable(idA);
+            Assert.AreEqual(0, FindReferences(index, "fplPlatformInit").Count);
+
+            index.ReplaceTable(CreateTable(idA, "fplPlatformInit"));
+            index.Clear();
+            Assert.AreEqual(0, index.GetReferenceCount("fplPlatformInit"));
+        }
+    }
+}
@@ -0,0 +1,126 @@
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System.Collections.Generic;
+using System.Linq;
+using TSP.DoxygenEditor.Languages;
+using TSP.DoxygenEditor.Symbols;
+using TSP.DoxygenEditor.TextAnalysis;
+
+namespace TSP.DoxygenEditor
+{
+    [TestClass]
+    public class TestSymbolSearchIndex
+    {
+        class SimpleSymbolTableId : ISymbolTableId
+        {
+            public object SymbolTableId { get; }
+
+            public SimpleSymbolTableId(object id)
+            {
+                SymbolTableId = id;
+            }
+        }
+
+        private static SymbolTable CreateTable(ISymbolTableId id, SourceSymbolKind kind, params string[] names)
+        {
+            SymbolTable result = new SymbolTable(id);
+            int index = 0;
+            foreach (string name in names)
+            {
+                result.AddSource(new SourceSymbol(LanguageKind.Cpp, kind, name, new TextRange(new TextPosition(index), name.Length)));
+                index += name.Length + 1;
+            }
+            return (result);
+        }
+
+        private static List<string> Search(SymbolSearchIndex index, ISymbolTableId id, string text, int maxResults = 100)
+        {
+            return (index.Search(id, text, maxResults).Select(e => e.Symbol.Name).ToList());
+        }
+
+        [TestMethod]
+        public void SearchPrefix()
+        {
+            SimpleSymbolTableId id = new SimpleSymbolTableId(1);
+            SymbolSearchIndex index = new SymbolSearchIndex();
+            index.ReplaceTable(CreateTable(id, SourceSymbolKind.CppFunctionDefinition, "fplGetAudioDevices", "fplGetPlatformType", "getValue", "xy"));
+
+            CollectionAssert.AreEquivalent(new[] { "fplGetAudioDevices", "fplGetPlatformType" }, Search(index, id, "fp"));
+            CollectionAssert.AreEqual(new[] { "xy" }, Search(index, id, "x"));
+            Assert.AreEqual(0, Search(index, id, "zz").Count);
+        }
+
+        [TestMethod]
+        public void SearchTrigram()
+        {
+            SimpleSymbolTableId id = new SimpleSymbolTableId(1);
+            SymbolSearchIndex index = new SymbolSearchIndex();
+            index.ReplaceTable(CreateTable(id, SourceSymbolKind.CppFunctionDefinition, "fplGetAudioDevices", "fplGetPlatformType", "AudioBuffer"));
+
+            CollectionAssert.AreEquivalent(new[] { "fplGetAudioDevices", "AudioBuffer" }, Search(index, id, "audio"));
+            CollectionAssert.AreEqual(new[] { "fplGetPlatformType" }, Search(index, id, "formtype"));
+            Assert.AreEqual(0, Search(index, id, "audiox").Count);
+        }
+
+        [TestMethod]
+        public void SearchCamelHump()
+        {
+            SimpleSymbolTableId id = new SimpleSymbolTableId(1);
+            SymbolSearchIndex index = new SymbolSearchIndex();
+            index.ReplaceTable(CreateTable(id, SourceSymbolKind.CppClass, "GlobalSymbolCache", "GlobalSettings", "HTTPServer"));
+
+            CollectionAssert.AreEqual(new[] { "GlobalSymbolCache" }, Search(index, id, "GSC"));
+            CollectionAssert.AreEqual(new[] { "GlobalSymbolCache" }, Search(index, id, "GloSymCa"));
+            CollectionAssert.AreEqual(new[] { "HTTPServer" }, Search(index, id, "HTTPS"));
+        }
+
+        [TestMethod]
+        public void SearchRanking()
+        {
+            SimpleSymbolTableId id = new SimpleSymbolTableId(1);
+            SymbolSearchIndex index = new SymbolSearchIndex();
+            index.ReplaceTable(CreateTable(id, SourceSymbolKind.CppMember, "myvalue", "valueList", "value", "values", "ValidateLocalUniqueEntry"));
+
+            // Exact before prefix before camel hump before substring, shorter names first
+            CollectionAssert.AreEqual(new[] { "value", "values", "valueList", "myvalue" }, Search(index, id, "value"));
+            CollectionAssert.AreEqual(new[] { "ValidateLocalUniqueEntry" }, Search(index, id, "VLU"));
+
+            // Top-N keeps the best entries only
+            CollectionAssert.AreEqual(new[] { "value", "values" }, Search(index, id, "value", 2));
+
+            // Empty query returns the shortest names first
+            CollectionAssert.AreEqual(new[] { "value", "values", "myvalue" }, Search(index, id, "", 3));
+        }
+
+        [TestMethod]
+        public void RemoveAndReplaceTables()
+        {
+            SimpleSymbolTableId idA = new SimpleSymbolTableId(1);
+            SimpleSymbolTableId idB = new SimpleSymbolTableId(2);
+            SymbolSearchIndex index = new SymbolSearchIndex();
+            index.ReplaceTables(new[] {
+                CreateTable(idA, SourceSymbolKind.CppMacro, "FPL_ENABLE_AUDIO", "FPL_ENABLE_VIDEO"),
+                CreateTable(idB, SourceSymbolKind.DoxygenPage, "page_audio"),
+            });
+            Assert.AreEqual(3, index.Count);
+
+            // Search is scoped per table, a null id searches all of them
+            CollectionAssert.AreEqual(new[] { "FPL_ENABLE_AUDIO" }, Search(index, idA, "audio"));
+            CollectionAssert.AreEqual(new[] { "page_audio" }, Search(index, idB, "audio"));
+            CollectionAssert.AreEquivalent(new[] { "FPL_ENABLE_AUDIO", "page_audio" }, Search(index, null, "audio"));
+            CollectionAssert.AreEqual(new[] { SourceSymbolKind.CppMacro }, index.GetKinds(idA));
+
+            // Replace drops the old symbols of that table only
+            index.ReplaceTable(CreateTable(idA, SourceSymbolKind.CppStruct, "fplAudioSettings"));
+            CollectionAssert.AreEqual(new[] { "fplAudioSettings" }, Search(index, idA, "audio"));
+            CollectionAssert.AreEqual(new[] { "page_audio" }, Search(index, idB, "audio"));
+            CollectionAssert.AreEqual(new[] { SourceSymbolKind.CppStruct }, index.GetKinds(idA));
+            Assert.AreEqual(2, index.Count);
+
+            index.RemoveTable(idB);
+            Assert.AreEqual(0, Search(index, idB, "audio").Count);
+            Assert.AreEqual(0, index.GetKinds(idB).Count);
+            CollectionAssert.AreEqual(new[] { "fplAudioSettings" }, Search(index, null, "audio"));
+            Assert.AreEqual(1, index.Count);
+        }
+    }
+}
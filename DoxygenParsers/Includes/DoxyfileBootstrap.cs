@@ -0,0 +1,345 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Text;
+using System.Text.RegularExpressions;
+using System.Threading.Tasks;
+using TSP.DoxygenEditor.Languages.Doxygen;
+using TSP.DoxygenEditor.Parsers;
+
+namespace TSP.DoxygenEditor.Includes
+{
+    /// <summary>
+    /// Evaluates the input settings of a parsed Doxyfile (INPUT, FILE_PATTERNS, RECURSIVE, EXCLUDE, EXCLUDE_PATTERNS, INCLUDE_PATH),
+    /// so the <see cref="SourceIncludesLoader"/> sees exactly the source files doxygen will see.
+    /// Directories are enumerated level by level in parallel, all patterns of a setting are compiled into a single regex.
+    /// </summary>
+    public class DoxyfileBootstrap
+    {
+        // @NOTE(final): The C/C++ subset of the doxygen defaults, other languages are not parsed anyway
+        private static readonly string[] DefaultFilePatterns = new[] {
+            "*.c", "*.cc", "*.cxx", "*.cpp", "*.c++", "*.ii", "*.ixx", "*.ipp", "*.i++", "*.inl",
+            "*.h", "*.hh", "*.hxx", "*.hpp", "*.h++", "*.dox",
+        };
+
+        public string BaseDirectory { get; }
+        public IReadOnlyList<string> Inputs { get; }
+        public IReadOnlyList<string> FilePatterns { get; }
+        public bool IsRecursive { get; }
+        public IReadOnlyList<string> Excludes { get; }
+        public IReadOnlyList<string> ExcludePatterns { get; }
+        public IReadOnlyList<string> IncludePaths { get; }
+
+        /// <summary>
+        /// Identifies the input settings, see <see cref="GetSignature(IBaseNode, string)"/>.
+        /// </summary>
+        public string Signature { get; }
+
+        /// <summary>
+        /// Throughput of the directory enumeration, <see cref="PipelineStageCounter.ItemsPerSecond"/> are the discovered files per second.
+        /// </summary>
+        public PipelineStageCounter DiscoverStage { get; }
+
+        private readonly StringComparer _pathComparer;
+        private readonly Regex _fileRegex;
+        private readonly Regex _excludeRegex;
+        private readonly HashSet<string> _excludePaths;
+
+        public DoxyfileBootstrap(IBaseNode configTree, string baseDirectory)
+        {
+            if (configTree == null)
+                throw new ArgumentNullException("Config tree may not be null");
+            if (string.IsNullOrWhiteSpace(baseDirectory))
+                throw new ArgumentNullException("Base directory may not be null or empty");
+            BaseDirectory = Path.GetFullPath(baseDirectory);
+
+            Dictionary<string, List<string>> settings = ReadSettings(configTree);
+            Signature = GetSignature(settings, BaseDirectory);
+
+            List<string> inputs = GetSetting(settings, "INPUT").Select(p => ResolvePath(p)).ToList();
+            if (inputs.Count == 0)
+                inputs.Add(BaseDirectory);
+            Inputs = inputs;
+            List<string> filePatterns = GetSetting(settings, "FILE_PATTERNS");
+            FilePatterns = filePatterns.Count > 0 ? filePatterns : DefaultFilePatterns;
+            IsRecursive = "YES".Equals(GetSetting(settings, "RECURSIVE").FirstOrDefault(), StringComparison.OrdinalIgnoreCase);
+            Excludes = GetSetting(settings, "EXCLUDE").Select(p => ResolvePath(p)).ToList();
+            ExcludePatterns = GetSetting(settings, "EXCLUDE_PATTERNS");
+            IncludePaths = GetSetting(settings, "INCLUDE_PATH").Select(p => ResolvePath(p)).ToList();
+
+            bool ignoreCase = OperatingSystem.IsWindows();
+            _pathComparer = ignoreCase ? StringComparer.OrdinalIgnoreCase : StringComparer.Ordinal;
+            _excludePaths = new HashSet<string>(Excludes.Select(p => Path.TrimEndingDirectorySeparator(p)), _pathComparer);
+            _fileRegex = CompileGlobs(FilePatterns, ignoreCase);
+            _excludeRegex = ExcludePatterns.Count > 0 ? CompileGlobs(ExcludePatterns, ignoreCase) : null;
+
+            DiscoverStage = new PipelineStageCounter("Discover", Math.Max(1, Environment.ProcessorCount));
+        }
+
+        private static readonly string[] InputSettingNames = new[] { "INPUT", "FILE_PATTERNS", "RECURSIVE", "EXCLUDE", "EXCLUDE_PATTERNS", "INCLUDE_PATH" };
+
+        private static Dictionary<string, List<string>> ReadSettings(IBaseNode configTree)
+        {
+            Dictionary<string, List<string>> result = new Dictionary<string, List<string>>();
+            foreach (DoxygenConfigNode child in configTree.GetChildrenAs<DoxygenConfigNode>())
+            {
+                DoxygenConfigEntity entity = child.Entity;
+                if (Array.IndexOf(InputSettingNames, entity.Id) < 0)
+                    continue;
+                List<string> values;
+                if (entity.Kind == DoxygenConfigEntityKind.ConfigSet || !result.TryGetValue(entity.Id, out values))
+                {
+                    values = new List<string>();
+                    result[entity.Id] = values;
+                }
+                foreach (string setting in entity.Settings)
+                {
+                    string value = Unquote(setting);
+                    if (!string.IsNullOrWhiteSpace(value))
+                        values.Add(value);
+                }
+            }
+            return (result);
+        }
+
+        private static string GetSignature(Dictionary<string, List<string>> settings, string baseDirectory)
+        {
+            StringBuilder s = new StringBuilder(baseDirectory);
+            foreach (string name in InputSettingNames)
+            {
+                s.Append('|').Append(name).Append('=');
+                s.Append(string.Join(";", GetSetting(settings, name)));
+            }
+            return (s.ToString());
+        }
+
+        /// <summary>
+        /// Returns a string which identifies the input settings of the config tree, without compiling any patterns.
+        /// Two config trees with the same signature discover the same files, so a bootstrap is only created when the signature changes.
+        /// </summary>
+        public static string GetSignature(IBaseNode configTree, string baseDirectory)
+        {
+            if (configTree == null)
+                throw new ArgumentNullException("Config tree may not be null");
+            if (string.IsNullOrWhiteSpace(baseDirectory))
+                throw new ArgumentNullException("Base directory may not be null or empty");
+            return (GetSignature(ReadSettings(configTree), Path.GetFullPath(baseDirectory)));
+        }
+
+        private static List<string> GetSetting(Dictionary<string, List<string>> settings, string key)
+        {
+            List<string> result;
+            if (!settings.TryGetValue(key, out result))
+                result = new List<string>();
+            return (result);
+        }
+
+        private static string Unquote(string value)
+        {
+            if (value.Length >= 2 && value[0] == '"' && value[value.Length - 1] == '"')
+                return value.Substring(1, value.Length - 2);
+            return (value);
+        }
+
+        private string ResolvePath(string path)
+        {
+            string result = Path.IsPathRooted(path) ? path : Path.Combine(BaseDirectory, path);
+            return (Path.GetFullPath(result));
+        }
+
+        /// <summary>
+        /// Compiles a set of wildcard patterns (*, ? and [...]) into a single anchored regex.
+        /// </summary>
+        private static Regex CompileGlobs(IEnumerable<string> patterns, bool ignoreCase)
+        {
+            StringBuilder s = new StringBuilder();
+            s.Append("^(?:");
+            bool isFirst = true;
+            foreach (string pattern in patterns)
+            {
+                if (!isFirst)
+                    s.Append('|');
+                isFirst = false;
+                for (int i = 0; i < pattern.Length; ++i)
+                {
+                    char c = pattern[i];
+                    if (c == '*')
+                        s.Append(".*");
+                    else if (c == '?')
+                        s.Append('.');
+                    else if (c == '[')
+                    {
+                        int end = pattern.IndexOf(']', i + 1);
+                        if (end > i + 1)
+                        {
+                            string set = pattern.Substring(i + 1, end - i - 1);
+                            s.Append('[');
+                            if (set[0] == '!')
+                                s.Append('^').Append(set.Substring(1).Replace("\\", "\\\\"));
+                            else
+                                s.Append(set.Replace("\\", "\\\\"));
+                            s.Append(']');
+                            i = end;
+                        }
+                        else
+                            s.Append("\\[");
+                    }
+                    else if (c == '\\')
+                        s.Append('/');
+                    else
+                        s.Append(Regex.Escape(c.ToString()));
+                }
+            }
+            s.Append(")$");
+            RegexOptions options = RegexOptions.Compiled | RegexOptions.CultureInvariant | RegexOptions.Singleline;
+            if (ignoreCase)
+                options |= RegexOptions.IgnoreCase;
+            return new Regex(s.ToString(), options);
+        }
+
+        private bool IsExcluded(string fullPath)
+        {
+            if (_excludePaths.Contains(fullPath))
+                return (true);
+            // @NOTE(final): Doxygen matches the exclude patterns against the absolute path, always with forward slashes
+            if (_excludeRegex != null && _excludeRegex.IsMatch(fullPath.Replace('\\', '/')))
+                return (true);
+            return (false);
+        }
+
+        /// <summary>
+        /// Enumerates all input files which match the file patterns and are not excluded.
+        /// The result is sorted, so it does not depend on the order in which the workers finish.
+        /// </summary>
+        public IReadOnlyList<string> DiscoverFiles()
+        {
+            ConcurrentBag<string> files = new ConcurrentBag<string>();
+            List<DirectoryInfo> directories = new List<DirectoryInfo>();
+            ConcurrentDictionary<string, bool> visitedDirectories = new ConcurrentDictionary<string, bool>(_pathComparer);
+            DiscoverStage.Start();
+            foreach (string input in Inputs)
+            {
+                if (IsExcluded(input))
+                    continue;
+                if (File.Exists(input))
+                {
+                    // Explicit input files are taken as they are, without matching the file patterns
+                    files.Add(input);
+                    DiscoverStage.AddItem(0, 0);
+                }
+                else if (Directory.Exists(input))
+                {
+                    DirectoryInfo directory = new DirectoryInfo(input);
+                    if (TryVisitDirectory(directory, visitedDirectories))
+                        directories.Add(directory);
+                }
+                else
+                    Debug.WriteLine($"Doxyfile input '{input}' does not exist");
+            }
+            while (directories.Count > 0)
+            {
+                ConcurrentBag<DirectoryInfo> subDirectories = new ConcurrentBag<DirectoryInfo>();
+                Parallel.ForEach(directories, (directory) => DiscoverDirectory(directory, files, subDirectories, visitedDirectories));
+                directories = subDirectories.ToList();
+            }
+            DiscoverStage.Stop();
+            List<string> result = files.Distinct(_pathComparer).ToList();
+            result.Sort(_pathComparer);
+            return (result);
+        }
+
+        /// <summary>
+        /// Returns true when the directory was not visited before. Linked directories are identified by their final target,
+        /// so a link to a parent directory does not recurse forever and a directory reached twice is enumerated only once.
+        /// </summary>
+        private static bool TryVisitDirectory(DirectoryInfo directory, ConcurrentDictionary<string, bool> visitedDirectories)
+        {
+            string realPath = directory.FullName;
+            if (directory.LinkTarget != null)
+            {
+                try
+                {
+                    FileSystemInfo target = directory.ResolveLinkTarget(true);
+                    if (target == null || !target.Exists)
+                        return (false);
+                    realPath = target.FullName;
+                }
+                catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+                {
+                    Debug.WriteLine($"Failed resolving directory link '{directory.FullName}': {e.Message}");
+                    return (false);
+                }
+            }
+            return (visitedDirectories.TryAdd(Path.TrimEndingDirectorySeparator(realPath), true));
+        }
+
+        /// <summary>
+        /// Returns false for a dangling link or a file which was deleted while enumerating, so only that entry is skipped and not the rest of its directory.
+        /// Linked files report the length of their final target.
+        /// </summary>
+        private static bool TryGetFileLength(FileInfo file, out long length)
+        {
+            length = 0;
+            try
+            {
+                if (file.LinkTarget != null)
+                {
+                    FileInfo target = file.ResolveLinkTarget(true) as FileInfo;
+                    if (target == null || !target.Exists)
+                        return (false);
+                    file = target;
+                }
+                length = file.Length;
+                return (true);
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+            {
+                Debug.WriteLine($"Failed reading file '{file.FullName}': {e.Message}");
+                return (false);
+            }
+        }
+
+        private void DiscoverDirectory(DirectoryInfo directory, ConcurrentBag<string> files, ConcurrentBag<DirectoryInfo> subDirectories, ConcurrentDictionary<string, bool> visitedDirectories)
+        {
+            long startTimestamp = Stopwatch.GetTimestamp();
+            try
+            {
+                foreach (FileSystemInfo entry in directory.EnumerateFileSystemInfos())
+                {
+                    if (entry is DirectoryInfo subDirectory)
+                    {
+                        if (IsRecursive && !IsExcluded(subDirectory.FullName) && TryVisitDirectory(subDirectory, visitedDirectories))
+                            subDirectories.Add(subDirectory);
+                    }
+                    else if (_fileRegex.IsMatch(entry.Name) && !IsExcluded(entry.FullName))
+                    {
+                        long length;
+                        if (TryGetFileLength((FileInfo)entry, out length))
+                        {
+                            files.Add(entry.FullName);
+                            DiscoverStage.AddItem(length, 0);
+                        }
+                    }
+                }
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+            {
+                Debug.WriteLine($"Failed enumerating directory '{directory.FullName}': {e.Message}");
+            }
+            DiscoverStage.AddBusy(Stopwatch.GetTimestamp() - startTimestamp);
+        }
+
+        /// <summary>
+        /// Discovers the input files and creates a loader for them, which resolves includes using the INCLUDE_PATH setting.
+        /// </summary>
+        public SourceIncludesLoader CreateLoader()
+        {
+            IReadOnlyList<string> files = DiscoverFiles();
+            SourceIncludesLoader result = new SourceIncludesLoader(files, IncludePaths);
+            return (result);
+        }
+    }
+}
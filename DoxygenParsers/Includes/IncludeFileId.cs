@@ -0,0 +1,27 @@
+﻿using TSP.DoxygenEditor.Symbols;
+
+namespace TSP.DoxygenEditor.Includes
+{
+    internal class IncludeFileId : ISymbolTableId
+    {
+        private readonly string _filename;
+        public object SymbolTableId => _filename;
+        public IncludeFileId(string filename)
+        {
+            _filename = filename;
+        }
+        public override bool Equals(object obj)
+        {
+            IncludeFileId other = obj as IncludeFileId;
+            return (other != null && string.Equals(_filename, other._filename));
+        }
+        public override int GetHashCode()
+        {
+            return (_filename.GetHashCode());
+        }
+        public override string ToString()
+        {
+            return (_filename);
+        }
+    }
+}
@@ -0,0 +1,260 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Threading;
+using System.Threading.Tasks;
+using TSP.DoxygenEditor.Languages.Cpp;
+using TSP.DoxygenEditor.Symbols;
+using TSP.DoxygenEditor.TextAnalysis;
+
+namespace TSP.DoxygenEditor.Includes
+{
+    /// <summary>
+    /// Watches loaded include files for changes on disk and reparses only the modified files.
+    /// Change notifications are collected until the file system is quiet for <see cref="QuietPeriod"/> (or <see cref="MaxDelay"/> is reached),
+    /// so a branch switch touching hundreds of headers results in a single batch.
+    /// </summary>
+    public class IncludeFilesRefresher : IDisposable
+    {
+        public class RefreshedEventArgs : EventArgs
+        {
+            public IReadOnlyList<string> ChangedFiles { get; }
+            public IReadOnlyList<string> RemovedFiles { get; }
+            public IReadOnlyCollection<string> AffectedNames { get; }
+            public IEnumerable<KeyValuePair<ISymbolTableId, TextError>> Errors { get; }
+            public RefreshedEventArgs(IReadOnlyList<string> changedFiles, IReadOnlyList<string> removedFiles, IReadOnlyCollection<string> affectedNames, IEnumerable<KeyValuePair<ISymbolTableId, TextError>> errors)
+            {
+                ChangedFiles = changedFiles;
+                RemovedFiles = removedFiles;
+                AffectedNames = affectedNames;
+                Errors = errors;
+            }
+        }
+
+        public delegate void RefreshedEventHandler(object sender, RefreshedEventArgs e);
+        public event RefreshedEventHandler Refreshed;
+
+        public TimeSpan QuietPeriod { get; set; } = TimeSpan.FromMilliseconds(300);
+        public TimeSpan MaxDelay { get; set; } = TimeSpan.FromSeconds(2);
+        public GlobalSymbolCache.ValidationConfigration ValidationConfig { get; set; } = new GlobalSymbolCache.ValidationConfigration();
+        public CppPreprocessorDefines Defines { get; set; } = null;
+
+        private readonly HashSet<string> _files;
+        private readonly List<FileSystemWatcher> _watchers = new List<FileSystemWatcher>();
+        private readonly ConcurrentDictionary<string, bool> _changedFiles;
+        private readonly Timer _debounceTimer;
+        private readonly SynchronizationContext _syncContext;
+        private readonly object _burstLock = new object();
+        private long _burstStartTimestamp = 0;
+        private int _isRefreshing = 0;
+
+        public IncludeFilesRefresher(IEnumerable<string> files)
+        {
+            if (files == null)
+                throw new ArgumentNullException("Files may not be null");
+            StringComparison pathComparison = OperatingSystem.IsWindows() ? StringComparison.OrdinalIgnoreCase : StringComparison.Ordinal;
+            StringComparer pathComparer = StringComparer.FromComparison(pathComparison);
+            _files = new HashSet<string>(files.Select(f => Path.GetFullPath(f)), pathComparer);
+            _changedFiles = new ConcurrentDictionary<string, bool>(pathComparer);
+            _syncContext = SynchronizationContext.Current;
+            _debounceTimer = new Timer((state) => Refresh(), null, Timeout.Infinite, Timeout.Infinite);
+
+            IEnumerable<string> directories = _files.Select(f => Path.GetDirectoryName(f)).Distinct(pathComparer);
+            foreach (string directory in directories)
+            {
+                if (!Directory.Exists(directory))
+                    continue;
+                FileSystemWatcher watcher = new FileSystemWatcher(directory)
+                {
+                    NotifyFilter = NotifyFilters.LastWrite | NotifyFilters.FileName | NotifyFilters.Size,
+                    IncludeSubdirectories = false,
+                    InternalBufferSize = 64 * 1024,
+                };
+                watcher.Changed += (s, e) => FileChanged(e.FullPath);
+                watcher.Created += (s, e) => FileChanged(e.FullPath);
+                watcher.Deleted += (s, e) => FileChanged(e.FullPath);
+                watcher.Renamed += (s, e) =>
+                {
+                    FileChanged(e.OldFullPath);
+                    FileChanged(e.FullPath);
+                };
+                watcher.Error += (s, e) =>
+                {
+                    // @NOTE(final): The internal buffer overflowed, so we dont know what changed - refresh every file in that directory
+                    foreach (string filePath in _files)
+                    {
+                        if (string.Equals(Path.GetDirectoryName(filePath), directory, pathComparison))
+                            FileChanged(filePath);
+                    }
+                };
+                watcher.EnableRaisingEvents = true;
+                _watchers.Add(watcher);
+            }
+        }
+
+        private void FileChanged(string filePath)
+        {
+            if (!_files.Contains(filePath))
+                return;
+            _changedFiles[filePath] = true;
+            long now = Stopwatch.GetTimestamp();
+            lock (_burstLock)
+            {
+                if (_burstStartTimestamp == 0)
+                    _burstStartTimestamp = now;
+                double burstSeconds = (now - _burstStartTimestamp) / (double)Stopwatch.Frequency;
+                if (burstSeconds >= MaxDelay.TotalSeconds)
+                    _debounceTimer.Change(0, Timeout.Infinite);
+                else
+                    _debounceTimer.Change((int)QuietPeriod.TotalMilliseconds, Timeout.Infinite);
+            }
+        }
+
+        private void Refresh()
+        {
+            // Only one refresh at a time, changes arriving meanwhile are picked up by the next burst
+            if (Interlocked.CompareExchange(ref _isRefreshing, 1, 0) != 0)
+            {
+                _debounceTimer.Change((int)QuietPeriod.TotalMilliseconds, Timeout.Infinite);
+                return;
+            }
+            try
+            {
+                lock (_burstLock)
+                    _burstStartTimestamp = 0;
+
+                List<string> filePaths = new List<string>();
+                foreach (string filePath in _changedFiles.Keys)
+                {
+                    if (_changedFiles.TryRemove(filePath, out _))
+                        filePaths.Add(filePath);
+                }
+                if (filePaths.Count == 0)
+                    return;
+
+                List<string> removedFiles = new List<string>();
+                List<string> changedFiles = new List<string>();
+                ConcurrentBag<string> retryFiles = new ConcurrentBag<string>();
+                ConcurrentBag<SymbolTable> tables = new ConcurrentBag<SymbolTable>();
+                Parallel.ForEach(filePaths, (filePath) =>
+                {
+                    string source = null;
+                    bool isRemoved = false;
+                    try
+                    {
+                        source = File.ReadAllText(filePath);
+                    }
+                    catch (Exception e) when (e is FileNotFoundException || e is DirectoryNotFoundException)
+                    {
+                        isRemoved = true;
+                    }
+                    catch (Exception e)
+                    {
+                        // @NOTE(final): The file may still be written (sharing violation while a checkout is running), so it is read again later instead of dropping its symbols
+                        Debug.WriteLine($"Failed reading include file '{filePath}': {e.Message}");
+                        if (File.Exists(filePath))
+                            retryFiles.Add(filePath);
+                        else
+                            isRemoved = true;
+                    }
+                    if (source != null)
+                        tables.Add(SourceIncludesLoader.ParseSource(filePath, source, Defines));
+                    else if (isRemoved)
+                    {
+                        lock (removedFiles)
+                            removedFiles.Add(filePath);
+                    }
+                });
+
+                // Files which could not be read are refreshed with the next burst, no further change event may arrive for them
+                if (retryFiles.Count > 0)
+                {
+                    foreach (string filePath in retryFiles)
+                        _changedFiles[filePath] = true;
+                    _debounceTimer.Change((int)QuietPeriod.TotalMilliseconds, Timeout.Infinite);
+                }
+                if (removedFiles.Count == 0 && tables.Count == 0)
+                    return;
+
+                // Names whose existence may have changed: sources added or removed, plus everything the changed files reference
+                HashSet<string> affectedNames = new HashSet<string>();
+                foreach (string filePath in removedFiles)
+                {
+                    IncludeFileId id = new IncludeFileId(filePath);
+                    SymbolTable oldTable = GlobalSymbolCache.GetTable(id);
+                    if (oldTable != null)
+                    {
+                        foreach (KeyValuePair<string, List<SourceSymbol>> sourcePair in oldTable.SourceMap)
+                            affectedNames.Add(sourcePair.Key);
+                    }
+                    GlobalSymbolCache.Remove(id);
+                }
+                foreach (SymbolTable table in tables)
+                {
+                    HashSet<string> oldNames = new HashSet<string>();
+                    SymbolTable oldTable = GlobalSymbolCache.GetTable(table.Id);
+                    if (oldTable != null)
+                    {
+                        foreach (KeyValuePair<string, List<SourceSymbol>> sourcePair in oldTable.SourceMap)
+                            oldNames.Add(sourcePair.Key);
+                    }
+                    foreach (KeyValuePair<string, List<SourceSymbol>> sourcePair in table.SourceMap)
+                    {
+                        if (!oldNames.Remove(sourcePair.Key))
+                            affectedNames.Add(sourcePair.Key);
+                    }
+                    affectedNames.UnionWith(oldNames);
+                    foreach (KeyValuePair<string, List<ReferenceSymbol>> referencePair in table.ReferenceMap)
+                        affectedNames.Add(referencePair.Key);
+                    changedFiles.Add((string)table.Id.SymbolTableId);
+                }
+                GlobalSymbolCache.AddOrReplaceTables(tables);
+
+                IEnumerable<KeyValuePair<ISymbolTableId, TextError>> errors = GlobalSymbolCache.ValidateNames(ValidationConfig, affectedNames);
+                RefreshedEventArgs args = new RefreshedEventArgs(changedFiles, removedFiles, affectedNames, errors);
+                if (_syncContext != null)
+                    _syncContext.Post((state) => Refreshed?.Invoke(this, args), null);
+                else
+                    Refreshed?.Invoke(this, args);
+            }
+            finally
+            {
+                Interlocked.Exchange(ref _isRefreshing, 0);
+            }
+        }
+
+        #region IDisposable Support
+        protected virtual void DisposeManaged()
+        {
+            foreach (FileSystemWatcher watcher in _watchers)
+            {
+                watcher.EnableRaisingEvents = false;
+                watcher.Dispose();
+            }
+            _watchers.Clear();
+            _debounceTimer.Dispose();
+        }
+        protected virtual void DisposeUnmanaged()
+        {
+        }
+        private void Dispose(bool disposing)
+        {
+            if (disposing)
+                DisposeManaged();
+            DisposeUnmanaged();
+        }
+        public void Dispose()
+        {
+            Dispose(true);
+            GC.SuppressFinalize(this);
+        }
+        ~IncludeFilesRefresher()
+        {
+            Dispose(false);
+        }
+        #endregion
+    }
+}
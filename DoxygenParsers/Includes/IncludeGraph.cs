@@ -0,0 +1,71 @@
+﻿using System.Collections.Generic;
+
+namespace TSP.DoxygenEditor.Includes
+{
+    /// <summary>
+    /// Snapshot of the include relations discovered by the <see cref="SourceIncludesLoader"/>.
+    /// All file paths are canonical full paths.
+    /// </summary>
+    public class IncludeGraph
+    {
+        private static readonly IReadOnlyList<string> _empty = new string[0];
+
+        private readonly Dictionary<string, IReadOnlyList<string>> _includes;
+        private readonly Dictionary<string, List<string>> _includedBy;
+        private readonly Dictionary<string, IReadOnlyList<string>> _unresolved;
+
+        public IEnumerable<string> Files => _includes.Keys;
+        public int FileCount => _includes.Count;
+
+        public IncludeGraph(IEqualityComparer<string> pathComparer)
+        {
+            _includes = new Dictionary<string, IReadOnlyList<string>>(pathComparer);
+            _includedBy = new Dictionary<string, List<string>>(pathComparer);
+            _unresolved = new Dictionary<string, IReadOnlyList<string>>(pathComparer);
+        }
+
+        internal void AddFile(string filePath, IReadOnlyList<string> includes, IReadOnlyList<string> unresolved)
+        {
+            _includes[filePath] = includes ?? _empty;
+            if (unresolved != null && unresolved.Count > 0)
+                _unresolved[filePath] = unresolved;
+            if (includes != null)
+            {
+                foreach (string include in includes)
+                {
+                    List<string> list;
+                    if (!_includedBy.TryGetValue(include, out list))
+                    {
+                        list = new List<string>();
+                        _includedBy.Add(include, list);
+                    }
+                    list.Add(filePath);
+                }
+            }
+        }
+
+        public IReadOnlyList<string> GetIncludes(string filePath)
+        {
+            IReadOnlyList<string> result;
+            if (_includes.TryGetValue(filePath, out result))
+                return (result);
+            return (_empty);
+        }
+
+        public IReadOnlyList<string> GetIncludedBy(string filePath)
+        {
+            List<string> result;
+            if (_includedBy.TryGetValue(filePath, out result))
+                return (result);
+            return (_empty);
+        }
+
+        public IReadOnlyList<string> GetUnresolvedIncludes(string filePath)
+        {
+            IReadOnlyList<string> result;
+            if (_unresolved.TryGetValue(filePath, out result))
+                return (result);
+            return (_empty);
+        }
+    }
+}
@@ -0,0 +1,111 @@
+﻿using System;
+using System.Diagnostics;
+using System.Threading;
+
+namespace TSP.DoxygenEditor.Includes
+{
+    /// <summary>
+    /// Thread-safe throughput counters for a single stage of the <see cref="SourceIncludesLoader"/> pipeline.
+    /// </summary>
+    public class PipelineStageCounter
+    {
+        public string Name { get; }
+        public int WorkerCount { get; }
+
+        private long _itemCount = 0;
+        private long _byteCount = 0;
+        private long _busyTicks = 0;
+        private long _blockedTicks = 0;
+        private long _startTimestamp = 0;
+        private long _stopTimestamp = 0;
+
+        public long ItemCount => Interlocked.Read(ref _itemCount);
+        public long ByteCount => Interlocked.Read(ref _byteCount);
+
+        /// <summary>
+        /// Summed time all workers of this stage spent doing actual work.
+        /// </summary>
+        public TimeSpan BusyTime => TicksToTimeSpan(Interlocked.Read(ref _busyTicks));
+
+        /// <summary>
+        /// Summed time all workers of this stage waited for the next stage to accept an item (backpressure).
+        /// </summary>
+        public TimeSpan BlockedTime => TicksToTimeSpan(Interlocked.Read(ref _blockedTicks));
+
+        public TimeSpan Elapsed
+        {
+            get
+            {
+                long start = Interlocked.Read(ref _startTimestamp);
+                if (start == 0)
+                    return (TimeSpan.Zero);
+                long stop = Interlocked.Read(ref _stopTimestamp);
+                if (stop == 0)
+                    stop = Stopwatch.GetTimestamp();
+                return (TicksToTimeSpan(stop - start));
+            }
+        }
+
+        public double ItemsPerSecond
+        {
+            get
+            {
+                double seconds = Elapsed.TotalSeconds;
+                return (seconds > 0 ? ItemCount / seconds : 0.0);
+            }
+        }
+
+        public double BytesPerSecond
+        {
+            get
+            {
+                double seconds = Elapsed.TotalSeconds;
+                return (seconds > 0 ? ByteCount / seconds : 0.0);
+            }
+        }
+
+        public PipelineStageCounter(string name, int workerCount)
+        {
+            Name = name;
+            WorkerCount = workerCount;
+        }
+
+        internal void Start()
+        {
+            Interlocked.CompareExchange(ref _startTimestamp, Stopwatch.GetTimestamp(), 0);
+            Interlocked.Exchange(ref _stopTimestamp, 0);
+        }
+
+        internal void Stop()
+        {
+            Interlocked.Exchange(ref _stopTimestamp, Stopwatch.GetTimestamp());
+        }
+
+        internal void AddItem(long byteCount, long busyTicks)
+        {
+            Interlocked.Increment(ref _itemCount);
+            Interlocked.Add(ref _byteCount, byteCount);
+            Interlocked.Add(ref _busyTicks, busyTicks);
+        }
+
+        internal void AddBusy(long busyTicks)
+        {
+            Interlocked.Add(ref _busyTicks, busyTicks);
+        }
+
+        internal void AddBlocked(long blockedTicks)
+        {
+            Interlocked.Add(ref _blockedTicks, blockedTicks);
+        }
+
+        private static TimeSpan TicksToTimeSpan(long stopwatchTicks)
+        {
+            return (TimeSpan.FromSeconds(stopwatchTicks / (double)Stopwatch.Frequency));
+        }
+
+        public override string ToString()
+        {
+            return $"{Name} [{WorkerCount} workers]: {ItemCount} items, {ItemsPerSecond:F1} items/s, busy {BusyTime.TotalMilliseconds:F0} ms, blocked {BlockedTime.TotalMilliseconds:F0} ms";
+        }
+    }
+}
@@ -3,15 +3,22 @@ using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.Diagnostics;
 using System.IO;
-using System.Linq;
+using System.Text;
 using System.Threading;
+using System.Threading.Channels;
 using System.Threading.Tasks;
 using TSP.DoxygenEditor.Languages.Cpp;
+using TSP.DoxygenEditor.Languages.Utils;
 using TSP.DoxygenEditor.Symbols;
 using TSP.DoxygenEditor.TextAnalysis;
 
 namespace TSP.DoxygenEditor.Includes
 {
+    /// <summary>
+    /// Loads and parses a set of source files and follows their #include directives recursively.
+    /// Files flow through two stages connected by channels: an async read stage and a CPU bound lex+parse stage sized to the core count.
+    /// The channel between the stages is bounded, so readers wait when the parsers fall behind and the amount of loaded source text stays limited.
+    /// </summary>
     public class SourceIncludesLoader
     {
         enum State : int
@@ -22,21 +29,82 @@ namespace TSP.DoxygenEditor.Includes
             Complete,
         }
 
+        class IncludeFile
+        {
+            public string FilePath { get; }
+            public List<string> Includes { get; } = new List<string>();
+            public List<string> UnresolvedIncludes { get; } = new List<string>();
+            public IncludeFile(string filePath)
+            {
+                FilePath = filePath;
+            }
+        }
+
         private volatile State _state;
 
-        private readonly ConcurrentQueue<string> _queue = new ConcurrentQueue<string>();
-        private readonly ConcurrentDictionary<Task, Task<List<SymbolTable>>> _tasks = new ConcurrentDictionary<Task, Task<List<SymbolTable>>>();
+        private readonly ConcurrentDictionary<string, IncludeFile> _files;
+        private readonly ConcurrentQueue<string> _pendingQueue = new ConcurrentQueue<string>();
         private readonly ConcurrentBag<SymbolTable> _tables = new ConcurrentBag<SymbolTable>();
+        private readonly IEqualityComparer<string> _pathComparer;
+        private readonly string[] _includePaths;
 
         public bool IsPaused => _state == State.Paused;
         public bool IsStopped => _state == State.Stopped;
         public bool IsRunning => _state == State.Running;
         public bool IsComplete => _state == State.Complete;
 
-        private readonly int _totalFileCount;
-        private readonly int _maxTaskCount;
+        public int TotalFileCount => _files.Count;
+
         private volatile int _progressFileCount = 0;
-        private volatile int _runningTaskCount = 0;
+
+        private const int ReadWorkerCount = 4;
+        private readonly int _parseWorkerCount;
+
+        /// <summary>
+        /// Channels, counter and cancellation of one Start() call. Workers only ever see the run they were started for.
+        /// A paused run parks its remaining files into the pending queue and the next run takes them over once it is drained.
+        /// </summary>
+        class LoaderRun
+        {
+            public readonly Channel<string> Paths;
+            public readonly Channel<SourceFile> Sources;
+            public readonly CancellationTokenSource Cancellation = new CancellationTokenSource();
+            public readonly TaskCompletionSource<bool> Drained = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+            public int ScheduledCount = 0;
+            public volatile bool IsDiscarded = false;
+
+            public LoaderRun(int sourceCapacity)
+            {
+                // Paths are tiny, so that channel is unbounded. The loaded sources are not, so that one is bounded
+                Paths = Channel.CreateUnbounded<string>(new UnboundedChannelOptions() { SingleReader = false, SingleWriter = false });
+                Sources = Channel.CreateBounded<SourceFile>(new BoundedChannelOptions(sourceCapacity) { FullMode = BoundedChannelFullMode.Wait });
+            }
+        }
+
+        private volatile LoaderRun _run = null;
+
+        public PipelineStageCounter ReadStage { get; }
+        public PipelineStageCounter ParseStage { get; }
+
+        /// <summary>
+        /// When enabled, finished tables are published into the <see cref="GlobalSymbolCache"/> in batches while loading is still in progress.
+        /// </summary>
+        public bool PublishToGlobalCache { get; set; } = true;
+        public int PublishBatchSize { get; set; } = 64;
+        public TimeSpan PublishInterval { get; set; } = TimeSpan.FromMilliseconds(250);
+        public TimeSpan ProgressInterval { get; set; } = TimeSpan.FromMilliseconds(100);
+
+        /// <summary>
+        /// Defines used to evaluate #if branches, inactive branches are skipped and their includes are not followed.
+        /// When null, all branches are parsed.
+        /// </summary>
+        public CppPreprocessorDefines Defines { get; set; } = null;
+
+        private readonly ConcurrentQueue<SymbolTable> _publishQueue = new ConcurrentQueue<SymbolTable>();
+        private int _isPublishing = 0;
+        private long _lastPublishTimestamp = 0;
+        private long _lastProgressTimestamp = 0;
+        private SynchronizationContext _syncContext = null;
 
         public delegate void IsCompletedEventHandler(object sender, IEnumerable<SymbolTable> tables);
         public IsCompletedEventHandler IsCompleted;
@@ -55,109 +123,117 @@ namespace TSP.DoxygenEditor.Includes
         public delegate void ProgressChangedEventHandler(object sender, ProgressChangedEventArgs e);
         public event ProgressChangedEventHandler ProgressChanged;
 
-        class IncludeFileId : ISymbolTableId
+        public delegate void TablesPublishedEventHandler(object sender, IEnumerable<SymbolTable> tables);
+        public event TablesPublishedEventHandler TablesPublished;
+
+        class SourceFile
         {
-            private readonly string _filename;
-            public object SymbolTableId => _filename;
-            public IncludeFileId(string filename)
+            public string FilePath { get; }
+            public string Source { get; }
+            public long ByteCount { get; }
+            public SourceFile(string filePath, string source, long byteCount)
             {
-                _filename = filename;
+                FilePath = filePath;
+                Source = source;
+                ByteCount = byteCount;
             }
         }
 
-        public SourceIncludesLoader(IEnumerable<string> files, int maxTaskCount)
+        public SourceIncludesLoader(IEnumerable<string> files, IEnumerable<string> includePaths)
         {
+            if (files == null)
+                throw new ArgumentNullException("Files may not be null");
             _state = State.Stopped;
-            _totalFileCount = files.Count();
             _progressFileCount = 0;
-            _maxTaskCount = maxTaskCount;
+            _pathComparer = OperatingSystem.IsWindows() ? StringComparer.OrdinalIgnoreCase : StringComparer.Ordinal;
+            _files = new ConcurrentDictionary<string, IncludeFile>(_pathComparer);
+            List<string> paths = new List<string>();
+            if (includePaths != null)
+            {
+                foreach (string includePath in includePaths)
+                {
+                    if (!string.IsNullOrWhiteSpace(includePath))
+                        paths.Add(Path.GetFullPath(includePath));
+                }
+            }
+            _includePaths = paths.ToArray();
+            _parseWorkerCount = Math.Max(1, Environment.ProcessorCount);
+            ReadStage = new PipelineStageCounter("Read", ReadWorkerCount);
+            ParseStage = new PipelineStageCounter("Lex+Parse", _parseWorkerCount);
             foreach (string file in files)
-                _queue.Enqueue(file);
+            {
+                string filePath = Path.GetFullPath(file);
+                if (_files.TryAdd(filePath, new IncludeFile(filePath)))
+                    _pendingQueue.Enqueue(filePath);
+            }
+        }
+
+        public IncludeGraph GetIncludeGraph()
+        {
+            IncludeGraph result = new IncludeGraph(_pathComparer);
+            foreach (KeyValuePair<string, IncludeFile> filePair in _files)
+            {
+                IncludeFile file = filePair.Value;
+                lock (file)
+                    result.AddFile(file.FilePath, file.Includes.ToArray(), file.UnresolvedIncludes.ToArray());
+            }
+            return (result);
         }
 
         public void Start()
         {
             Debug.Assert(_state == State.Stopped || _state == State.Paused);
-            Debug.Assert(_maxTaskCount > 0);
-            Debug.Assert(_tasks.Count == 0);
             _state = State.Running;
-            _runningTaskCount = 0;
-            _progressFileCount = 0;
-            ProgressChanged?.Invoke(this, new ProgressChangedEventArgs(0, _totalFileCount));
-            for (int i = 0; i < _maxTaskCount; ++i)
+
+            // Events are raised on the context of the caller (e.g. the UI thread), when there is one
+            _syncContext = SynchronizationContext.Current;
+            RaiseProgressChanged(true);
+
+            LoaderRun previousRun = _run;
+            LoaderRun run = new LoaderRun(_parseWorkerCount * 2);
+            _run = run;
+
+            // The previous run may still park its files into the pending queue, so the new run takes it over only after that run is drained
+            if (previousRun != null && !previousRun.Drained.Task.IsCompleted)
+                previousRun.Drained.Task.ContinueWith((t) => StartRun(run));
+            else
+                StartRun(run);
+        }
+
+        private void StartRun(LoaderRun run)
+        {
+            ReadStage.Start();
+            ParseStage.Start();
+
+            Task[] readers = new Task[ReadWorkerCount];
+            for (int i = 0; i < readers.Length; ++i)
+                readers[i] = Task.Run(() => RunReadStage(run));
+            Task readersDone = Task.WhenAll(readers).ContinueWith((t) =>
             {
-                Task<List<SymbolTable>> task = Task.Factory.StartNew(() =>
-                {
-                    Interlocked.Increment(ref _runningTaskCount);
-                    List<SymbolTable> tables = new List<SymbolTable>();
-                    while (!_queue.IsEmpty && _state == State.Running)
-                    {
-                        string filePath;
-                        if (_queue.TryDequeue(out filePath))
-                        {
-                            SymbolTable table = new SymbolTable(new IncludeFileId(filePath));
-                            try
-                            {
-                                string source = File.ReadAllText(filePath);
-                                List<CppToken> _tokens = new List<CppToken>();
-                                using (CppLexer lexer = new CppLexer(source, 0, source.Length, new TextPosition(), Languages.LanguageKind.Cpp))
-                                {
-                                    foreach (TextError err in lexer.LexErrors)
-                                        Debug.WriteLine($"Lex error[{filePath}]: {err.Message}");
-                                    _tokens.AddRange(lexer.Tokenize());
-                                }
-                                using (CppParser parser = new CppParser(table.Id, new CppParser.CppConfiguration()))
-                                {
-                                    parser.ParseTokens(source, _tokens);
-                                    foreach (TextError err in parser.ParseErrors)
-                                        Debug.WriteLine($"Parse error[{filePath}]: {err.Message}");
-                                    table.AddTable(parser.LocalSymbolTable);
-                                }
-                                table.IsValid = true;
-                            }
-                            catch (Exception e)
-                            {
-                                Debug.WriteLine($"Failed parsing include file '{filePath}': {e.Message}");
-                            }
-                            tables.Add(table);
-                            Interlocked.Increment(ref _progressFileCount);
-                            ProgressChanged?.Invoke(this, new ProgressChangedEventArgs(_progressFileCount, _totalFileCount));
-                        }
-                        Thread.Yield();
-                    }
-                    return (tables);
-                });
-                task.ContinueWith((t) =>
-                {
-                    foreach (SymbolTable table in t.Result)
-                        _tables.Add(table);
-                    while (_tasks.ContainsKey(t) && !_tasks.TryRemove(t, out _))
-                        Thread.Yield();
-                    if (Interlocked.Decrement(ref _runningTaskCount) == 0)
-                    {
-                        // All tasks are done, this does not nessecarly mean that everything is finished
-                        if (_queue.IsEmpty)
-                        {
-                            _state = State.Complete;
-                            IsCompleted?.Invoke(this, _tables);
-                        }
-                        else
-                            _state = State.Paused;
-                    }
-                });
-                _tasks.AddOrUpdate(task, task, (key, existingVal) =>
-                {
-                    if (task != existingVal)
-                        throw new ArgumentException("Duplicate task are not allowed");
-                    return (existingVal);
-                });
-            }
+                run.Sources.Writer.TryComplete();
+                ReadStage.Stop();
+            });
+            Task[] parsers = new Task[_parseWorkerCount];
+            for (int i = 0; i < parsers.Length; ++i)
+                parsers[i] = Task.Run(() => RunParseStage(run));
+            Task parsersDone = Task.WhenAll(parsers).ContinueWith((t) => ParseStage.Stop());
+            Task.WhenAll(readersDone, parsersDone).ContinueWith((t) => run.Drained.TrySetResult(true));
+
+            // @NOTE(final): Hold one count while we schedule, so that completion can not be signaled before all pending files are queued
+            Interlocked.Increment(ref run.ScheduledCount);
+            string filePath;
+            while (_pendingQueue.TryDequeue(out filePath))
+                Schedule(run, filePath);
+            FinishFile(run);
         }
 
         public void Pause()
         {
             if (_state == State.Running)
+            {
                 _state = State.Paused;
+                _run?.Cancellation.Cancel();
+            }
             else
                 throw new Exception($"Cannot pause include loader in state {_state}");
         }
@@ -167,10 +243,341 @@ namespace TSP.DoxygenEditor.Includes
             if (_state == State.Running || _state == State.Paused)
             {
                 _state = State.Stopped;
-                _tasks.Clear();
+                LoaderRun run = _run;
+                if (run != null)
+                {
+                    run.IsDiscarded = true;
+                    run.Cancellation.Cancel();
+                }
+                while (_pendingQueue.TryDequeue(out _)) { }
             }
             else
                 throw new Exception($"Cannot stop include loader in state {_state}");
         }
+
+        private void Schedule(LoaderRun run, string filePath)
+        {
+            Interlocked.Increment(ref run.ScheduledCount);
+            if (!run.Paths.Writer.TryWrite(filePath))
+                FinishFile(run);
+        }
+
+        private void FinishFile(LoaderRun run)
+        {
+            if (Interlocked.Decrement(ref run.ScheduledCount) == 0)
+            {
+                // Nothing is in flight anymore, so the stages of this run shut down
+                run.Paths.Writer.TryComplete();
+                PublishTables(true);
+                RaiseProgressChanged(true);
+
+                // A paused or stopped run leaves the state alone, the files it did not finish are in the pending queue
+                if (run.Cancellation.IsCancellationRequested)
+                    return;
+                if (_run == run && _state == State.Running && _pendingQueue.IsEmpty)
+                {
+                    _state = State.Complete;
+                    Raise(() => IsCompleted?.Invoke(this, _tables));
+                }
+            }
+        }
+
+        private void Raise(Action action)
+        {
+            SynchronizationContext context = _syncContext;
+            if (context != null)
+                context.Post((state) => action(), null);
+            else
+                action();
+        }
+
+        private void RaiseProgressChanged(bool force)
+        {
+            long now = Stopwatch.GetTimestamp();
+            long last = Interlocked.Read(ref _lastProgressTimestamp);
+            long intervalTicks = (long)(ProgressInterval.TotalSeconds * Stopwatch.Frequency);
+            if (!force && now - last < intervalTicks)
+                return;
+            if (Interlocked.CompareExchange(ref _lastProgressTimestamp, now, last) != last && !force)
+                return;
+            ProgressChangedEventArgs args = new ProgressChangedEventArgs(_progressFileCount, TotalFileCount);
+            Raise(() => ProgressChanged?.Invoke(this, args));
+        }
+
+        private void PublishTables(bool force)
+        {
+            if (_publishQueue.IsEmpty)
+                return;
+            if (!force)
+            {
+                long intervalTicks = (long)(PublishInterval.TotalSeconds * Stopwatch.Frequency);
+                bool isDue = Stopwatch.GetTimestamp() - Interlocked.Read(ref _lastPublishTimestamp) >= intervalTicks;
+                if (_publishQueue.Count < PublishBatchSize && !isDue)
+                    return;
+            }
+
+            // Only one thread publishes at a time, the others just keep on parsing
+            if (Interlocked.CompareExchange(ref _isPublishing, 1, 0) != 0)
+            {
+                if (!force)
+                    return;
+                SpinWait spin = new SpinWait();
+                while (Interlocked.CompareExchange(ref _isPublishing, 1, 0) != 0)
+                    spin.SpinOnce();
+            }
+            try
+            {
+                List<SymbolTable> batch = new List<SymbolTable>();
+                SymbolTable table;
+                while (_publishQueue.TryDequeue(out table))
+                    batch.Add(table);
+                if (batch.Count > 0)
+                {
+                    if (PublishToGlobalCache)
+                        GlobalSymbolCache.AddOrReplaceTables(batch);
+                    Raise(() => TablesPublished?.Invoke(this, batch));
+                }
+                Interlocked.Exchange(ref _lastPublishTimestamp, Stopwatch.GetTimestamp());
+            }
+            finally
+            {
+                Interlocked.Exchange(ref _isPublishing, 0);
+            }
+        }
+
+        private static async Task<SourceFile> ReadSourceFileAsync(string filePath, CancellationToken cancellationToken)
+        {
+            using (FileStream stream = new FileStream(filePath, FileMode.Open, FileAccess.Read, FileShare.ReadWrite, 4096, FileOptions.Asynchronous | FileOptions.SequentialScan))
+            using (StreamReader reader = new StreamReader(stream, Encoding.UTF8, true))
+            {
+                // The counters measure what was read from disk, not the size of the decoded text
+                long byteCount = stream.Length;
+                cancellationToken.ThrowIfCancellationRequested();
+                string source = await reader.ReadToEndAsync().ConfigureAwait(false);
+                return new SourceFile(filePath, source, byteCount);
+            }
+        }
+
+        private async Task RunReadStage(LoaderRun run)
+        {
+            ChannelReader<string> pathReader = run.Paths.Reader;
+            ChannelWriter<SourceFile> sourceWriter = run.Sources.Writer;
+            CancellationToken cancellationToken = run.Cancellation.Token;
+
+            // @NOTE(final): The path channel is always read until it completes, so every scheduled file is either read or parked
+            while (await pathReader.WaitToReadAsync().ConfigureAwait(false))
+            {
+                string filePath;
+                while (pathReader.TryRead(out filePath))
+                {
+                    if (cancellationToken.IsCancellationRequested)
+                    {
+                        ParkFile(run, filePath);
+                        continue;
+                    }
+
+                    long startTicks = Stopwatch.GetTimestamp();
+                    SourceFile sourceFile;
+                    try
+                    {
+                        sourceFile = await ReadSourceFileAsync(filePath, cancellationToken).ConfigureAwait(false);
+                    }
+                    catch (OperationCanceledException)
+                    {
+                        ParkFile(run, filePath);
+                        continue;
+                    }
+                    catch (Exception e)
+                    {
+                        Debug.WriteLine($"Failed reading include file '{filePath}': {e.Message}");
+                        AddTable(new SymbolTable(new IncludeFileId(filePath)));
+                        FinishFile(run);
+                        continue;
+                    }
+                    ReadStage.AddItem(sourceFile.ByteCount, Stopwatch.GetTimestamp() - startTicks);
+
+                    if (!sourceWriter.TryWrite(sourceFile))
+                    {
+                        long blockedTicks = Stopwatch.GetTimestamp();
+                        bool isWritten = false;
+                        try
+                        {
+                            await sourceWriter.WriteAsync(sourceFile, cancellationToken).ConfigureAwait(false);
+                            isWritten = true;
+                        }
+                        catch (OperationCanceledException)
+                        {
+                        }
+                        ReadStage.AddBlocked(Stopwatch.GetTimestamp() - blockedTicks);
+                        if (!isWritten)
+                            ParkFile(run, filePath);
+                    }
+                }
+            }
+        }
+
+        private async Task RunParseStage(LoaderRun run)
+        {
+            ChannelReader<SourceFile> sourceReader = run.Sources.Reader;
+            CancellationToken cancellationToken = run.Cancellation.Token;
+            while (await sourceReader.WaitToReadAsync().ConfigureAwait(false))
+            {
+                SourceFile sourceFile;
+                while (sourceReader.TryRead(out sourceFile))
+                {
+                    if (cancellationToken.IsCancellationRequested)
+                    {
+                        ParkFile(run, sourceFile.FilePath);
+                        continue;
+                    }
+                    long startTicks = Stopwatch.GetTimestamp();
+                    try
+                    {
+                        ParseFile(run, sourceFile);
+                    }
+                    finally
+                    {
+                        ParseStage.AddItem(sourceFile.ByteCount, Stopwatch.GetTimestamp() - startTicks);
+                        FinishFile(run);
+                    }
+                }
+            }
+        }
+
+        private void ParkFile(LoaderRun run, string filePath)
+        {
+            if (!run.IsDiscarded && _state != State.Stopped)
+                _pendingQueue.Enqueue(filePath);
+            FinishFile(run);
+        }
+
+        private void AddTable(SymbolTable table)
+        {
+            _tables.Add(table);
+            _publishQueue.Enqueue(table);
+            Interlocked.Increment(ref _progressFileCount);
+            PublishTables(false);
+            RaiseProgressChanged(false);
+        }
+
+        private string ResolveInclude(string includingFilePath, string includeName, bool isQuoted)
+        {
+            if (Path.IsPathRooted(includeName))
+                return (File.Exists(includeName) ? Path.GetFullPath(includeName) : null);
+            if (isQuoted)
+            {
+                string localPath = Path.Combine(Path.GetDirectoryName(includingFilePath), includeName);
+                if (File.Exists(localPath))
+                    return (Path.GetFullPath(localPath));
+            }
+            foreach (string includePath in _includePaths)
+            {
+                string fullPath = Path.Combine(includePath, includeName);
+                if (File.Exists(fullPath))
+                    return (Path.GetFullPath(fullPath));
+            }
+            return (null);
+        }
+
+        private const int MaxIncludeMacroDepth = 8;
+
+        /// <summary>
+        /// Gets the file name from a "name" or &lt;name&gt; include value.
+        /// Macros (#include FOO_H) are expanded through the <see cref="Defines"/>, when that is not possible false is returned.
+        /// </summary>
+        private bool TryGetIncludeName(string value, out string includeName, out bool isQuoted)
+        {
+            includeName = null;
+            isQuoted = false;
+            for (int depth = 0; depth < MaxIncludeMacroDepth; ++depth)
+            {
+                value = value.Trim();
+                if (value.Length < 3)
+                    return (false);
+                char first = value[0];
+                char last = value[value.Length - 1];
+                if ((first == '"' && last == '"') || (first == '<' && last == '>'))
+                {
+                    isQuoted = first == '"';
+                    includeName = value.Substring(1, value.Length - 2).Trim();
+                    return (includeName.Length > 0);
+                }
+                if (!SyntaxUtils.IsIdentStart(first) || Defines == null || !Defines.TryGetValue(value, out value) || value == null)
+                    return (false);
+            }
+            return (false);
+        }
+
+        private void AddIncludes(LoaderRun run, IncludeFile file, IEnumerable<CppToken> tokens)
+        {
+            foreach (CppToken token in tokens)
+            {
+                if (token.Kind != CppTokenKind.PreprocessorInclude || !token.IsComplete)
+                    continue;
+                string value = token.Value.Trim();
+                string includeName;
+                bool isQuoted;
+                if (!TryGetIncludeName(value, out includeName, out isQuoted))
+                {
+                    // Unknown macro or malformed include, keep it as unresolved so it shows up in the include graph
+                    lock (file)
+                        file.UnresolvedIncludes.Add(value);
+                    continue;
+                }
+                string includeFilePath = ResolveInclude(file.FilePath, includeName, isQuoted);
+                lock (file)
+                {
+                    if (includeFilePath == null)
+                    {
+                        file.UnresolvedIncludes.Add(includeName);
+                        continue;
+                    }
+                    file.Includes.Add(includeFilePath);
+                }
+                if (_files.TryAdd(includeFilePath, new IncludeFile(includeFilePath)))
+                    Schedule(run, includeFilePath);
+            }
+        }
+
+        private void ParseFile(LoaderRun run, SourceFile sourceFile)
+        {
+            IncludeFile file = _files[sourceFile.FilePath];
+
+            // Schedule the includes before parsing, so the read stage can already load them while we are busy
+            SymbolTable table = ParseSource(sourceFile.FilePath, sourceFile.Source, Defines, (tokens) => AddIncludes(run, file, tokens));
+            AddTable(table);
+        }
+
+        internal static SymbolTable ParseSource(string filePath, string source, CppPreprocessorDefines defines, Action<List<CppToken>> tokensLexed = null)
+        {
+            SymbolTable table = new SymbolTable(new IncludeFileId(filePath));
+            try
+            {
+                List<CppToken> tokens = new List<CppToken>();
+                // Only declarations are of interest in include files, so function bodies are skipped entirely
+                using (CppLexer lexer = new CppLexer(source, 0, source.Length, new TextPosition(), Languages.LanguageKind.Cpp, CppLexer.LexMode.DeclarationsOnly, defines))
+                {
+                    tokens.AddRange(lexer.Tokenize());
+                    foreach (TextError err in lexer.LexErrors)
+                        Debug.WriteLine($"Lex error[{filePath}]: {err.Message}");
+                }
+
+                tokensLexed?.Invoke(tokens);
+
+                using (CppParser parser = new CppParser(table.Id, new CppParser.CppConfiguration()))
+                {
+                    parser.ParseTokens(source, tokens);
+                    foreach (TextError err in parser.ParseErrors)
+                        Debug.WriteLine($"Parse error[{filePath}]: {err.Message}");
+                    table.AddTable(parser.LocalSymbolTable);
+                }
+                table.IsValid = true;
+            }
+            catch (Exception e)
+            {
+                Debug.WriteLine($"Failed parsing include file '{filePath}': {e.Message}");
+            }
+            return (table);
+        }
     }
 }
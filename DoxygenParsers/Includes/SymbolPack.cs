@@ -0,0 +1,344 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+using System.Runtime.InteropServices;
+using System.Text;
+using TSP.DoxygenEditor.Languages;
+using TSP.DoxygenEditor.Symbols;
+using TSP.DoxygenEditor.TextAnalysis;
+
+namespace TSP.DoxygenEditor.Includes
+{
+    /// <summary>
+    /// Precompiled symbol tables of a header set, stored in a single memory-mapped file.
+    /// Layout: header, string table, string data (UTF-8), file table, source records, reference records.
+    /// All records have a fixed size and the symbols of each file are stored contiguous, so a table is read with two array copies and without any parsing.
+    /// Syntax nodes are not stored, so symbols loaded from a pack have no <see cref="BaseSymbol.Node"/>.
+    /// </summary>
+    public class SymbolPack : IDisposable
+    {
+        const uint PackMagic = 0x50535844; // DXSP
+        const int PackVersion = 1;
+        const int NoString = -1;
+
+        [StructLayout(LayoutKind.Sequential, Pack = 4)]
+        struct PackHeader
+        {
+            public uint Magic;
+            public int Version;
+            public int StringCount;
+            public int FileCount;
+            public int SourceCount;
+            public int ReferenceCount;
+            public long StringTableOffset;
+            public long StringDataOffset;
+            public long StringDataLength;
+            public long FileTableOffset;
+            public long SourceTableOffset;
+            public long ReferenceTableOffset;
+        }
+
+        [StructLayout(LayoutKind.Sequential, Pack = 4)]
+        struct PackString
+        {
+            public int Offset;
+            public int Length;
+        }
+
+        [StructLayout(LayoutKind.Sequential, Pack = 4)]
+        struct PackFile
+        {
+            public int PathString;
+            public int IsValid;
+            public int FirstSource;
+            public int SourceCount;
+            public int FirstReference;
+            public int ReferenceCount;
+        }
+
+        [StructLayout(LayoutKind.Sequential, Pack = 4)]
+        struct PackSource
+        {
+            public int NameString;
+            public int CaptionString;
+            public int Kind;
+            public int Lang;
+            public int Index;
+            public int Line;
+            public int Column;
+            public int Length;
+        }
+
+        [StructLayout(LayoutKind.Sequential, Pack = 4)]
+        struct PackReference
+        {
+            public int NameString;
+            public int Kind;
+            public int Lang;
+            public int Index;
+            public int Line;
+            public int Column;
+            public int Length;
+        }
+
+        private readonly MemoryMappedFile _mappedFile;
+        private readonly MemoryMappedViewAccessor _accessor;
+        private readonly PackHeader _header;
+        private readonly PackString[] _stringTable;
+        private readonly string[] _strings;
+        private readonly PackFile[] _fileTable;
+        private readonly string[] _files;
+
+        public string FilePath { get; }
+        public IReadOnlyList<string> Files => _files;
+        public int FileCount => _files.Length;
+        public int SourceCount => _header.SourceCount;
+        public int ReferenceCount => _header.ReferenceCount;
+
+        private SymbolPack(string filePath)
+        {
+            FilePath = filePath;
+
+            // @NOTE(final): Empty files cannot be mapped at all, so they are rejected before mapping
+            if (new FileInfo(filePath).Length < Marshal.SizeOf<PackHeader>())
+                throw new InvalidDataException($"Symbol pack '{filePath}' is too small");
+
+            _mappedFile = MemoryMappedFile.CreateFromFile(filePath, FileMode.Open, null, 0, MemoryMappedFileAccess.Read);
+            try
+            {
+                _accessor = _mappedFile.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+                long capacity = _accessor.Capacity;
+                if (capacity < Marshal.SizeOf<PackHeader>())
+                    throw new InvalidDataException($"Symbol pack '{filePath}' is too small");
+                _accessor.Read(0, out _header);
+                if (_header.Magic != PackMagic)
+                    throw new InvalidDataException($"File '{filePath}' is not a symbol pack");
+                if (_header.Version != PackVersion)
+                    throw new InvalidDataException($"Symbol pack '{filePath}' has version {_header.Version}, but expect version {PackVersion}");
+                if (_header.ReferenceTableOffset + (long)_header.ReferenceCount * Marshal.SizeOf<PackReference>() > capacity)
+                    throw new InvalidDataException($"Symbol pack '{filePath}' is truncated");
+
+                _stringTable = new PackString[_header.StringCount];
+                _accessor.ReadArray(_header.StringTableOffset, _stringTable, 0, _stringTable.Length);
+                _strings = new string[_header.StringCount];
+
+                _fileTable = new PackFile[_header.FileCount];
+                _accessor.ReadArray(_header.FileTableOffset, _fileTable, 0, _fileTable.Length);
+                _files = new string[_fileTable.Length];
+                for (int i = 0; i < _fileTable.Length; ++i)
+                    _files[i] = GetString(_fileTable[i].PathString);
+            }
+            catch
+            {
+                _accessor?.Dispose();
+                _mappedFile.Dispose();
+                throw;
+            }
+        }
+
+        public static SymbolPack Open(string filePath)
+        {
+            if (string.IsNullOrWhiteSpace(filePath))
+                throw new ArgumentNullException("File path may not be null or empty");
+            return (new SymbolPack(Path.GetFullPath(filePath)));
+        }
+
+        private string GetString(int index)
+        {
+            if (index == NoString)
+                return (null);
+            string result = _strings[index];
+            if (result == null)
+            {
+                // Strings are decoded on first use only and shared by all symbols afterwards
+                PackString entry = _stringTable[index];
+                byte[] bytes = new byte[entry.Length];
+                _accessor.ReadArray(_header.StringDataOffset + entry.Offset, bytes, 0, bytes.Length);
+                result = Encoding.UTF8.GetString(bytes);
+                _strings[index] = result;
+            }
+            return (result);
+        }
+
+        /// <summary>
+        /// Creates the symbol table of the file at the given index, with the same id as the <see cref="SourceIncludesLoader"/> would create.
+        /// </summary>
+        public SymbolTable ReadTable(int fileIndex)
+        {
+            if (fileIndex < 0 || fileIndex >= _fileTable.Length)
+                throw new ArgumentOutOfRangeException("File index is out of range");
+            PackFile file = _fileTable[fileIndex];
+            SymbolTable result = new SymbolTable(new IncludeFileId(_files[fileIndex]));
+
+            PackSource[] sources = new PackSource[file.SourceCount];
+            _accessor.ReadArray(_header.SourceTableOffset + (long)file.FirstSource * Marshal.SizeOf<PackSource>(), sources, 0, sources.Length);
+            foreach (PackSource source in sources)
+            {
+                TextRange range = new TextRange(new TextPosition(source.Index, source.Line, source.Column), source.Length);
+                result.AddSource(new SourceSymbol((LanguageKind)source.Lang, (SourceSymbolKind)source.Kind, GetString(source.NameString), GetString(source.CaptionString), range));
+            }
+
+            PackReference[] references = new PackReference[file.ReferenceCount];
+            _accessor.ReadArray(_header.ReferenceTableOffset + (long)file.FirstReference * Marshal.SizeOf<PackReference>(), references, 0, references.Length);
+            foreach (PackReference reference in references)
+            {
+                TextRange range = new TextRange(new TextPosition(reference.Index, reference.Line, reference.Column), reference.Length);
+                result.AddReference(new ReferenceSymbol((LanguageKind)reference.Lang, (ReferenceSymbolKind)reference.Kind, GetString(reference.NameString), range, null));
+            }
+
+            result.IsValid = file.IsValid != 0;
+            return (result);
+        }
+
+        public IEnumerable<SymbolTable> ReadTables()
+        {
+            for (int i = 0; i < _fileTable.Length; ++i)
+                yield return ReadTable(i);
+        }
+
+        /// <summary>
+        /// Writes the given tables into a new pack file. The pack is written to a temporary file first and then moved, so readers never see a partial pack.
+        /// </summary>
+        public static void Write(string filePath, IEnumerable<SymbolTable> tables)
+        {
+            if (string.IsNullOrWhiteSpace(filePath))
+                throw new ArgumentNullException("File path may not be null or empty");
+            if (tables == null)
+                throw new ArgumentNullException("Tables may not be null");
+
+            List<SymbolTable> sortedTables = new List<SymbolTable>(tables);
+            sortedTables.Sort((a, b) => string.CompareOrdinal(a.Id.SymbolTableId.ToString(), b.Id.SymbolTableId.ToString()));
+
+            Dictionary<string, int> stringMap = new Dictionary<string, int>();
+            List<PackString> stringTable = new List<PackString>();
+            MemoryStream stringData = new MemoryStream();
+            Func<string, int> addString = (s) =>
+            {
+                if (s == null)
+                    return (NoString);
+                int index;
+                if (!stringMap.TryGetValue(s, out index))
+                {
+                    byte[] bytes = Encoding.UTF8.GetBytes(s);
+                    index = stringTable.Count;
+                    stringTable.Add(new PackString() { Offset = (int)stringData.Length, Length = bytes.Length });
+                    stringData.Write(bytes, 0, bytes.Length);
+                    stringMap.Add(s, index);
+                }
+                return (index);
+            };
+
+            List<PackFile> fileTable = new List<PackFile>(sortedTables.Count);
+            List<PackSource> sourceTable = new List<PackSource>();
+            List<PackReference> referenceTable = new List<PackReference>();
+            foreach (SymbolTable table in sortedTables)
+            {
+                PackFile file = new PackFile()
+                {
+                    PathString = addString(table.Id.SymbolTableId.ToString()),
+                    IsValid = table.IsValid ? 1 : 0,
+                    FirstSource = sourceTable.Count,
+                    FirstReference = referenceTable.Count,
+                };
+                foreach (KeyValuePair<string, List<SourceSymbol>> sourcePair in table.SourceMap)
+                {
+                    foreach (SourceSymbol source in sourcePair.Value)
+                    {
+                        sourceTable.Add(new PackSource()
+                        {
+                            NameString = addString(source.Name),
+                            CaptionString = addString(source.Caption),
+                            Kind = (int)source.Kind,
+                            Lang = (int)source.Lang,
+                            Index = source.Range.Position.Index,
+                            Line = source.Range.Position.Line,
+                            Column = source.Range.Position.Column,
+                            Length = source.Range.Length,
+                        });
+                    }
+                }
+                foreach (KeyValuePair<string, List<ReferenceSymbol>> referencePair in table.ReferenceMap)
+                {
+                    foreach (ReferenceSymbol reference in referencePair.Value)
+                    {
+                        referenceTable.Add(new PackReference()
+                        {
+                            NameString = addString(reference.Name),
+                            Kind = (int)reference.Kind,
+                            Lang = (int)reference.Lang,
+                            Index = reference.Range.Position.Index,
+                            Line = reference.Range.Position.Line,
+                            Column = reference.Range.Position.Column,
+                            Length = reference.Range.Length,
+                        });
+                    }
+                }
+                file.SourceCount = sourceTable.Count - file.FirstSource;
+                file.ReferenceCount = referenceTable.Count - file.FirstReference;
+                fileTable.Add(file);
+            }
+
+            PackHeader header = new PackHeader()
+            {
+                Magic = PackMagic,
+                Version = PackVersion,
+                StringCount = stringTable.Count,
+                FileCount = fileTable.Count,
+                SourceCount = sourceTable.Count,
+                ReferenceCount = referenceTable.Count,
+            };
+            header.StringTableOffset = Marshal.SizeOf<PackHeader>();
+            header.StringDataOffset = header.StringTableOffset + (long)stringTable.Count * Marshal.SizeOf<PackString>();
+            header.StringDataLength = stringData.Length;
+            header.FileTableOffset = header.StringDataOffset + stringData.Length;
+            header.SourceTableOffset = header.FileTableOffset + (long)fileTable.Count * Marshal.SizeOf<PackFile>();
+            header.ReferenceTableOffset = header.SourceTableOffset + (long)sourceTable.Count * Marshal.SizeOf<PackSource>();
+
+            string fullPath = Path.GetFullPath(filePath);
+            string tempPath = fullPath + ".tmp";
+            using (FileStream stream = new FileStream(tempPath, FileMode.Create, FileAccess.Write, FileShare.None))
+            {
+                WriteStructs(stream, new PackHeader[] { header });
+                WriteStructs(stream, stringTable.ToArray());
+                stringData.Position = 0;
+                stringData.CopyTo(stream);
+                WriteStructs(stream, fileTable.ToArray());
+                WriteStructs(stream, sourceTable.ToArray());
+                WriteStructs(stream, referenceTable.ToArray());
+            }
+            File.Move(tempPath, fullPath, true);
+        }
+
+        private static void WriteStructs<T>(Stream stream, T[] items) where T : struct
+        {
+            stream.Write(MemoryMarshal.AsBytes(new ReadOnlySpan<T>(items)));
+        }
+
+        #region IDisposable Support
+        protected virtual void DisposeManaged()
+        {
+            _accessor.Dispose();
+            _mappedFile.Dispose();
+        }
+        protected virtual void DisposeUnmanaged()
+        {
+        }
+        private void Dispose(bool disposing)
+        {
+            if (disposing)
+                DisposeManaged();
+            DisposeUnmanaged();
+        }
+        public void Dispose()
+        {
+            Dispose(true);
+            GC.SuppressFinalize(this);
+        }
+        ~SymbolPack()
+        {
+            Dispose(false);
+        }
+        #endregion
+    }
+}
@@ -0,0 +1,577 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Text;
+using TSP.DoxygenEditor.Languages.Utils;
+
+namespace TSP.DoxygenEditor.Languages.Cpp
+{
+    /// <summary>
+    /// Follows the #if/#ifdef/#ifndef/#elif/#else/#endif nesting and the #define/#undef state of a single source,
+    /// so the lexer knows whether the current region is active or can be skipped.
+    /// </summary>
+    class CppConditionalEvaluator
+    {
+        struct Conditional
+        {
+            public bool IsParentActive;
+            public bool WasTaken;
+            public bool IsActive;
+            public bool IsUnknown;
+        }
+
+        const int MaxExpansionDepth = 16;
+
+        private readonly CppPreprocessorDefines _defines;
+        private readonly Stack<Conditional> _conditionals = new Stack<Conditional>();
+
+        public bool IsActive => _conditionals.Count == 0 || _conditionals.Peek().IsActive;
+
+        public CppConditionalEvaluator(CppPreprocessorDefines defines)
+        {
+            // @NOTE(final): Work on a copy, so the #define/#undef of one source does not leak into the defines of the workspace
+            _defines = defines != null ? new CppPreprocessorDefines(defines) : new CppPreprocessorDefines();
+        }
+
+        /// <summary>
+        /// Applies a single preprocessor directive (starting with the '#') and returns whether the following region is active.
+        /// Conditions that cannot be evaluated are unknown, the arm and all following #elif/#else arms stay active, so no code gets lost.
+        /// </summary>
+        public bool ProcessDirective(string directive, out string error)
+        {
+            error = null;
+            ExpressionParser parser = new ExpressionParser(Normalize(directive), _defines, 0);
+            if (!parser.TryRead('#'))
+                return (IsActive);
+            string keyword = parser.ReadIdent();
+            switch (keyword)
+            {
+                case "if":
+                    {
+                        bool? isActive = IsActive ? EvaluateCondition(parser, ref error) : false;
+                        Push(isActive);
+                    }
+                    break;
+
+                case "ifdef":
+                case "ifndef":
+                    {
+                        bool isActive = IsActive;
+                        string name = parser.ReadIdent();
+                        if (name == null)
+                        {
+                            error = $"Expect identifier for {keyword}";
+                            Push(isActive);
+                        }
+                        else
+                            Push(isActive && (_defines.IsDefined(name) == ("ifdef".Equals(keyword))));
+                    }
+                    break;
+
+                case "elif":
+                case "else":
+                    {
+                        if (_conditionals.Count == 0)
+                        {
+                            error = $"Unexpected {keyword} without if";
+                            break;
+                        }
+                        Conditional top = _conditionals.Pop();
+                        if (top.IsParentActive && !top.WasTaken)
+                        {
+                            bool? condition = "else".Equals(keyword) ? true : EvaluateCondition(parser, ref error);
+                            if (condition.HasValue)
+                            {
+                                // @NOTE(final): A previous unknown arm does not count as taken, so a true arm or the #else following it is still active
+                                top.IsActive = condition.Value;
+                                top.WasTaken = condition.Value;
+                            }
+                            else
+                            {
+                                top.IsActive = true;
+                                top.IsUnknown = true;
+                            }
+                        }
+                        else
+                            top.IsActive = false;
+                        _conditionals.Push(top);
+                    }
+                    break;
+
+                case "endif":
+                    {
+                        if (_conditionals.Count == 0)
+                            error = "Unexpected endif without if";
+                        else
+                            _conditionals.Pop();
+                    }
+                    break;
+
+                case "define":
+                    {
+                        if (!IsActive)
+                            break;
+                        string name = parser.ReadIdent();
+                        if (name == null)
+                            break;
+                        if (parser.Peek() == '(')
+                            _defines.Define(name, null);
+                        else
+                            _defines.Define(name, parser.ReadRemaining().Trim());
+                    }
+                    break;
+
+                case "undef":
+                    {
+                        if (!IsActive)
+                            break;
+                        string name = parser.ReadIdent();
+                        if (name != null)
+                            _defines.Undefine(name);
+                    }
+                    break;
+            }
+            return (IsActive);
+        }
+
+        private void Push(bool? isActive)
+        {
+            Conditional conditional = new Conditional()
+            {
+                IsParentActive = IsActive,
+                WasTaken = isActive == true,
+                IsActive = isActive != false,
+                IsUnknown = !isActive.HasValue,
+            };
+            _conditionals.Push(conditional);
+        }
+
+        /// <summary>
+        /// Evaluates the condition of #if or #elif, returns null when it cannot be evaluated.
+        /// </summary>
+        private static bool? EvaluateCondition(ExpressionParser parser, ref string error)
+        {
+            try
+            {
+                return (parser.ParseFull() != 0);
+            }
+            catch (FormatException e)
+            {
+                error = e.Message;
+                return (null);
+            }
+        }
+
+        /// <summary>
+        /// Removes line continuations and replaces comments with a single space.
+        /// </summary>
+        private static string Normalize(string directive)
+        {
+            if (directive.IndexOf('\\') < 0 && directive.IndexOf('/') < 0)
+                return (directive);
+            StringBuilder s = new StringBuilder(directive.Length);
+            int i = 0;
+            while (i < directive.Length)
+            {
+                char c = directive[i];
+                char n = i + 1 < directive.Length ? directive[i + 1] : char.MaxValue;
+                if (c == '\\' && SyntaxUtils.IsLineBreak(n))
+                    i += 1 + SyntaxUtils.GetLineBreakChars(n, i + 2 < directive.Length ? directive[i + 2] : char.MaxValue);
+                else if (c == '/' && n == '/')
+                    break;
+                else if (c == '/' && n == '*')
+                {
+                    int end = directive.IndexOf("*/", i + 2, StringComparison.Ordinal);
+                    i = end < 0 ? directive.Length : end + 2;
+                    s.Append(' ');
+                }
+                else
+                {
+                    s.Append(c);
+                    ++i;
+                }
+            }
+            return (s.ToString());
+        }
+
+        /// <summary>
+        /// Recursive descent parser for the integer constant expressions of #if and #elif.
+        /// Unknown identifiers evaluate to zero, defines are expanded recursively.
+        /// The right side of && and || and the not chosen side of ?: are parsed only, so their defines are not expanded.
+        /// </summary>
+        class ExpressionParser
+        {
+            private readonly string _text;
+            private readonly CppPreprocessorDefines _defines;
+            private readonly int _depth;
+            private int _pos;
+            private int _skipDepth;
+
+            public ExpressionParser(string text, CppPreprocessorDefines defines, int depth)
+            {
+                _text = text;
+                _defines = defines;
+                _depth = depth;
+                _pos = 0;
+            }
+
+            private void SkipSpaces()
+            {
+                while (_pos < _text.Length && char.IsWhiteSpace(_text[_pos]))
+                    ++_pos;
+            }
+
+            public char Peek()
+            {
+                return (_pos < _text.Length ? _text[_pos] : char.MaxValue);
+            }
+
+            public bool TryRead(char c)
+            {
+                SkipSpaces();
+                if (Peek() == c)
+                {
+                    ++_pos;
+                    return (true);
+                }
+                return (false);
+            }
+
+            private bool TryRead(string s)
+            {
+                SkipSpaces();
+                if (string.CompareOrdinal(_text, _pos, s, 0, s.Length) == 0)
+                {
+                    _pos += s.Length;
+                    return (true);
+                }
+                return (false);
+            }
+
+            private bool TryReadOperator(char c, char notFollowedBy1, char notFollowedBy2 = char.MaxValue)
+            {
+                SkipSpaces();
+                if (Peek() != c)
+                    return (false);
+                char n = _pos + 1 < _text.Length ? _text[_pos + 1] : char.MaxValue;
+                if (n == notFollowedBy1 || n == notFollowedBy2)
+                    return (false);
+                ++_pos;
+                return (true);
+            }
+
+            public string ReadIdent()
+            {
+                SkipSpaces();
+                if (!SyntaxUtils.IsIdentStart(Peek()))
+                    return (null);
+                int start = _pos;
+                while (_pos < _text.Length && SyntaxUtils.IsIdentPart(_text[_pos]))
+                    ++_pos;
+                return (_text.Substring(start, _pos - start));
+            }
+
+            public string ReadRemaining()
+            {
+                string result = _pos < _text.Length ? _text.Substring(_pos) : string.Empty;
+                _pos = _text.Length;
+                return (result);
+            }
+
+            public long ParseFull()
+            {
+                long result = ParseConditional();
+                SkipSpaces();
+                if (_pos < _text.Length)
+                    throw new FormatException($"Unexpected character '{_text[_pos]}' in preprocessor expression");
+                return (result);
+            }
+
+            private long ParseConditional()
+            {
+                long cond = ParseLogicalOr();
+                if (TryRead('?'))
+                {
+                    long a = ParseSkipped(cond == 0, ParseConditional);
+                    if (!TryRead(':'))
+                        throw new FormatException("Expect ':' in preprocessor expression");
+                    long b = ParseSkipped(cond != 0, ParseConditional);
+                    return (cond != 0 ? a : b);
+                }
+                return (cond);
+            }
+
+            private long ParseLogicalOr()
+            {
+                long result = ParseLogicalAnd();
+                while (TryRead("||"))
+                {
+                    long right = ParseSkipped(result != 0, ParseLogicalAnd);
+                    result = (result != 0 || right != 0) ? 1 : 0;
+                }
+                return (result);
+            }
+
+            private long ParseLogicalAnd()
+            {
+                long result = ParseBitOr();
+                while (TryRead("&&"))
+                {
+                    long right = ParseSkipped(result == 0, ParseBitOr);
+                    result = (result != 0 && right != 0) ? 1 : 0;
+                }
+                return (result);
+            }
+
+            private long ParseSkipped(bool isSkipped, Func<long> parse)
+            {
+                if (!isSkipped)
+                    return (parse());
+                ++_skipDepth;
+                long result = parse();
+                --_skipDepth;
+                return (result);
+            }
+
+            private long ParseBitOr()
+            {
+                long result = ParseBitXor();
+                while (TryReadOperator('|', '|'))
+                    result |= ParseBitXor();
+                return (result);
+            }
+
+            private long ParseBitXor()
+            {
+                long result = ParseBitAnd();
+                while (TryRead('^'))
+                    result ^= ParseBitAnd();
+                return (result);
+            }
+
+            private long ParseBitAnd()
+            {
+                long result = ParseEquality();
+                while (TryReadOperator('&', '&'))
+                    result &= ParseEquality();
+                return (result);
+            }
+
+            private long ParseEquality()
+            {
+                long result = ParseRelational();
+                while (true)
+                {
+                    if (TryRead("=="))
+                        result = result == ParseRelational() ? 1 : 0;
+                    else if (TryRead("!="))
+                        result = result != ParseRelational() ? 1 : 0;
+                    else
+                        break;
+                }
+                return (result);
+            }
+
+            private long ParseRelational()
+            {
+                long result = ParseShift();
+                while (true)
+                {
+                    if (TryRead("<="))
+                        result = result <= ParseShift() ? 1 : 0;
+                    else if (TryRead(">="))
+                        result = result >= ParseShift() ? 1 : 0;
+                    else if (TryReadOperator('<', '<'))
+                        result = result < ParseShift() ? 1 : 0;
+                    else if (TryReadOperator('>', '>'))
+                        result = result > ParseShift() ? 1 : 0;
+                    else
+                        break;
+                }
+                return (result);
+            }
+
+            private long ParseShift()
+            {
+                long result = ParseAdditive();
+                while (true)
+                {
+                    if (TryRead("<<"))
+                        result <<= (int)ParseAdditive();
+                    else if (TryRead(">>"))
+                        result >>= (int)ParseAdditive();
+                    else
+                        break;
+                }
+                return (result);
+            }
+
+            private long ParseAdditive()
+            {
+                long result = ParseMultiplicative();
+                while (true)
+                {
+                    if (TryRead('+'))
+                        result += ParseMultiplicative();
+                    else if (TryRead('-'))
+                        result -= ParseMultiplicative();
+                    else
+                        break;
+                }
+                return (result);
+            }
+
+            private long ParseMultiplicative()
+            {
+                long result = ParseUnary();
+                while (true)
+                {
+                    if (TryRead('*'))
+                        result *= ParseUnary();
+                    else if (TryRead('/'))
+                    {
+                        long divisor = ParseUnary();
+                        result = divisor != 0 ? result / divisor : 0;
+                    }
+                    else if (TryRead('%'))
+                    {
+                        long divisor = ParseUnary();
+                        result = divisor != 0 ? result % divisor : 0;
+                    }
+                    else
+                        break;
+                }
+                return (result);
+            }
+
+            private long ParseUnary()
+            {
+                if (TryReadOperator('!', '='))
+                    return (ParseUnary() == 0 ? 1 : 0);
+                else if (TryRead('~'))
+                    return (~ParseUnary());
+                else if (TryRead('-'))
+                    return (-ParseUnary());
+                else if (TryRead('+'))
+                    return (ParseUnary());
+                return (ParsePrimary());
+            }
+
+            private long ParsePrimary()
+            {
+                SkipSpaces();
+                char c = Peek();
+                if (c == '(')
+                {
+                    ++_pos;
+                    long result = ParseConditional();
+                    if (!TryRead(')'))
+                        throw new FormatException("Expect ')' in preprocessor expression");
+                    return (result);
+                }
+                else if (SyntaxUtils.IsNumeric(c))
+                    return (ParseNumber());
+                else if (c == '\'')
+                    return (ParseChar());
+                else if (SyntaxUtils.IsIdentStart(c))
+                {
+                    string ident = ReadIdent();
+                    if ("defined".Equals(ident))
+                    {
+                        bool hasParen = TryRead('(');
+                        string name = ReadIdent();
+                        if (name == null)
+                            throw new FormatException("Expect identifier for defined");
+                        if (hasParen && !TryRead(')'))
+                            throw new FormatException("Expect ')' for defined");
+                        return (_defines.IsDefined(name) ? 1 : 0);
+                    }
+                    return (ExpandIdent(ident));
+                }
+                throw new FormatException(c == char.MaxValue ? "Unexpected end of preprocessor expression" : $"Unexpected character '{c}' in preprocessor expression");
+            }
+
+            private long ExpandIdent(string ident)
+            {
+                string value;
+                bool isDefined = _defines.TryGetValue(ident, out value);
+
+                // Function-like macros and builtins like __has_include(...) are not expanded and evaluate to zero
+                if (TryRead('('))
+                {
+                    int depth = 1;
+                    while (_pos < _text.Length && depth > 0)
+                    {
+                        char c = _text[_pos++];
+                        if (c == '(')
+                            ++depth;
+                        else if (c == ')')
+                            --depth;
+                    }
+                    return (0);
+                }
+
+                if ("true".Equals(ident))
+                    return (1);
+                if (_skipDepth > 0)
+                    return (0);
+                if (!isDefined || string.IsNullOrWhiteSpace(value))
+                    return (0);
+                if (_depth >= MaxExpansionDepth)
+                    throw new FormatException($"Too deep expansion of define '{ident}'");
+                ExpressionParser expansion = new ExpressionParser(value, _defines, _depth + 1);
+                return (expansion.ParseFull());
+            }
+
+            private long ParseNumber()
+            {
+                int start = _pos;
+                while (_pos < _text.Length && (SyntaxUtils.IsIdentPart(_text[_pos])))
+                    ++_pos;
+                string literal = _text.Substring(start, _pos - start).TrimEnd('u', 'U', 'l', 'L');
+                try
+                {
+                    if (literal.StartsWith("0x", StringComparison.OrdinalIgnoreCase))
+                        return (Convert.ToInt64(literal.Substring(2), 16));
+                    else if (literal.StartsWith("0b", StringComparison.OrdinalIgnoreCase))
+                        return (Convert.ToInt64(literal.Substring(2), 2));
+                    else if (literal.Length > 1 && literal[0] == '0')
+                        return (Convert.ToInt64(literal.Substring(1), 8));
+                    return (long.Parse(literal));
+                }
+                catch (Exception e) when (e is FormatException || e is OverflowException || e is ArgumentException)
+                {
+                    throw new FormatException($"Invalid number '{literal}' in preprocessor expression");
+                }
+            }
+
+            private long ParseChar()
+            {
+                ++_pos;
+                long result = 0;
+                if (Peek() == '\\')
+                {
+                    ++_pos;
+                    char e = Peek();
+                    ++_pos;
+                    switch (e)
+                    {
+                        case 'n': result = '\n'; break;
+                        case 'r': result = '\r'; break;
+                        case 't': result = '\t'; break;
+                        case '0': result = 0; break;
+                        default: result = e; break;
+                    }
+                }
+                else
+                {
+                    result = Peek();
+                    ++_pos;
+                }
+                if (Peek() != '\'')
+                    throw new FormatException("Unterminated char literal in preprocessor expression");
+                ++_pos;
+                return (result);
+            }
+        }
+    }
+}
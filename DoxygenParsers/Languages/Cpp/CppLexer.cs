@@ -1,4 +1,5 @@
-﻿using System.Collections.Generic;
+﻿using System;
+using System.Collections.Generic;
 using System.Diagnostics;
 using System.Text;
 using TSP.DoxygenEditor.Languages.Doxygen;
@@ -188,6 +189,11 @@ namespace TSP.DoxygenEditor.Languages.Cpp
         {
 
             public readonly PreprocessorState Preprocessor = new PreprocessorState();
+            public readonly CppConditionalEvaluator Conditionals;
+            public CppLexerState(CppPreprocessorDefines defines)
+            {
+                Conditionals = defines != null ? new CppConditionalEvaluator(defines) : null;
+            }
             public override void StartLex(ITextStream stream)
             {
             }
@@ -195,14 +201,46 @@ namespace TSP.DoxygenEditor.Languages.Cpp
 
         protected override State CreateState()
         {
-            return new CppLexerState();
+            return new CppLexerState(_defines);
         }
 
-        private readonly LanguageKind _lang;
+        public enum LexMode
+        {
+            // Every character is tokenized
+            Full,
+            // Function bodies are skipped by a fast bracket scan and replaced by a single SkippedBody token
+            DeclarationsOnly,
+        }
 
-        public CppLexer(string source, int index, int length, TextPosition pos, LanguageKind lang) : base(source, index, length, pos)
+        private readonly LanguageKind _lang;
+        private readonly LexMode _mode;
+        private readonly CppPreprocessorDefines _defines;
+        private CppTokenKind _lastSignificantKind = CppTokenKind.Unknown;
+
+        // Declaration head tracking for DeclarationsOnly, so that only bodies of function declarators are skipped
+        private static readonly string[] ClassKeys = new string[] { "struct", "class", "union", "enum" };
+        private static readonly string[] AttributeKeywords = new string[] { "__attribute__", "__declspec", "alignas", "_Alignas", "__pragma", "_Pragma" };
+        private int _headParenDepth = 0;
+        private bool _isClassHead = false;
+        private int _classHeadNameCount = 0;
+        private bool _isFunctionNameCandidate = false;
+        private bool _isFunctionParen = false;
+        private bool _isFunctionDeclarator = false;
+
+        /// <summary>
+        /// Creates a C/C++ lexer. When defines are passed, #if/#elif/#else branches are evaluated against it and inactive regions are skipped.
+        /// </summary>
+        public CppLexer(string source, int index, int length, TextPosition pos, LanguageKind lang, LexMode mode, CppPreprocessorDefines defines) : base(source, index, length, pos)
         {
             _lang = lang;
+            _mode = mode;
+            _defines = defines;
+        }
+        public CppLexer(string source, int index, int length, TextPosition pos, LanguageKind lang, LexMode mode) : this(source, index, length, pos, lang, mode, null)
+        {
+        }
+        public CppLexer(string source, int index, int length, TextPosition pos, LanguageKind lang) : this(source, index, length, pos, lang, LexMode.Full)
+        {
         }
         public enum LexCompletion
         {
@@ -656,6 +694,8 @@ namespace TSP.DoxygenEditor.Languages.Cpp
 
             state.Preprocessor.Start();
 
+            int directiveStart = Buffer.StreamPosition;
+
             // Preprocessor start
             Buffer.StartLexeme();
             Buffer.AdvanceColumn();
@@ -912,6 +952,13 @@ namespace TSP.DoxygenEditor.Languages.Cpp
                                             CppToken includeToken = CppTokenPool.Make(_lang, CppTokenKind.PreprocessorInclude, Buffer.LexemeRange, isComplete);
                                             PushToken(includeToken);
                                         }
+                                        else if (SyntaxUtils.IsIdentStart(n))
+                                        {
+                                            // Computed include (#include FOO_H), the macro is resolved by whoever follows the include
+                                            LexResult macroResult = LexIdent(false);
+                                            CppToken includeToken = CppTokenPool.Make(_lang, CppTokenKind.PreprocessorInclude, Buffer.LexemeRange, macroResult.IsComplete);
+                                            PushToken(includeToken);
+                                        }
                                         else
                                         {
                                             AddError(Buffer.TextPosition, $"Unsupported include character '{n}'", "Include");
@@ -961,9 +1008,424 @@ preprocessorDone:
 
             PushToken(CppTokenPool.Make(_lang, CppTokenKind.PreprocessorEnd, new TextRange(Buffer.TextPosition, 0), true));
 
+            if (state.Conditionals != null)
+            {
+                string directive = Buffer.GetSourceText(directiveStart, Buffer.StreamPosition - directiveStart);
+                string error;
+                bool isActive = state.Conditionals.ProcessDirective(directive, out error);
+                if (error != null)
+                    AddError(Buffer.TextPosition, error, "Preprocessor");
+                if (!isActive)
+                    LexInactiveRegion();
+            }
+
             return (true);
         }
 
+        private static int FindDirectiveKeyword(ReadOnlySpan<char> span, int lineStart, out ReadOnlySpan<char> keyword)
+        {
+            keyword = ReadOnlySpan<char>.Empty;
+            int i = lineStart;
+            while (i < span.Length && (span[i] == ' ' || span[i] == '\t'))
+                ++i;
+            if (i >= span.Length || span[i] != '#')
+                return (-1);
+            ++i;
+            while (i < span.Length && (span[i] == ' ' || span[i] == '\t'))
+                ++i;
+            int identStart = i;
+            while (i < span.Length && SyntaxUtils.IsIdentPart(span[i]))
+                ++i;
+            keyword = span.Slice(identStart, i - identStart);
+            return (i);
+        }
+
+        private static readonly char[] InactiveRegionChars = new char[] { '\r', '\n', '/', '"', '\'' };
+
+        /// <summary>
+        /// Skips an inactive conditional region up to the start of the line containing the matching #elif, #else or #endif.
+        /// Only line starts, multi-line comments and literals are looked at, the skipped code is pushed as a single token.
+        /// </summary>
+        private void LexInactiveRegion()
+        {
+            TextPosition start = Buffer.TextPosition;
+            int streamOnePastEnd = Buffer.StreamBase + Buffer.StreamLength;
+            ReadOnlySpan<char> span = Buffer.GetSourceSpan(start.Index, streamOnePastEnd - start.Index);
+            int depth = 0;
+            int lineCount = 0;
+            int lineStart = 0;
+            int i = 0;
+            bool atLineStart = start.Column == 0;
+            bool inComment = false;
+            while (i < span.Length)
+            {
+                if (atLineStart && !inComment)
+                {
+                    ReadOnlySpan<char> keyword;
+                    if (FindDirectiveKeyword(span, i, out keyword) >= 0)
+                    {
+                        if (keyword.SequenceEqual("if") || keyword.SequenceEqual("ifdef") || keyword.SequenceEqual("ifndef"))
+                            ++depth;
+                        else if (keyword.SequenceEqual("endif"))
+                        {
+                            if (depth == 0)
+                                break;
+                            --depth;
+                        }
+                        else if ((keyword.SequenceEqual("elif") || keyword.SequenceEqual("else")) && depth == 0)
+                            break;
+                    }
+                }
+                atLineStart = false;
+
+                // Search the next line start, multi-line comments may hide a directive
+                while (i < span.Length)
+                {
+                    int next = inComment ? span.Slice(i).IndexOfAny('\r', '\n', '*') : span.Slice(i).IndexOfAny(InactiveRegionChars);
+                    if (next < 0)
+                    {
+                        i = span.Length;
+                        break;
+                    }
+                    i += next;
+                    char c = span[i];
+                    char n = i + 1 < span.Length ? span[i + 1] : TextStream.InvalidCharacter;
+                    if (SyntaxUtils.IsLineBreak(c))
+                    {
+                        i += SyntaxUtils.GetLineBreakChars(c, n);
+                        ++lineCount;
+                        lineStart = i;
+                        atLineStart = true;
+                        break;
+                    }
+                    else if (inComment && c == '*' && n == '/')
+                    {
+                        inComment = false;
+                        i += 2;
+                    }
+                    else if (!inComment && c == '/' && n == '*')
+                    {
+                        inComment = true;
+                        i += 2;
+                    }
+                    else if (!inComment && c == '/' && n == '/')
+                    {
+                        int lineEnd = span.Slice(i).IndexOfAny('\r', '\n');
+                        i = lineEnd < 0 ? span.Length : i + lineEnd;
+                    }
+                    else if (!inComment && (c == '"' || c == '\''))
+                    {
+                        // Strings and chars ends at the closing quote or at the end of the line, so a "/*" inside does not start a comment
+                        ++i;
+                        while (i < span.Length && span[i] != c && !SyntaxUtils.IsLineBreak(span[i]))
+                        {
+                            if (span[i] == '\\' && i + 1 < span.Length && !SyntaxUtils.IsLineBreak(span[i + 1]))
+                                ++i;
+                            ++i;
+                        }
+                        if (i < span.Length && span[i] == c)
+                            ++i;
+                    }
+                    else
+                        ++i;
+                }
+            }
+
+            if (i == 0)
+                return;
+            Buffer.StartLexeme();
+            SeekForward(start, span, lineCount, lineStart, i);
+            PushToken(CppTokenPool.Make(_lang, CppTokenKind.PreprocessorInactive, Buffer.LexemeRange, true));
+        }
+
+        private static readonly char[] SkippedBodyChars = new char[] { '{', '}', '"', '\'', '/', '#', '\r', '\n' };
+
+        private static bool IsRawStringPrefix(ReadOnlySpan<char> span, int quoteIndex)
+        {
+            // R"delim(...)delim", optionally with a u8, u, U or L encoding prefix
+            int r = quoteIndex - 1;
+            if (r < 0 || span[r] != 'R')
+                return (false);
+            int prefixStart = r;
+            if (prefixStart >= 2 && span[prefixStart - 2] == 'u' && span[prefixStart - 1] == '8')
+                prefixStart -= 2;
+            else if (prefixStart >= 1 && (span[prefixStart - 1] == 'u' || span[prefixStart - 1] == 'U' || span[prefixStart - 1] == 'L'))
+                prefixStart -= 1;
+            return (prefixStart == 0 || !SyntaxUtils.IsIdentPart(span[prefixStart - 1]));
+        }
+
+        private LexResult LexSkippedBody()
+        {
+            Debug.Assert(Buffer.Peek() == '{');
+            TextPosition start = Buffer.TextPosition;
+            int streamOnePastEnd = Buffer.StreamBase + Buffer.StreamLength;
+            ReadOnlySpan<char> span = Buffer.GetSourceSpan(start.Index, streamOnePastEnd - start.Index);
+            int depth = 0;
+            int lineCount = 0;
+            int lineStart = 0;
+            int i = 0;
+            bool isComplete = false;
+
+            // @NOTE(final): Braces of #if/#elif/#else arms are counted for the first arm only, the other arms usually repeat the same opening lines
+            Stack<KeyValuePair<int, int>> conditionals = null;
+
+            while (i < span.Length && !isComplete)
+            {
+                int next = span.Slice(i).IndexOfAny(SkippedBodyChars);
+                if (next < 0)
+                {
+                    i = span.Length;
+                    break;
+                }
+                i += next;
+                char c = span[i];
+                char n = i + 1 < span.Length ? span[i + 1] : TextStream.InvalidCharacter;
+                switch (c)
+                {
+                    case '{':
+                        ++depth;
+                        ++i;
+                        break;
+
+                    case '}':
+                        ++i;
+                        if (--depth == 0)
+                            isComplete = true;
+                        break;
+
+                    case '\r':
+                    case '\n':
+                        i += SyntaxUtils.GetLineBreakChars(c, n);
+                        ++lineCount;
+                        lineStart = i;
+                        break;
+
+                    case '#':
+                        {
+                            ++i;
+                            if (!span.Slice(lineStart, i - 1 - lineStart).IsWhiteSpace())
+                                break;
+                            int directiveStart = i;
+                            while (directiveStart < span.Length && SyntaxUtils.IsSpacing(span[directiveStart]))
+                                ++directiveStart;
+                            int directiveEnd = directiveStart;
+                            while (directiveEnd < span.Length && SyntaxUtils.IsIdentPart(span[directiveEnd]))
+                                ++directiveEnd;
+                            ReadOnlySpan<char> directive = span.Slice(directiveStart, directiveEnd - directiveStart);
+                            if (directive.SequenceEqual("if") || directive.SequenceEqual("ifdef") || directive.SequenceEqual("ifndef"))
+                            {
+                                if (conditionals == null)
+                                    conditionals = new Stack<KeyValuePair<int, int>>();
+                                conditionals.Push(new KeyValuePair<int, int>(depth, -1));
+                            }
+                            else if ((directive.SequenceEqual("elif") || directive.SequenceEqual("else")) && conditionals != null && conditionals.Count > 0)
+                            {
+                                KeyValuePair<int, int> conditional = conditionals.Pop();
+                                int firstArmEndDepth = conditional.Value == -1 ? depth : conditional.Value;
+                                conditionals.Push(new KeyValuePair<int, int>(conditional.Key, firstArmEndDepth));
+                                depth = conditional.Key;
+                            }
+                            else if (directive.SequenceEqual("endif") && conditionals != null && conditionals.Count > 0)
+                            {
+                                KeyValuePair<int, int> conditional = conditionals.Pop();
+                                if (conditional.Value != -1)
+                                    depth = conditional.Value;
+                            }
+                            i = directiveEnd;
+                        }
+                        break;
+
+                    case '"':
+                        if (IsRawStringPrefix(span, i))
+                        {
+                            // Raw strings end at )delim" only and may contain anything, including line breaks
+                            int delimiterStart = i + 1;
+                            int openParen = span.Slice(delimiterStart).IndexOf('(');
+                            if (openParen < 0 || openParen > 16)
+                            {
+                                ++i;
+                                break;
+                            }
+                            ReadOnlySpan<char> delimiter = span.Slice(delimiterStart, openParen);
+                            int contentStart = delimiterStart + openParen + 1;
+                            int end = contentStart;
+                            while (true)
+                            {
+                                int closeParen = span.Slice(end).IndexOf(')');
+                                if (closeParen < 0)
+                                {
+                                    end = span.Length;
+                                    break;
+                                }
+                                end += closeParen + 1;
+                                if (span.Slice(end).StartsWith(delimiter) && end + delimiter.Length < span.Length && span[end + delimiter.Length] == '"')
+                                {
+                                    end += delimiter.Length + 1;
+                                    break;
+                                }
+                            }
+                            for (int k = i; k < end; ++k)
+                            {
+                                char r = span[k];
+                                if (SyntaxUtils.IsLineBreak(r))
+                                {
+                                    int lb = SyntaxUtils.GetLineBreakChars(r, k + 1 < span.Length ? span[k + 1] : TextStream.InvalidCharacter);
+                                    k += lb - 1;
+                                    ++lineCount;
+                                    lineStart = k + 1;
+                                }
+                            }
+                            i = end;
+                            break;
+                        }
+                        goto case '\'';
+
+                    case '\'':
+                        {
+                            // Strings and chars ends at the closing quote or at the end of the line
+                            ++i;
+                            while (i < span.Length)
+                            {
+                                char s = span[i];
+                                if (s == c)
+                                {
+                                    ++i;
+                                    break;
+                                }
+                                else if (SyntaxUtils.IsLineBreak(s))
+                                    break;
+                                else if (s == '\\' && i + 1 < span.Length && !SyntaxUtils.IsLineBreak(span[i + 1]))
+                                    i += 2;
+                                else
+                                    ++i;
+                            }
+                        }
+                        break;
+
+                    case '/':
+                        {
+                            if (n == '/')
+                            {
+                                // Single line comment, the line break is handled in the next iteration
+                                int lineEnd = span.Slice(i).IndexOfAny('\r', '\n');
+                                i = lineEnd < 0 ? span.Length : i + lineEnd;
+                            }
+                            else if (n == '*')
+                            {
+                                i += 2;
+                                while (i < span.Length)
+                                {
+                                    char m = span[i];
+                                    if (m == '*' && i + 1 < span.Length && span[i + 1] == '/')
+                                    {
+                                        i += 2;
+                                        break;
+                                    }
+                                    else if (SyntaxUtils.IsLineBreak(m))
+                                    {
+                                        i += SyntaxUtils.GetLineBreakChars(m, i + 1 < span.Length ? span[i + 1] : TextStream.InvalidCharacter);
+                                        ++lineCount;
+                                        lineStart = i;
+                                    }
+                                    else
+                                        ++i;
+                                }
+                            }
+                            else
+                                ++i;
+                        }
+                        break;
+                }
+            }
+
+            SeekForward(start, span, lineCount, lineStart, i);
+            return new LexResult(CppTokenKind.SkippedBody, isComplete);
+        }
+
+        private void SeekForward(TextPosition start, ReadOnlySpan<char> span, int lineCount, int lineStart, int end)
+        {
+            // Jump to the start of the last line and advance the remaining columns, so that tabs are counted the same way as everywhere else
+            if (lineCount > 0)
+                Buffer.Seek(new TextPosition(start.Index + lineStart, start.Line + lineCount, 0));
+            else
+                lineStart = 0;
+            for (int k = lineStart; k < end; ++k)
+            {
+                if (span[k] == '\t')
+                    Buffer.AdvanceTab();
+                else
+                    Buffer.AdvanceColumn();
+            }
+        }
+
+        private static bool IsAnyOf(ReadOnlySpan<char> ident, string[] keywords)
+        {
+            foreach (string keyword in keywords)
+            {
+                if (ident.SequenceEqual(keyword))
+                    return (true);
+            }
+            return (false);
+        }
+
+        /// <summary>
+        /// Tracks whether a closing parenthesis belongs to a function declarator, like "void f(int a)" or "struct X *f(void)".
+        /// Parentheses owned by attributes (__attribute__((packed)), alignas(8)) or by the first name after a class key (typedef struct PACKED(X)) do not.
+        /// </summary>
+        private void TrackDeclarationHead(CppTokenKind kind)
+        {
+            bool isFunctionDeclarator = false;
+            switch (kind)
+            {
+                case CppTokenKind.LeftParen:
+                    if (_headParenDepth == 0)
+                        _isFunctionParen = _isFunctionNameCandidate || _isFunctionDeclarator;
+                    ++_headParenDepth;
+                    break;
+
+                case CppTokenKind.RightParen:
+                    if (_headParenDepth > 0 && --_headParenDepth == 0)
+                        isFunctionDeclarator = _isFunctionParen;
+                    break;
+
+                case CppTokenKind.Semicolon:
+                case CppTokenKind.LeftBrace:
+                case CppTokenKind.RightBrace:
+                case CppTokenKind.SkippedBody:
+                    if (_headParenDepth == 0)
+                    {
+                        _isClassHead = false;
+                        _classHeadNameCount = 0;
+                    }
+                    break;
+
+                case CppTokenKind.IdentLiteral:
+                case CppTokenKind.ReservedKeyword:
+                case CppTokenKind.GlobalTypeKeyword:
+                    if (_headParenDepth == 0)
+                    {
+                        ReadOnlySpan<char> ident = Buffer.GetSourceSpan(Buffer.LexemeStart.Index, Buffer.LexemeWidth);
+                        if (IsAnyOf(ident, ClassKeys))
+                        {
+                            _isClassHead = true;
+                            _classHeadNameCount = 0;
+                        }
+                        else if (!IsAnyOf(ident, AttributeKeywords))
+                        {
+                            if (_isClassHead)
+                                ++_classHeadNameCount;
+                            _isFunctionNameCandidate = !_isClassHead || _classHeadNameCount >= 2;
+                            _isFunctionDeclarator = false;
+                            return;
+                        }
+                    }
+                    break;
+            }
+            if (_headParenDepth == 0)
+                _isFunctionNameCandidate = false;
+            _isFunctionDeclarator = isFunctionDeclarator;
+        }
+
         protected override bool LexNext(State hiddenState)
         {
             CppLexerState state = (CppLexerState)hiddenState;
@@ -1241,6 +1703,8 @@ preprocessorDone:
                     break;
 
                 case '#':
+                    _lastSignificantKind = CppTokenKind.PreprocessorEnd;
+                    _isFunctionDeclarator = false;
                     return LexPreprocessor(state);
 
                 case '"':
@@ -1276,8 +1740,18 @@ preprocessorDone:
                     Buffer.AdvanceColumn();
                     break;
                 case '{':
-                    lexRes.Kind = CppTokenKind.LeftBrace;
-                    Buffer.AdvanceColumn();
+                    if (_mode == LexMode.DeclarationsOnly && _lastSignificantKind == CppTokenKind.RightParen && _isFunctionDeclarator)
+                    {
+                        // @NOTE(final): Only bodies following the closing parenthesis of a function declarator are skipped, struct/enum/union bodies are still needed for their declarations
+                        lexRes = LexSkippedBody();
+                        if (!lexRes.IsComplete)
+                            AddError(Buffer.LexemeStart, "Unterminated function body!", what: lexRes.Kind.ToString());
+                    }
+                    else
+                    {
+                        lexRes.Kind = CppTokenKind.LeftBrace;
+                        Buffer.AdvanceColumn();
+                    }
                     break;
                 case '}':
                     lexRes.Kind = CppTokenKind.RightBrace;
@@ -1339,6 +1813,21 @@ preprocessorDone:
                     }
                     break;
             }
+            switch (lexRes.Kind)
+            {
+                case CppTokenKind.Spacings:
+                case CppTokenKind.EndOfLine:
+                case CppTokenKind.SingleLineComment:
+                case CppTokenKind.SingleLineCommentDoc:
+                case CppTokenKind.MultiLineComment:
+                case CppTokenKind.MultiLineCommentDoc:
+                    break;
+                default:
+                    _lastSignificantKind = lexRes.Kind;
+                    if (_mode == LexMode.DeclarationsOnly)
+                        TrackDeclarationHead(lexRes.Kind);
+                    break;
+            }
             return PushToken(CppTokenPool.Make(_lang, lexRes.Kind, Buffer.LexemeRange, lexRes.IsComplete), lexRes.Intern);
         }
     }
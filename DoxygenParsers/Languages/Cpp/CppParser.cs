@@ -687,11 +687,11 @@ namespace TSP.DoxygenEditor.Languages.Cpp
             functionIdentToken.Kind = CppTokenKind.FunctionIdent;
 
             CppEntityKind kind = CppEntityKind.FunctionCall;
-            SearchResult<CppToken> endingTokenResult = Search(stream, SearchMode.Current, CppTokenKind.LeftBrace, CppTokenKind.Semicolon);
+            SearchResult<CppToken> endingTokenResult = Search(stream, SearchMode.Current, CppTokenKind.LeftBrace, CppTokenKind.SkippedBody, CppTokenKind.Semicolon);
             if (endingTokenResult != null)
             {
                 stream.Next();
-                if (endingTokenResult.Token.Kind == CppTokenKind.LeftBrace)
+                if (endingTokenResult.Token.Kind == CppTokenKind.LeftBrace || endingTokenResult.Token.Kind == CppTokenKind.SkippedBody)
                 {
                     kind = CppEntityKind.FunctionBody;
                     if (Configuration.ExcludeFunctionBodies)
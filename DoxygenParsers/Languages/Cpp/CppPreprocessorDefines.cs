@@ -0,0 +1,78 @@
+﻿using System;
+using System.Collections.Generic;
+
+namespace TSP.DoxygenEditor.Languages.Cpp
+{
+    /// <summary>
+    /// Set of preprocessor defines used to evaluate #if/#ifdef conditions, e.g. the defines configured in a workspace.
+    /// A define without a value is stored with an empty value, function-like macros are stored with a null value.
+    /// </summary>
+    public class CppPreprocessorDefines
+    {
+        private readonly Dictionary<string, string> _defines = new Dictionary<string, string>();
+
+        public int Count => _defines.Count;
+        public IEnumerable<string> Names => _defines.Keys;
+
+        public CppPreprocessorDefines()
+        {
+        }
+
+        public CppPreprocessorDefines(CppPreprocessorDefines other)
+        {
+            if (other == null)
+                throw new ArgumentNullException("Other may not be null");
+            foreach (KeyValuePair<string, string> definePair in other._defines)
+                _defines.Add(definePair.Key, definePair.Value);
+        }
+
+        /// <summary>
+        /// Creates a define set from a list of "NAME" or "NAME=VALUE" strings, like the -D compiler arguments.
+        /// </summary>
+        public static CppPreprocessorDefines Parse(IEnumerable<string> defines)
+        {
+            CppPreprocessorDefines result = new CppPreprocessorDefines();
+            if (defines != null)
+            {
+                foreach (string define in defines)
+                {
+                    if (string.IsNullOrWhiteSpace(define))
+                        continue;
+                    int equalsIndex = define.IndexOf('=');
+                    if (equalsIndex > 0)
+                        result.Define(define.Substring(0, equalsIndex).Trim(), define.Substring(equalsIndex + 1).Trim());
+                    else if (equalsIndex < 0)
+                        result.Define(define.Trim(), string.Empty);
+                }
+            }
+            return (result);
+        }
+
+        public void Define(string name, string value)
+        {
+            if (string.IsNullOrWhiteSpace(name))
+                throw new ArgumentNullException("Name may not be null or empty");
+            _defines[name] = value;
+        }
+
+        public void Undefine(string name)
+        {
+            _defines.Remove(name);
+        }
+
+        public bool IsDefined(string name)
+        {
+            return (_defines.ContainsKey(name));
+        }
+
+        public bool TryGetValue(string name, out string value)
+        {
+            return (_defines.TryGetValue(name, out value));
+        }
+
+        public void Clear()
+        {
+            _defines.Clear();
+        }
+    }
+}
@@ -29,6 +29,8 @@ namespace TSP.DoxygenEditor.Languages.Cpp
         PreprocessorDefineArgument,
         PreprocessorInclude,
         PreprocessorEnd,
+        // Entire region of a #if/#elif/#else branch that is not active for the current defines
+        PreprocessorInactive,
 
         IdentLiteral,
         ReservedKeyword,
@@ -144,6 +146,9 @@ namespace TSP.DoxygenEditor.Languages.Cpp
         [TokenKind(Text = ":")]
         Colon,
 
+        // Placeholder for a entire function body, skipped in declarations-only mode
+        SkippedBody,
+
         COUNT,
     }
 }
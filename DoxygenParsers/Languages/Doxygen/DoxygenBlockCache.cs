@@ -0,0 +1,439 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Runtime.CompilerServices;
+using TSP.DoxygenEditor.Languages.Cpp;
+using TSP.DoxygenEditor.Languages.Html;
+using TSP.DoxygenEditor.Lexers;
+using TSP.DoxygenEditor.Parsers;
+using TSP.DoxygenEditor.Symbols;
+using TSP.DoxygenEditor.TextAnalysis;
+
+namespace TSP.DoxygenEditor.Languages.Doxygen
+{
+    /// <summary>
+    /// Per-editor cache of the tokens, errors and parsed subtree of documentation blocks, keyed by the hash of the block text.
+    /// Unchanged blocks are rebased to their new offset instead of being lexed and parsed again.
+    /// Entries which are not used by a parse are evicted in <see cref="EndParse"/>.
+    /// </summary>
+    public class DoxygenBlockCache
+    {
+        struct BlockKey : IEquatable<BlockKey>
+        {
+            public int Hash { get; }
+            public int Length { get; }
+            public int Column { get; }
+            public BlockKey(int hash, int length, int column)
+            {
+                Hash = hash;
+                Length = length;
+                Column = column;
+            }
+            public bool Equals(BlockKey other) => Hash == other.Hash && Length == other.Length && Column == other.Column;
+            public override bool Equals(object obj) => obj is BlockKey other && Equals(other);
+            public override int GetHashCode() => HashCode.Combine(Hash, Length, Column);
+        }
+
+        enum CachedTokenType
+        {
+            Doxygen,
+            Cpp,
+            Html,
+        }
+
+        struct CachedToken
+        {
+            public CachedTokenType Type;
+            public LanguageKind Lang;
+            public int Kind;
+            public TextRange Range;
+            public bool IsComplete;
+            public string Value;
+            // Command id for doxygen tokens, tag or attribute id for html tokens
+            public int NameId;
+        }
+
+        struct CachedSymbol
+        {
+            public bool IsSource;
+            public LanguageKind Lang;
+            public int Kind;
+            public string Name;
+            public string Caption;
+            public TextRange Range;
+            public IBaseNode Node;
+        }
+
+        class ParsedBlock
+        {
+            public TextPosition Position;
+            public DoxygenBlockNode Node;
+            public int NodeCount;
+            public Dictionary<DoxygenBlockEntity.Parameter, int> ParameterTokens;
+            public CachedSymbol[] Symbols;
+            public TextError[] Errors;
+        }
+
+        class Entry
+        {
+            public string Text;
+            public TextPosition Position;
+            public CachedToken[] Tokens;
+            public TextError[] Errors;
+            public ParsedBlock Parsed;
+            public int Generation;
+        }
+
+        class BlockInstance
+        {
+            public Entry Entry;
+            public TextPosition Position;
+            public List<IBaseToken> Tokens;
+            public IBaseToken EndToken;
+        }
+
+        public class RebasedBlock
+        {
+            public DoxygenBlockNode Node { get; }
+            public int NodeCount { get; }
+            public IBaseToken EndToken { get; }
+            public IEnumerable<BaseSymbol> Symbols { get; }
+            public IEnumerable<TextError> Errors { get; }
+            public RebasedBlock(DoxygenBlockNode node, int nodeCount, IBaseToken endToken, IEnumerable<BaseSymbol> symbols, IEnumerable<TextError> errors)
+            {
+                Node = node;
+                NodeCount = nodeCount;
+                EndToken = endToken;
+                Symbols = symbols;
+                Errors = errors;
+            }
+        }
+
+        private readonly Dictionary<BlockKey, Entry> _entries = new Dictionary<BlockKey, Entry>();
+        private readonly Dictionary<IBaseToken, BlockInstance> _instances = new Dictionary<IBaseToken, BlockInstance>();
+        private int _generation = 0;
+
+        public int Count => _entries.Count;
+        public int TokenHits { get; private set; }
+        public int ParseHits { get; private set; }
+
+        /// <summary>
+        /// Estimated number of bytes held by the block texts and cached tokens, updated in <see cref="EndParse"/>.
+        /// </summary>
+        public long EstimatedSize { get; private set; }
+
+        public void Clear()
+        {
+            _entries.Clear();
+            _instances.Clear();
+            EstimatedSize = 0;
+        }
+
+        /// <summary>
+        /// Starts a new parse of the whole source, all blocks must be added or found again to stay in the cache.
+        /// </summary>
+        public void BeginParse()
+        {
+            ++_generation;
+            _instances.Clear();
+            TokenHits = ParseHits = 0;
+        }
+
+        /// <summary>
+        /// Evicts all entries that were not used since <see cref="BeginParse"/>.
+        /// The block instances are kept, because the parser needs them after tokenization.
+        /// </summary>
+        public void EndParse()
+        {
+            List<BlockKey> unusedKeys = new List<BlockKey>();
+            long estimatedSize = 0;
+            foreach (KeyValuePair<BlockKey, Entry> entryPair in _entries)
+            {
+                Entry entry = entryPair.Value;
+                if (entry.Generation != _generation)
+                    unusedKeys.Add(entryPair.Key);
+                else
+                    estimatedSize += entry.Text.Length * sizeof(char) + entry.Tokens.Length * Unsafe.SizeOf<CachedToken>();
+            }
+            EstimatedSize = estimatedSize;
+            foreach (BlockKey key in unusedKeys)
+                _entries.Remove(key);
+        }
+
+        private static BlockKey MakeKey(ReadOnlySpan<char> text, TextPosition pos)
+        {
+            return new BlockKey(string.GetHashCode(text), text.Length, pos.Column);
+        }
+
+        private static TextPosition Rebase(TextPosition p, int indexDelta, int lineDelta)
+        {
+            return new TextPosition(p.Index + indexDelta, p.Line + lineDelta, p.Column);
+        }
+        private static TextRange Rebase(TextRange r, int indexDelta, int lineDelta)
+        {
+            return new TextRange(Rebase(r.Position, indexDelta, lineDelta), r.Length);
+        }
+
+        private void AddInstance(Entry entry, TextPosition pos, List<IBaseToken> tokens)
+        {
+            IBaseToken startToken = null;
+            IBaseToken endToken = null;
+            foreach (IBaseToken token in tokens)
+            {
+                DoxygenToken doxyToken = token as DoxygenToken;
+                if (doxyToken == null)
+                    continue;
+                if (startToken == null && (doxyToken.Kind == DoxygenTokenKind.DoxyBlockStartSingle || doxyToken.Kind == DoxygenTokenKind.DoxyBlockStartMulti))
+                    startToken = doxyToken;
+                else if (doxyToken.Kind == DoxygenTokenKind.DoxyBlockEnd)
+                    endToken = doxyToken;
+            }
+            if (startToken != null && endToken != null)
+                _instances[startToken] = new BlockInstance() { Entry = entry, Position = pos, Tokens = tokens, EndToken = endToken };
+        }
+
+        /// <summary>
+        /// Returns new tokens and errors for the documentation block in the given range, when the same block text was tokenized before.
+        /// The errors are tagged with the given error tag, because the lexer which found them is gone.
+        /// </summary>
+        public bool TryGetTokens(string source, int index, int length, TextPosition pos, object errorTag, out List<IBaseToken> tokens, out List<TextError> errors)
+        {
+            tokens = null;
+            errors = null;
+            ReadOnlySpan<char> text = source.AsSpan(index, length);
+            Entry entry;
+            if (!_entries.TryGetValue(MakeKey(text, pos), out entry) || !text.SequenceEqual(entry.Text))
+                return (false);
+
+            int indexDelta = pos.Index - entry.Position.Index;
+            int lineDelta = pos.Line - entry.Position.Line;
+            tokens = new List<IBaseToken>(entry.Tokens.Length);
+            foreach (CachedToken cached in entry.Tokens)
+            {
+                TextRange range = Rebase(cached.Range, indexDelta, lineDelta);
+                BaseToken token;
+                switch (cached.Type)
+                {
+                    case CachedTokenType.Doxygen:
+                        token = DoxygenTokenPool.Make((DoxygenTokenKind)cached.Kind, range, cached.IsComplete, cached.NameId);
+                        break;
+                    case CachedTokenType.Cpp:
+                        token = CppTokenPool.Make(cached.Lang, (CppTokenKind)cached.Kind, range, cached.IsComplete);
+                        break;
+                    default:
+                        token = HtmlTokenPool.Make((HtmlTokenKind)cached.Kind, range, cached.IsComplete, cached.NameId);
+                        break;
+                }
+                token.Value = cached.Value;
+                tokens.Add(token);
+            }
+            errors = new List<TextError>(entry.Errors.Length);
+            foreach (TextError error in entry.Errors)
+                errors.Add(new TextError(Rebase(error.Pos, indexDelta, lineDelta), error.Category, error.Message, error.What, error.Symbol) { Tag = errorTag });
+
+            entry.Generation = _generation;
+            AddInstance(entry, pos, tokens);
+            ++TokenHits;
+            return (true);
+        }
+
+        /// <summary>
+        /// Adds the freshly lexed tokens and errors of the documentation block in the given range, including all nested code and html tokens.
+        /// </summary>
+        public void AddTokens(string source, int index, int length, TextPosition pos, List<IBaseToken> tokens, IEnumerable<TextError> errors)
+        {
+            if (tokens == null)
+                throw new ArgumentNullException("Tokens may not be null");
+            ReadOnlySpan<char> text = source.AsSpan(index, length);
+            CachedToken[] cachedTokens = new CachedToken[tokens.Count];
+            for (int i = 0; i < tokens.Count; ++i)
+            {
+                BaseToken token = tokens[i] as BaseToken;
+                if (token == null)
+                    return;
+                CachedToken cached = new CachedToken() { Lang = token.Lang, Range = token.Range, IsComplete = token.IsComplete, Value = token.Value };
+                if (token is DoxygenToken doxyToken)
+                {
+                    cached.Type = CachedTokenType.Doxygen;
+                    cached.Kind = (int)doxyToken.Kind;
+                    cached.NameId = doxyToken.CommandId;
+                }
+                else if (token is CppToken cppToken)
+                {
+                    cached.Type = CachedTokenType.Cpp;
+                    cached.Kind = (int)cppToken.Kind;
+                }
+                else if (token is HtmlToken htmlToken)
+                {
+                    cached.Type = CachedTokenType.Html;
+                    cached.Kind = (int)htmlToken.Kind;
+                    cached.NameId = htmlToken.NameId;
+                }
+                else
+                    return;
+                cachedTokens[i] = cached;
+            }
+            // Errors are cached without their tag, so the lexer is not kept alive by the cache
+            List<TextError> cachedErrors = new List<TextError>();
+            foreach (TextError error in errors)
+                cachedErrors.Add(new TextError(error.Pos, error.Category, error.Message, error.What, error.Symbol));
+
+            Entry entry = new Entry()
+            {
+                Text = text.ToString(),
+                Position = pos,
+                Tokens = cachedTokens,
+                Errors = cachedErrors.ToArray(),
+                Generation = _generation,
+            };
+            _entries[MakeKey(text, pos)] = entry;
+            AddInstance(entry, pos, tokens);
+        }
+
+        public bool ContainsParsedBlock(IBaseToken blockStartToken)
+        {
+            BlockInstance instance;
+            if (!_instances.TryGetValue(blockStartToken, out instance))
+                return (false);
+            return (instance.Entry.Parsed != null);
+        }
+
+        /// <summary>
+        /// Returns a rebased copy of the parsed subtree for the block which starts with the given token, or null when it was never parsed.
+        /// </summary>
+        public RebasedBlock RebaseParsedBlock(IBaseToken blockStartToken, IBaseNode parent, object errorTag)
+        {
+            BlockInstance instance;
+            if (!_instances.TryGetValue(blockStartToken, out instance))
+                return (null);
+            ParsedBlock parsed = instance.Entry.Parsed;
+            if (parsed == null)
+                return (null);
+
+            int indexDelta = instance.Position.Index - parsed.Position.Index;
+            int lineDelta = instance.Position.Line - parsed.Position.Line;
+            Dictionary<IBaseNode, IBaseNode> nodeMap = new Dictionary<IBaseNode, IBaseNode>(parsed.NodeCount);
+            DoxygenBlockNode node = CloneNode(parsed, parsed.Node, parent, instance.Tokens, indexDelta, lineDelta, nodeMap);
+
+            List<BaseSymbol> symbols = new List<BaseSymbol>(parsed.Symbols.Length);
+            foreach (CachedSymbol cached in parsed.Symbols)
+            {
+                IBaseNode symbolNode = null;
+                if (cached.Node != null)
+                    nodeMap.TryGetValue(cached.Node, out symbolNode);
+                TextRange range = Rebase(cached.Range, indexDelta, lineDelta);
+                if (cached.IsSource)
+                    symbols.Add(new SourceSymbol(cached.Lang, (SourceSymbolKind)cached.Kind, cached.Name, cached.Caption, range, symbolNode));
+                else
+                    symbols.Add(new ReferenceSymbol(cached.Lang, (ReferenceSymbolKind)cached.Kind, cached.Name, range, symbolNode));
+            }
+
+            List<TextError> errors = new List<TextError>(parsed.Errors.Length);
+            foreach (TextError error in parsed.Errors)
+                errors.Add(new TextError(Rebase(error.Pos, indexDelta, lineDelta), error.Category, error.Message, error.What, error.Symbol) { Tag = errorTag });
+
+            ++ParseHits;
+            return new RebasedBlock(node, parsed.NodeCount, instance.EndToken, symbols, errors);
+        }
+
+        private static DoxygenBlockNode CloneNode(ParsedBlock parsed, DoxygenBlockNode source, IBaseNode parent, List<IBaseToken> tokens, int indexDelta, int lineDelta, Dictionary<IBaseNode, IBaseNode> nodeMap)
+        {
+            DoxygenBlockEntity sourceEntity = source.Entity;
+            DoxygenBlockEntity entity = new DoxygenBlockEntity(sourceEntity.Kind, Rebase(sourceEntity.StartRange, indexDelta, lineDelta));
+            entity.EndRange = Rebase(sourceEntity.EndRange, indexDelta, lineDelta);
+            entity.Id = sourceEntity.Id;
+            entity.Value = sourceEntity.Value;
+            entity.Group = sourceEntity.Group;
+            foreach (DoxygenBlockEntity.Parameter parameter in sourceEntity.Parameters)
+            {
+                DoxygenToken token = (DoxygenToken)tokens[parsed.ParameterTokens[parameter]];
+                entity.AddParameter(token, parameter.Name, parameter.Value);
+            }
+            DoxygenBlockNode result = new DoxygenBlockNode(parent, entity);
+            nodeMap.Add(source, result);
+            foreach (IBaseNode child in source.Children)
+                result.AddChild(CloneNode(parsed, (DoxygenBlockNode)child, result, tokens, indexDelta, lineDelta, nodeMap));
+            return (result);
+        }
+
+        /// <summary>
+        /// Stores a copy of the parsed subtree, symbols and errors for the block which starts with the given token.
+        /// The copy is kept as a template and is never changed, because the parser may move the given subtree to another parent later.
+        /// Parameters are remembered by their token ordinal within the block.
+        /// </summary>
+        public void AddParsedBlock(IBaseToken blockStartToken, DoxygenBlockNode node, int nodeCount, IEnumerable<BaseSymbol> symbols, IEnumerable<TextError> errors)
+        {
+            BlockInstance instance;
+            if (!_instances.TryGetValue(blockStartToken, out instance))
+                return;
+
+            Dictionary<IBaseToken, int> tokenOrdinals = new Dictionary<IBaseToken, int>(instance.Tokens.Count);
+            for (int i = 0; i < instance.Tokens.Count; ++i)
+                tokenOrdinals[instance.Tokens[i]] = i;
+            Dictionary<DoxygenBlockEntity.Parameter, int> parameterTokens = new Dictionary<DoxygenBlockEntity.Parameter, int>();
+            if (!CollectParameterTokens(node, tokenOrdinals, parameterTokens))
+                return;
+
+            // The template has the same positions and tokens, so its parameters are collected again from the copy
+            ParsedBlock source = new ParsedBlock() { ParameterTokens = parameterTokens };
+            Dictionary<IBaseNode, IBaseNode> nodeMap = new Dictionary<IBaseNode, IBaseNode>(nodeCount);
+            DoxygenBlockNode template = CloneNode(source, node, null, instance.Tokens, 0, 0, nodeMap);
+            Dictionary<DoxygenBlockEntity.Parameter, int> templateParameterTokens = new Dictionary<DoxygenBlockEntity.Parameter, int>(parameterTokens.Count);
+            if (!CollectParameterTokens(template, tokenOrdinals, templateParameterTokens))
+                return;
+
+            List<CachedSymbol> cachedSymbols = new List<CachedSymbol>();
+            foreach (BaseSymbol symbol in symbols)
+            {
+                IBaseNode symbolNode = null;
+                if (symbol.Node != null)
+                    nodeMap.TryGetValue(symbol.Node, out symbolNode);
+                CachedSymbol cached = new CachedSymbol() { Lang = symbol.Lang, Name = symbol.Name, Range = symbol.Range, Node = symbolNode };
+                if (symbol is SourceSymbol sourceSymbol)
+                {
+                    cached.IsSource = true;
+                    cached.Kind = (int)sourceSymbol.Kind;
+                    cached.Caption = sourceSymbol.Caption;
+                }
+                else
+                {
+                    Debug.Assert(symbol is ReferenceSymbol);
+                    cached.Kind = (int)((ReferenceSymbol)symbol).Kind;
+                }
+                cachedSymbols.Add(cached);
+            }
+
+            List<TextError> cachedErrors = new List<TextError>();
+            foreach (TextError error in errors)
+                cachedErrors.Add(new TextError(error.Pos, error.Category, error.Message, error.What, error.Symbol));
+
+            instance.Entry.Parsed = new ParsedBlock()
+            {
+                Position = instance.Position,
+                Node = template,
+                NodeCount = nodeCount,
+                ParameterTokens = templateParameterTokens,
+                Symbols = cachedSymbols.ToArray(),
+                Errors = cachedErrors.ToArray(),
+            };
+        }
+
+        private static bool CollectParameterTokens(DoxygenBlockNode node, Dictionary<IBaseToken, int> tokenOrdinals, Dictionary<DoxygenBlockEntity.Parameter, int> parameterTokens)
+        {
+            foreach (DoxygenBlockEntity.Parameter parameter in node.Entity.Parameters)
+            {
+                int ordinal;
+                if (!tokenOrdinals.TryGetValue(parameter.Token, out ordinal))
+                    return (false);
+                parameterTokens.Add(parameter, ordinal);
+            }
+            foreach (IBaseNode child in node.Children)
+            {
+                DoxygenBlockNode childNode = child as DoxygenBlockNode;
+                if (childNode == null || !CollectParameterTokens(childNode, tokenOrdinals, parameterTokens))
+                    return (false);
+            }
+            return (true);
+        }
+    }
+}
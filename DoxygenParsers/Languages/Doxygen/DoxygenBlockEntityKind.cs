@@ -32,5 +32,6 @@
         Basic = 10000,
         Reference,
         Text,
+        Code,
     }
 }
@@ -64,19 +64,35 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
         {
             public TextPosition StartPos { get; }
             public DoxygenSyntax.CommandRule Rule { get; }
-            public string CommandName { get; }
+            public int CommandId => Rule != null ? Rule.Id : DoxygenSyntax.InvalidCommandId;
+            public int CommandLength { get; }
             public bool IsValid { get; set; }
             public List<CommandResultArgument> Arguments { get; }
+            public List<DoxygenToken> ArgTokens { get; }
             public DoxygenSyntax.CommandKind? Kind => Rule?.Kind;
-            public CommandResult(TextPosition startPos, DoxygenSyntax.CommandRule rule = null, string commandName = null)
+            public CommandResult(TextPosition startPos, int commandLength, DoxygenSyntax.CommandRule rule = null)
             {
                 StartPos = startPos;
+                CommandLength = commandLength;
                 Rule = rule;
-                CommandName = commandName;
                 Arguments = new List<CommandResultArgument>();
+                ArgTokens = new List<DoxygenToken>();
             }
         }
 
+        private void PushArgToken(CommandResult commandResult, DoxygenToken argToken)
+        {
+            PushToken(argToken);
+            commandResult.ArgTokens.Add(argToken);
+        }
+
+        private string GetCommandName(CommandResult commandResult)
+        {
+            // @NOTE(final): Only used for error messages, so the name is not allocated for every command
+            string result = Buffer.GetSourceText(commandResult.StartPos.Index + 1, commandResult.CommandLength - 1);
+            return (result);
+        }
+
         private CommandResult LexCommandTokens()
         {
             Debug.Assert(DoxygenSyntax.IsCommandBegin(Buffer.Peek()));
@@ -130,8 +146,8 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
 
             TextPosition commandStart = Buffer.LexemeStart;
             int commandLen = Buffer.LexemeWidth;
-            string commandName = Buffer.GetSourceText(Buffer.LexemeStart.Index + 1, commandLen - 1);
-            DoxygenSyntax.CommandRule rule = DoxygenSyntax.GetCommandRule(commandName);
+            int commandId = DoxygenSyntax.GetCommandId(Buffer.GetSourceSpan(Buffer.LexemeStart.Index + 1, commandLen - 1));
+            DoxygenSyntax.CommandRule rule = DoxygenSyntax.GetCommandRule(commandId);
             if (rule != null)
             {
                 if (rule.Kind == DoxygenSyntax.CommandKind.StartCommandBlock)
@@ -145,10 +161,10 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                 if (kind != DoxygenTokenKind.GroupStart && kind != DoxygenTokenKind.GroupEnd)
                     kind = DoxygenTokenKind.InvalidCommand;
             }
-            DoxygenToken commandToken = DoxygenTokenPool.Make(kind, Buffer.LexemeRange, true);
+            DoxygenToken commandToken = DoxygenTokenPool.Make(kind, Buffer.LexemeRange, true, commandId);
             PushToken(commandToken);
 
-            CommandResult result = new CommandResult(commandStart, rule, commandName);
+            CommandResult result = new CommandResult(commandStart, commandLen, rule);
 
             string whereName = "Command";
             if (rule != null)
@@ -215,22 +231,22 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                                     if (arg.IsOptional || foundPrefixToPostfix)
                                     {
                                         DoxygenToken argToken = DoxygenTokenPool.Make(DoxygenTokenKind.ArgumentCaption, Buffer.LexemeRange, foundPrefixToPostfix);
-                                        PushToken(argToken);
+                                        PushArgToken(result, argToken);
                                     }
                                     else if (arg.IsRequired)
                                     {
-                                        AddError(Buffer.TextPosition, $"Expected postfix '{postfix}' for argument ({argNumber}:{arg}) in command '{commandName}'", what: whereName, symbol: commandName);
+                                        AddError(Buffer.TextPosition, $"Expected postfix '{postfix}' for argument ({argNumber}:{arg}) in command '{GetCommandName(result)}'", what: whereName, symbol: GetCommandName(result));
                                         return (result);
                                     }
                                 }
                                 else if (arg.IsOptional)
                                 {
                                     DoxygenToken argToken = DoxygenTokenPool.Make(DoxygenTokenKind.ArgumentCaption, Buffer.LexemeRange, false);
-                                    PushToken(argToken);
+                                    PushArgToken(result, argToken);
                                 }
                                 else if (arg.IsRequired)
                                 {
-                                    AddError(Buffer.TextPosition, $"Expected prefix '{prefix}' for argument ({argNumber}:{arg}) in command '{commandName}'", what: whereName, symbol: commandName);
+                                    AddError(Buffer.TextPosition, $"Expected prefix '{prefix}' for argument ({argNumber}:{arg}) in command '{GetCommandName(result)}'", what: whereName, symbol: GetCommandName(result));
                                     return (result);
                                 }
                             }
@@ -312,7 +328,7 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                                                     }
                                                     if (!terminatedFunc)
                                                     {
-                                                        AddError(Buffer.TextPosition, $"Unterminated function reference for argument ({argNumber}:{arg}) in command '{commandName}'", what: whereName, symbol: commandName);
+                                                        AddError(Buffer.TextPosition, $"Unterminated function reference for argument ({argNumber}:{arg}) in command '{GetCommandName(result)}'", what: whereName, symbol: GetCommandName(result));
                                                         return (result);
                                                     }
                                                 }
@@ -321,7 +337,7 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                                             }
                                             else
                                             {
-                                                AddError(Buffer.TextPosition, $"Requires identifier, but found '{Buffer.Peek()}' for argument ({argNumber}:{arg}) in command '{commandName}'", what: whereName, symbol: commandName);
+                                                AddError(Buffer.TextPosition, $"Requires identifier, but found '{Buffer.Peek()}' for argument ({argNumber}:{arg}) in command '{GetCommandName(result)}'", what: whereName, symbol: GetCommandName(result));
                                                 return (result);
                                             }
                                         }
@@ -337,11 +353,11 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                                 if (arg.IsOptional || foundRef)
                                 {
                                     DoxygenToken argToken = DoxygenTokenPool.Make(DoxygenTokenKind.ArgumentIdent, Buffer.LexemeRange, foundRef);
-                                    PushToken(argToken);
+                                    PushArgToken(result, argToken);
                                 }
                                 else if (arg.IsRequired)
                                 {
-                                    AddError(Buffer.TextPosition, $"Unexpected character '{Buffer.Peek()}' for argument ({argNumber}:{arg}) in command '{commandName}'", what: whereName, symbol: commandName);
+                                    AddError(Buffer.TextPosition, $"Unexpected character '{Buffer.Peek()}' for argument ({argNumber}:{arg}) in command '{GetCommandName(result)}'", what: whereName, symbol: GetCommandName(result));
                                     return (result);
                                 }
                             }
@@ -352,7 +368,7 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                                 bool foundIdent = false;
 
                                 // Special handling for @param command and ... parameter
-                                if (!noMoreArgs && "param".Equals(commandName) && (arg.Kind == DoxygenSyntax.ArgumentKind.Identifier))
+                                if (!noMoreArgs && result.CommandId == DoxygenSyntax.ParamCommandId && (arg.Kind == DoxygenSyntax.ArgumentKind.Identifier))
                                 {
                                     if (Buffer.Peek() == '.')
                                     {
@@ -380,11 +396,11 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                                 if (arg.IsOptional || foundIdent)
                                 {
                                     DoxygenToken argToken = DoxygenTokenPool.Make(DoxygenTokenKind.ArgumentIdent, Buffer.LexemeRange, foundIdent);
-                                    PushToken(argToken);
+                                    PushArgToken(result, argToken);
                                 }
                                 else if (arg.IsRequired)
                                 {
-                                    AddError(Buffer.TextPosition, $"Unexpected character '{Buffer.Peek()}' for argument ({argNumber}:{arg}) in command '{commandName}'", what: whereName, symbol: commandName);
+                                    AddError(Buffer.TextPosition, $"Unexpected character '{Buffer.Peek()}' for argument ({argNumber}:{arg}) in command '{GetCommandName(result)}'", what: whereName, symbol: GetCommandName(result));
                                     return (result);
                                 }
                             }
@@ -417,7 +433,7 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                                         }
                                         if (!foundFilename)
                                         {
-                                            AddError(Buffer.TextPosition, $"Unterminated filename, expect quote char '{quoteChar}' but got '{Buffer.Peek()}' for argument ({argNumber}:{arg}) in command '{commandName}'", whereName, commandName);
+                                            AddError(Buffer.TextPosition, $"Unterminated filename, expect quote char '{quoteChar}' but got '{Buffer.Peek()}' for argument ({argNumber}:{arg}) in command '{GetCommandName(result)}'", whereName, GetCommandName(result));
                                             return (result);
                                         }
                                     }
@@ -438,11 +454,11 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                                 if (arg.IsOptional || foundFilename)
                                 {
                                     DoxygenToken argToken = DoxygenTokenPool.Make(DoxygenTokenKind.ArgumentFile, Buffer.LexemeRange, foundFilename);
-                                    PushToken(argToken);
+                                    PushArgToken(result, argToken);
                                 }
                                 else if (arg.IsRequired)
                                 {
-                                    AddError(Buffer.TextPosition, $"Unexpected character '{Buffer.Peek()}' for argument ({argNumber}:{arg}) in command '{commandName}'", whereName, commandName);
+                                    AddError(Buffer.TextPosition, $"Unexpected character '{Buffer.Peek()}' for argument ({argNumber}:{arg}) in command '{GetCommandName(result)}'", whereName, GetCommandName(result));
                                     return (result);
                                 }
                             }
@@ -466,11 +482,11 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                                 if (arg.IsOptional || foundWord)
                                 {
                                     DoxygenToken argToken = DoxygenTokenPool.Make(DoxygenTokenKind.ArgumentCaption, Buffer.LexemeRange, foundWord);
-                                    PushToken(argToken);
+                                    PushArgToken(result, argToken);
                                 }
                                 else if (arg.IsRequired)
                                 {
-                                    AddError(Buffer.TextPosition, $"Unexpected character '{Buffer.Peek()}' for argument ({argNumber}:{arg}) in command '{commandName}'", whereName, commandName);
+                                    AddError(Buffer.TextPosition, $"Unexpected character '{Buffer.Peek()}' for argument ({argNumber}:{arg}) in command '{GetCommandName(result)}'", whereName, GetCommandName(result));
                                     return (result);
                                 }
                             }
@@ -509,18 +525,18 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                                     }
                                     if (!isComplete)
                                     {
-                                        AddError(Buffer.TextPosition, $"Unterminated quote string for argument ({argNumber}:{arg}) in command '{commandName}'", whereName, commandName);
+                                        AddError(Buffer.TextPosition, $"Unterminated quote string for argument ({argNumber}:{arg}) in command '{GetCommandName(result)}'", whereName, GetCommandName(result));
                                         return (result);
                                     }
                                 }
                                 if (arg.IsOptional || isComplete)
                                 {
                                     DoxygenToken argToken = DoxygenTokenPool.Make(DoxygenTokenKind.ArgumentText, Buffer.LexemeRange, isComplete);
-                                    PushToken(argToken);
+                                    PushArgToken(result, argToken);
                                 }
                                 else if (arg.IsRequired)
                                 {
-                                    AddError(Buffer.TextPosition, $"Unexpected character '{Buffer.Peek()}' for argument ({argNumber}:{arg}) in command '{commandName}'", whereName, commandName);
+                                    AddError(Buffer.TextPosition, $"Unexpected character '{Buffer.Peek()}' for argument ({argNumber}:{arg}) in command '{GetCommandName(result)}'", whereName, GetCommandName(result));
                                     return (result);
                                 }
                             }
@@ -546,11 +562,11 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                                 if (arg.IsOptional || eolFound)
                                 {
                                     DoxygenToken argToken = DoxygenTokenPool.Make(DoxygenTokenKind.ArgumentText, Buffer.LexemeRange, true);
-                                    PushToken(argToken);
+                                    PushArgToken(result, argToken);
                                 }
                                 else if (arg.IsRequired)
                                 {
-                                    AddError(Buffer.TextPosition, $"Unterminated end-of-line for argument ({argNumber}:{arg}) in command '{commandName}'", whereName, commandName);
+                                    AddError(Buffer.TextPosition, $"Unterminated end-of-line for argument ({argNumber}:{arg}) in command '{GetCommandName(result)}'", whereName, GetCommandName(result));
                                     return (result);
                                 }
                             }
@@ -562,7 +578,7 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                             goto CommandDone;
 
                         default:
-                            AddError(Buffer.TextPosition, $"Unsupported argument ({argNumber}:{arg}) in command '{commandName}'", whereName, commandName);
+                            AddError(Buffer.TextPosition, $"Unsupported argument ({argNumber}:{arg}) in command '{GetCommandName(result)}'", whereName, GetCommandName(result));
                             return (result);
                     }
 
@@ -575,7 +591,7 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                         }
                         else
                         {
-                            AddError(Buffer.TextPosition, $"Expected postfix '{postfix}' for pp-argument({argNumber}:{arg}) in command '{commandName}'", whereName, commandName);
+                            AddError(Buffer.TextPosition, $"Expected postfix '{postfix}' for pp-argument({argNumber}:{arg}) in command '{GetCommandName(result)}'", whereName, GetCommandName(result));
                             return (result);
                         }
                     }
@@ -635,10 +651,12 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                     Buffer.StartLexeme();
                     Buffer.AdvanceColumn();
                     Buffer.AdvanceColumnsWhile(SyntaxUtils.IsIdentPart);
-                    string ident = Buffer.GetSourceText(Buffer.LexemeStart.Index + 1, Buffer.LexemeWidth - 1);
-                    if (endCommand.Equals(ident))
+                    ReadOnlySpan<char> ident = Buffer.GetSourceSpan(Buffer.LexemeStart.Index + 1, Buffer.LexemeWidth - 1);
+                    if (ident.SequenceEqual(endCommand))
                     {
-                        PushToken(DoxygenTokenPool.Make(DoxygenTokenKind.CommandEnd, Buffer.LexemeRange, true));
+                        if (commandResult.CommandId == DoxygenSyntax.CodeCommandId)
+                            PushCodeRange(commandResult, Buffer.LexemeStart);
+                        PushToken(DoxygenTokenPool.Make(DoxygenTokenKind.CommandEnd, Buffer.LexemeRange, true, DoxygenSyntax.GetCommandId(ident)));
                         isComplete = true;
                         break;
                     }
@@ -652,12 +670,61 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
             }
             if (!isComplete)
             {
-                AddError(commandResult.StartPos, $"Unterminated command-block, expect '@{endCommand}' or '\\{endCommand}'", "{beginCommand}", commandResult.CommandName);
+                AddError(commandResult.StartPos, $"Unterminated command-block, expect '@{endCommand}' or '\\{endCommand}'", "{beginCommand}", GetCommandName(commandResult));
                 return (false);
             }
             return (true);
         }
 
+        private static bool IsCppCodeType(CommandResult commandResult)
+        {
+            DoxygenToken firstArgToken = commandResult.ArgTokens.FirstOrDefault();
+            if (firstArgToken == null || firstArgToken.Kind != DoxygenTokenKind.ArgumentCaption)
+                return (false);
+            string codeType = firstArgToken.Value;
+            bool result = "{.c}".Equals(codeType, StringComparison.InvariantCultureIgnoreCase) || "{.cpp}".Equals(codeType, StringComparison.InvariantCultureIgnoreCase);
+            return (result);
+        }
+
+        /// <summary>
+        /// Pushes a <see cref="DoxygenTokenKind.Code"/> token for the content of a C/C++ code block, so the caller can lex it as C++ without pairing the command tokens again.
+        /// </summary>
+        private void PushCodeRange(CommandResult commandResult, TextPosition contentEnd)
+        {
+            if (!IsCppCodeType(commandResult))
+                return;
+            DoxygenToken lastToken = commandResult.ArgTokens.Count > 0 ? commandResult.ArgTokens[commandResult.ArgTokens.Count - 1] : null;
+            TextPosition contentStart;
+            if (lastToken != null)
+                contentStart = new TextPosition(lastToken.Index + lastToken.Length, lastToken.Position.Line, lastToken.Position.Column + lastToken.Length);
+            else
+                contentStart = new TextPosition(commandResult.StartPos.Index + commandResult.CommandLength, commandResult.StartPos.Line, commandResult.StartPos.Column + commandResult.CommandLength);
+            Debug.Assert(contentEnd.Index >= contentStart.Index);
+            PushToken(DoxygenTokenPool.Make(DoxygenTokenKind.Code, new TextRange(contentStart, contentEnd.Index - contentStart.Index), true));
+        }
+
+        private const string TextRunStopChars = "@\\*/\t";
+
+        /// <summary>
+        /// Skips plain text up to the next character that LexNext handles (command start, comment chars, tab or line break).
+        /// </summary>
+        private void SkipTextRun()
+        {
+            int remaining = Buffer.StreamBase + Buffer.StreamLength - Buffer.StreamPosition;
+            ReadOnlySpan<char> text = Buffer.GetSourceSpan(Buffer.StreamPosition, remaining);
+
+            // @NOTE(final): Two searches, because IndexOfAny is only vectorized for up to five characters
+            int runLength = text.IndexOfAny(TextRunStopChars);
+            if (runLength < 0)
+                runLength = text.Length;
+            int lineBreak = text.Slice(0, runLength).IndexOfAny('\r', '\n');
+            if (lineBreak >= 0)
+                runLength = lineBreak;
+
+            Debug.Assert(runLength > 0);
+            Buffer.AdvanceColumns(runLength);
+        }
+
         protected override bool LexNext(State hiddenState)
         {
             DoxygenState state = (DoxygenState)hiddenState;
@@ -671,9 +738,6 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                 char fourth = Buffer.Peek(3);
                 switch (first)
                 {
-                    case ' ':
-                    case '\v':
-                    case '\f':
                     case '\t':
                         Buffer.SkipSpaces(RepeatKind.All);
                         break;
@@ -802,12 +866,12 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                                 CommandResult commandResult = LexCommandTokens();
                                 if (commandResult.IsValid)
                                 {
-                                    if ("code".Equals(commandResult.CommandName))
+                                    if (commandResult.CommandId == DoxygenSyntax.CodeCommandId)
                                     {
                                         if (!LexUntilCommandEnd(commandResult, "code", "endcode"))
                                             return (false);
                                     }
-                                    else if ("htmlonly".Equals(commandResult.CommandName))
+                                    else if (commandResult.CommandId == DoxygenSyntax.HtmlOnlyCommandId)
                                     {
                                         if (!LexUntilCommandEnd(commandResult, "htmlonly", "endhtmlonly"))
                                             return (false);
@@ -835,7 +899,7 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
 
                     default:
                         {
-                            Buffer.AdvanceColumn();
+                            SkipTextRun();
                             break;
                         }
                 }
@@ -1,6 +1,8 @@
-﻿using System.Collections.Generic;
+﻿using System;
+using System.Collections.Generic;
 using System.Diagnostics;
 using System.Linq;
+using System.Threading.Tasks;
 using TSP.DoxygenEditor.Collections;
 using TSP.DoxygenEditor.Languages.Utils;
 using TSP.DoxygenEditor.Lexers;
@@ -20,10 +22,213 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
             DoxygenBlockEntityKind.SubSubSection,
         };
 
+        /// <summary>
+        /// Optional cache, unchanged blocks are taken from it instead of being parsed again.
+        /// </summary>
+        public DoxygenBlockCache BlockCache { get; set; }
+
+        /// <summary>
+        /// Parses all documentation blocks on their own in parallel first, the sequential pass then only stitches the independent blocks together.
+        /// Blocks which depend on the blocks before them (open groups, unclosed entities) are still parsed sequentially.
+        /// </summary>
+        public bool IsParallel { get; set; }
+
+        // @NOTE(final): For just a few blocks, starting the parallel pass costs more than it saves
+        private const int MinParallelBlockCount = 32;
+
+        class BlockRecord
+        {
+            public DoxygenToken StartToken { get; }
+            public int StackDepth { get; }
+            public int NodeCountStart { get; }
+            public int ErrorCountStart { get; }
+            public List<BaseSymbol> Symbols { get; }
+            public BlockRecord(DoxygenToken startToken, int stackDepth, int nodeCountStart, int errorCountStart)
+            {
+                StartToken = startToken;
+                StackDepth = stackDepth;
+                NodeCountStart = nodeCountStart;
+                ErrorCountStart = errorCountStart;
+                Symbols = new List<BaseSymbol>();
+            }
+        }
+        private BlockRecord _blockRecord = null;
+
+        class ParsedBlock
+        {
+            public DoxygenBlockNode Node { get; }
+            public int NodeCount { get; }
+            public List<BaseSymbol> Symbols { get; }
+            public List<TextError> Errors { get; }
+            public IBaseToken EndToken { get; set; }
+            public ParsedBlock(DoxygenBlockNode node, int nodeCount, List<BaseSymbol> symbols, List<TextError> errors)
+            {
+                Node = node;
+                NodeCount = nodeCount;
+                Symbols = symbols;
+                Errors = errors;
+            }
+        }
+        private Dictionary<IBaseToken, ParsedBlock> _parallelBlocks = null;
+        private bool _isIsolated = false;
+        private ParsedBlock _isolatedBlock = null;
+
         public DoxygenBlockParser(ISymbolTableId id) : base(id)
         {
         }
 
+        private void AddSourceSymbol(SourceSymbol symbol)
+        {
+            LocalSymbolTable.AddSource(symbol);
+            _blockRecord?.Symbols.Add(symbol);
+        }
+        private void AddReferenceSymbol(ReferenceSymbol symbol)
+        {
+            LocalSymbolTable.AddReference(symbol);
+            _blockRecord?.Symbols.Add(symbol);
+        }
+
+        /// <summary>
+        /// Adds the already parsed subtree (cached or parsed in parallel) for the block which starts at the current token and skips all its tokens.
+        /// </summary>
+        private bool TryAddParsedBlock(DoxygenToken blockStartToken, LinkedListStream<IBaseToken> stream)
+        {
+            _blockRecord = null;
+            // @NOTE(final): A starting block closes an open group, so the block depends on the previous blocks
+            if (Top != null && Top.Entity.Kind == DoxygenBlockEntityKind.Group)
+                return (false);
+            if (BlockCache != null)
+            {
+                DoxygenBlockCache.RebasedBlock rebased = BlockCache.RebaseParsedBlock(blockStartToken, Top, this);
+                if (rebased != null)
+                {
+                    AddParsedTree(rebased.Node, rebased.NodeCount, rebased.Symbols, rebased.Errors, rebased.EndToken, stream);
+                    return (true);
+                }
+            }
+            ParsedBlock parsed;
+            if (_parallelBlocks != null && _parallelBlocks.TryGetValue(blockStartToken, out parsed))
+            {
+                parsed.Node.ChangeParent(Top);
+                foreach (TextError error in parsed.Errors)
+                    error.Tag = this;
+                AddParsedTree(parsed.Node, parsed.NodeCount, parsed.Symbols, parsed.Errors, parsed.EndToken, stream);
+                BlockCache?.AddParsedBlock(blockStartToken, parsed.Node, parsed.NodeCount, parsed.Symbols, parsed.Errors);
+                return (true);
+            }
+            if (BlockCache != null || _isIsolated)
+            {
+                _blockRecord = new BlockRecord(blockStartToken, StackDepth, TotalNodeCount, ParseErrorCount);
+            }
+            return (false);
+        }
+
+        private void AddParsedTree(DoxygenBlockNode node, int nodeCount, IEnumerable<BaseSymbol> symbols, IEnumerable<TextError> errors, IBaseToken endToken, LinkedListStream<IBaseToken> stream)
+        {
+            AddTree(node, nodeCount);
+            foreach (BaseSymbol symbol in symbols)
+            {
+                if (symbol is SourceSymbol sourceSymbol)
+                    LocalSymbolTable.AddSource(sourceSymbol);
+                else
+                    LocalSymbolTable.AddReference((ReferenceSymbol)symbol);
+            }
+            foreach (TextError error in errors)
+                AddError(error);
+            while (!stream.IsEOF)
+            {
+                IBaseToken token = stream.CurrentValue;
+                stream.Next();
+                if (token == endToken)
+                    break;
+            }
+        }
+
+        /// <summary>
+        /// Stores the block which was just popped, the given minimum stack depth was taken right before that.
+        /// </summary>
+        private void FinishBlockRecord(IBaseNode blockNode, int blockMinStackDepth)
+        {
+            BlockRecord record = _blockRecord;
+            _blockRecord = null;
+            // @NOTE(final): Blocks which leave entities open or touch entities of previous blocks cannot be reused
+            if (record == null || StackDepth != record.StackDepth || blockMinStackDepth <= record.StackDepth)
+                return;
+            int nodeCount = TotalNodeCount - record.NodeCountStart;
+            if (_isIsolated)
+                _isolatedBlock = new ParsedBlock((DoxygenBlockNode)blockNode, nodeCount, record.Symbols, ParseErrors.Skip(record.ErrorCountStart).ToList());
+            else
+                BlockCache.AddParsedBlock(record.StartToken, (DoxygenBlockNode)blockNode, nodeCount, record.Symbols, ParseErrors.Skip(record.ErrorCountStart));
+        }
+
+        /// <summary>
+        /// Parses the tokens of a single block with a fresh parser, returns null when the block is not independent from the blocks before it.
+        /// </summary>
+        private static ParsedBlock ParseIsolatedBlock(ISymbolTableId id, string source, List<IBaseToken> blockTokens)
+        {
+            using (DoxygenBlockParser parser = new DoxygenBlockParser(id) { _isIsolated = true })
+            {
+                LinkedListStream<IBaseToken> stream = new LinkedListStream<IBaseToken>(blockTokens);
+                try
+                {
+                    while (!stream.IsEOF && parser._isolatedBlock == null)
+                    {
+                        if (typeof(DoxygenToken).Equals(stream.CurrentValue.GetType()))
+                            parser.ParseToken(source, stream);
+                        else
+                            stream.Next();
+                    }
+                }
+                catch (InvalidOperationException)
+                {
+                    // @NOTE(final): The block pops more entities than it pushed, which only works on the stack of the previous blocks
+                    return (null);
+                }
+                ParsedBlock result = parser._isolatedBlock;
+                if (result != null)
+                    result.EndToken = stream.IsEOF ? blockTokens[blockTokens.Count - 1] : stream.CurrentNode.Previous.Value;
+                return (result);
+            }
+        }
+
+        public override void Prepare(string source, IEnumerable<IBaseToken> tokens)
+        {
+            _parallelBlocks = null;
+            if (!IsParallel)
+                return;
+
+            // Split into blocks, each one ranges until the next block starts
+            List<List<IBaseToken>> blocks = new List<List<IBaseToken>>();
+            List<IBaseToken> blockTokens = null;
+            foreach (IBaseToken token in tokens)
+            {
+                if (typeof(DoxygenToken).Equals(token.GetType()))
+                {
+                    DoxygenToken doxyToken = (DoxygenToken)token;
+                    if (doxyToken.Kind == DoxygenTokenKind.DoxyBlockStartSingle || doxyToken.Kind == DoxygenTokenKind.DoxyBlockStartMulti)
+                    {
+                        // Blocks from the cache are not parsed at all
+                        blockTokens = (BlockCache != null && BlockCache.ContainsParsedBlock(doxyToken)) ? null : new List<IBaseToken>();
+                        if (blockTokens != null)
+                            blocks.Add(blockTokens);
+                    }
+                }
+                blockTokens?.Add(token);
+            }
+            if (blocks.Count < MinParallelBlockCount)
+                return;
+
+            ParsedBlock[] parsedBlocks = new ParsedBlock[blocks.Count];
+            ISymbolTableId id = LocalSymbolTable.Id;
+            Parallel.For(0, blocks.Count, (i) => parsedBlocks[i] = ParseIsolatedBlock(id, source, blocks[i]));
+            _parallelBlocks = new Dictionary<IBaseToken, ParsedBlock>(blocks.Count);
+            for (int i = 0; i < blocks.Count; ++i)
+            {
+                if (parsedBlocks[i] != null)
+                    _parallelBlocks.Add(blocks[i][0], parsedBlocks[i]);
+            }
+        }
+
         private DoxygenBlockNode PushEntity(DoxygenBlockEntity newEntity)
         {
             if (newEntity.Kind == DoxygenBlockEntityKind.BlockSingle || newEntity.Kind == DoxygenBlockEntityKind.BlockMulti)
@@ -32,6 +237,8 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                     Pop();
                 DoxygenBlockNode blockNode = new DoxygenBlockNode(Top, newEntity);
                 Push(blockNode);
+                if (_blockRecord != null)
+                    ResetMinStackDepth();
                 return (blockNode);
             }
 
@@ -74,18 +281,31 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
             }
         }
 
+        /// <summary>
+        /// Returns the name of the command without the leading @ or \, as spelled in the source.
+        /// </summary>
+        private static string GetCommandName(DoxygenToken commandToken)
+        {
+            // @NOTE(final): Known spellings are taken from the command lookup table, so only unknown commands allocate their name, which happens for errors only
+            ReadOnlySpan<char> sourceName = commandToken.Value.AsSpan(1);
+            string result = DoxygenSyntax.GetCommandName(sourceName);
+            if (result == null)
+                result = sourceName.ToString();
+            return (result);
+        }
+
         private bool ParseCommand(string source, LinkedListStream<IBaseToken> stream, IBaseNode contentRoot)
         {
             // @NOTE(final): This must always return true, due to the fact that the stream is advanced at least once
             DoxygenToken commandToken = stream.Peek<DoxygenToken>();
             Debug.Assert(commandToken != null && commandToken.Kind == DoxygenTokenKind.Command);
 
-            string commandName = commandToken.Value.Substring(1);
+            string commandName = GetCommandName(commandToken);
             stream.Next();
 
             string typeName = "Command";
 
-            DoxygenSyntax.CommandRule rule = DoxygenSyntax.GetCommandRule(commandName);
+            DoxygenSyntax.CommandRule rule = DoxygenSyntax.GetCommandRule(commandToken.CommandId);
             if (rule != null)
             {
                 if (rule.Kind == DoxygenSyntax.CommandKind.EndCommandBlock)
@@ -166,7 +386,7 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                     {
                         if (rule.Kind == DoxygenSyntax.CommandKind.Section)
                         {
-                            if (!"mainpage".Equals(commandName))
+                            if (rule.Id != DoxygenSyntax.MainPageCommandId)
                                 AddError(commandToken.Position, $"Missing identifier mapping for command '{commandName}'", typeName, commandName);
                         }
                     }
@@ -179,11 +399,11 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                         if (rule.Kind == DoxygenSyntax.CommandKind.Section)
                         {
                             SourceSymbolKind kind = SourceSymbolKind.DoxygenSection;
-                            if ("page".Equals(commandName) || "mainpage".Equals(commandName))
+                            if (rule.Id == DoxygenSyntax.PageCommandId || rule.Id == DoxygenSyntax.MainPageCommandId)
                                 kind = SourceSymbolKind.DoxygenPage;
-                            LocalSymbolTable.AddSource(new SourceSymbol(nameParam.Token.Lang, kind, symbolName, symbolDisplayName, nameParam.Token.Range, commandNode));
+                            AddSourceSymbol(new SourceSymbol(nameParam.Token.Lang, kind, symbolName, symbolDisplayName, nameParam.Token.Range, commandNode));
                         }
-                        else if ("ref".Equals(commandName) || "refitem".Equals(commandName))
+                        else if (rule.Id == DoxygenSyntax.RefCommandId || rule.Id == DoxygenSyntax.RefItemCommandId)
                         {
                             string referenceValue = nameParam.Value;
                             TextPosition startPos = new TextPosition(0, nameParam.Token.Position.Line, nameParam.Token.Position.Column);
@@ -218,7 +438,7 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                                             }
                                         }
                                         TextRange symbolRange = new TextRange(new TextPosition(nameParam.Token.Position.Index + refRange.Position.Index, refRange.Position.Line, refRange.Position.Column), refRange.Length);
-                                        LocalSymbolTable.AddReference(new ReferenceSymbol(nameParam.Token.Lang, referenceTarget, singleRereference, symbolRange, commandNode));
+                                        AddReferenceSymbol(new ReferenceSymbol(nameParam.Token.Lang, referenceTarget, singleRereference, symbolRange, commandNode));
                                     }
                                     else if (first == '#' || first == '.')
                                     {
@@ -234,8 +454,8 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                                 }
                             }
                         }
-                        else if ("subpage".Equals(commandName))
-                            LocalSymbolTable.AddReference(new ReferenceSymbol(nameParam.Token.Lang, ReferenceSymbolKind.DoxygenPage, symbolName, nameParam.Token.Range, commandNode));
+                        else if (rule.Id == DoxygenSyntax.SubPageCommandId)
+                            AddReferenceSymbol(new ReferenceSymbol(nameParam.Token.Lang, ReferenceSymbolKind.DoxygenPage, symbolName, nameParam.Token.Range, commandNode));
                     }
                 }
                 ParseBlockContent(source, stream, commandNode);
@@ -252,8 +472,10 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
             // @NOTE(final) Single block = auto-brief
 
             IBaseToken blockToken = stream.Peek();
+            if (TryAddParsedBlock((DoxygenToken)blockToken, stream))
+                return (ParseTokenResult.AlreadyAdvanced);
             DoxygenBlockEntity blockEntity = new DoxygenBlockEntity(DoxygenBlockEntityKind.BlockSingle, blockToken);
-            PushEntity(blockEntity);
+            DoxygenBlockNode blockNode = PushEntity(blockEntity);
             stream.Next();
 
             IBaseToken endToken = null;
@@ -279,11 +501,14 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
 
             Pop(); // Pop brief
 
+            int blockMinStackDepth = MinStackDepth;
             Pop(); // Pop block
 
             if (endToken != null)
                 blockEntity.EndRange = endToken.Range;
 
+            FinishBlockRecord(blockNode, blockMinStackDepth);
+
             return (ParseTokenResult.AlreadyAdvanced);
         }
 
@@ -322,7 +547,7 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                         return ParseCommand(source, stream, contentRoot);
 
                     case DoxygenTokenKind.InvalidCommand:
-                        string commandName = doxyToken.Value.Substring(1);
+                        string commandName = GetCommandName(doxyToken);
                         AddError(doxyToken.Position, $"Unknown doxygen command '{commandName}'", "Command", commandName);
                         stream.Next();
                         return (true);
@@ -331,6 +556,16 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                         ParseText(source, stream, contentRoot);
                         return (true);
 
+                    case DoxygenTokenKind.Code:
+                        if (contentRoot != null)
+                        {
+                            DoxygenBlockNode codeNode = new DoxygenBlockNode(contentRoot, new DoxygenBlockEntity(DoxygenBlockEntityKind.Code, doxyToken.Range));
+                            codeNode.Entity.Value = doxyToken.Value;
+                            contentRoot.AddChild(codeNode);
+                        }
+                        stream.Next();
+                        return (true);
+
                     default:
                         stream.Next();
                         return (true);
@@ -353,6 +588,8 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
 
                     case DoxygenTokenKind.DoxyBlockStartMulti:
                         {
+                            if (TryAddParsedBlock(doxyToken, stream))
+                                return (ParseTokenResult.AlreadyAdvanced);
                             DoxygenBlockEntity blockEntity = new DoxygenBlockEntity(DoxygenBlockEntityKind.BlockMulti, doxyToken);
                             PushEntity(blockEntity);
                             stream.Next();
@@ -365,9 +602,11 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
                             Debug.Assert(Top != null);
                             DoxygenBlockEntity rootEntity = (DoxygenBlockEntity)Top.Entity;
                             Debug.Assert(rootEntity.Kind == DoxygenBlockEntityKind.BlockMulti);
-                            Pop();
+                            int blockMinStackDepth = MinStackDepth;
+                            IBaseNode blockNode = Pop();
                             rootEntity.EndRange = doxyToken.Range;
                             stream.Next();
+                            FinishBlockRecord(blockNode, blockMinStackDepth);
                             return (ParseTokenResult.AlreadyAdvanced);
                         }
 
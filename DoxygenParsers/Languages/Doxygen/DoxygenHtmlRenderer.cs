@@ -0,0 +1,472 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Net;
+using System.Text;
+using TSP.DoxygenEditor.Languages.Html;
+using TSP.DoxygenEditor.Lexers;
+using TSP.DoxygenEditor.Parsers;
+using TSP.DoxygenEditor.Symbols;
+using TSP.DoxygenEditor.TextAnalysis;
+
+namespace TSP.DoxygenEditor.Languages.Doxygen
+{
+    /// <summary>
+    /// Renders a parsed documentation block into HTML, without invoking doxygen.
+    /// Only the common commands are supported, everything else is rendered by its content only.
+    /// References are resolved with the <see cref="GlobalSymbolCache"/> and are linked using the <see cref="LinkScheme"/>.
+    /// </summary>
+    public class DoxygenHtmlRenderer
+    {
+        public const string LinkScheme = "symbol:";
+
+        private static readonly Dictionary<string, string> ParagraphTitles = new Dictionary<string, string>()
+        {
+            { "attention", "Attention" },
+            { "author", "Author" },
+            { "authors", "Authors" },
+            { "bug", "Bug" },
+            { "copyright", "Copyright" },
+            { "date", "Date" },
+            { "deprecated", "Deprecated" },
+            { "exception", "Exceptions" },
+            { "invariant", "Invariant" },
+            { "note", "Note" },
+            { "param", "Parameters" },
+            { "post", "Postcondition" },
+            { "pre", "Precondition" },
+            { "remark", "Remarks" },
+            { "remarks", "Remarks" },
+            { "result", "Returns" },
+            { "return", "Returns" },
+            { "returns", "Returns" },
+            { "retval", "Return values" },
+            { "sa", "See also" },
+            { "see", "See also" },
+            { "since", "Since" },
+            { "test", "Test" },
+            { "throw", "Exceptions" },
+            { "throws", "Exceptions" },
+            { "todo", "Todo" },
+            { "tparam", "Template Parameters" },
+            { "warning", "Warning" },
+        };
+
+        private const string PageStyle =
+            "body { font-family: sans-serif; font-size: 10pt; margin: 8px; }" +
+            "p.brief { font-weight: bold; }" +
+            "dl.section dt { font-weight: bold; margin-top: 6px; }" +
+            "dl.section dd { margin-left: 16px; }" +
+            "pre.fragment { background-color: #fbfcfd; border: 1px solid #c4cfe5; padding: 4px; }" +
+            "span.unresolved { color: #c00000; text-decoration: underline dotted; }";
+
+        // @NOTE(final): Supported by doxygen, but never wanted inside the preview
+        private static readonly HashSet<string> DeniedTags = new HashSet<string>() { "form", "input", "meta" };
+        private static readonly HashSet<string> DeniedAttributes = new HashSet<string>() { "style" };
+        private static readonly HashSet<string> UrlAttributes = new HashSet<string>() { "href", "src" };
+
+        private readonly HtmlScanner _htmlScanner = new HtmlScanner();
+        private readonly List<IBaseToken> _htmlTokens = new List<IBaseToken>();
+
+        /// <summary>
+        /// Resolves a reference to its source symbol, defaults to the <see cref="GlobalSymbolCache"/>.
+        /// </summary>
+        public Func<string, Tuple<SourceSymbol, ISymbolTableId>> ResolveReference { get; set; } = (name) => GlobalSymbolCache.FindSource(name);
+
+        /// <summary>
+        /// Returns the innermost documentation block which contains the given source index, or null when there is none.
+        /// </summary>
+        public static DoxygenBlockNode FindBlockAt(IBaseNode root, int index)
+        {
+            if (root == null)
+                return (null);
+            foreach (IBaseNode child in root.Children)
+            {
+                DoxygenBlockNode blockNode = child as DoxygenBlockNode;
+                if (blockNode == null)
+                    continue;
+                DoxygenBlockEntity entity = blockNode.Entity;
+                if (entity.Kind != DoxygenBlockEntityKind.BlockSingle && entity.Kind != DoxygenBlockEntityKind.BlockMulti)
+                    continue;
+                // Blocks may contain following blocks, when they are not properly closed
+                DoxygenBlockNode innerNode = FindBlockAt(blockNode, index);
+                if (innerNode != null)
+                    return (innerNode);
+                if (index >= entity.StartRange.Index && index <= entity.EndRange.End)
+                    return (blockNode);
+            }
+            return (null);
+        }
+
+        /// <summary>
+        /// Renders the given block into a complete HTML document.
+        /// </summary>
+        public string RenderPage(DoxygenBlockNode blockNode)
+        {
+            StringBuilder s = new StringBuilder();
+            s.Append("<!DOCTYPE html><html><head><meta charset=\"utf-8\"/><style>");
+            s.Append(PageStyle);
+            s.Append("</style></head><body>");
+            if (blockNode != null)
+                RenderBlock(blockNode, s);
+            s.Append("</body></html>");
+            return (s.ToString());
+        }
+
+        /// <summary>
+        /// Renders the given block into a HTML fragment.
+        /// </summary>
+        public string RenderBlock(DoxygenBlockNode blockNode)
+        {
+            if (blockNode == null)
+                throw new ArgumentNullException("Block node may not be null");
+            StringBuilder s = new StringBuilder();
+            RenderBlock(blockNode, s);
+            return (s.ToString());
+        }
+
+        private void RenderBlock(DoxygenBlockNode blockNode, StringBuilder s)
+        {
+            foreach (IBaseNode child in blockNode.Children)
+            {
+                DoxygenBlockNode childNode = child as DoxygenBlockNode;
+                if (childNode == null)
+                    continue;
+                // Nested blocks are separate blocks, see FindBlockAt
+                DoxygenBlockEntityKind kind = childNode.Entity.Kind;
+                if (kind == DoxygenBlockEntityKind.BlockSingle || kind == DoxygenBlockEntityKind.BlockMulti)
+                    continue;
+                RenderNode(childNode, s);
+            }
+        }
+
+        private void RenderChildren(DoxygenBlockNode node, StringBuilder s)
+        {
+            foreach (IBaseNode child in node.Children)
+            {
+                DoxygenBlockNode childNode = child as DoxygenBlockNode;
+                if (childNode != null)
+                    RenderNode(childNode, s);
+            }
+        }
+
+        private void RenderNode(DoxygenBlockNode node, StringBuilder s)
+        {
+            DoxygenBlockEntity entity = node.Entity;
+            switch (entity.Kind)
+            {
+                case DoxygenBlockEntityKind.Text:
+                    AppendDocText(s, entity.Value);
+                    s.Append(' ');
+                    break;
+
+                case DoxygenBlockEntityKind.Code:
+                    s.Append("<pre class=\"fragment\"><code>");
+                    s.Append(WebUtility.HtmlEncode(StripCommentPrefixes(entity.Value)));
+                    s.Append("</code></pre>");
+                    break;
+
+                case DoxygenBlockEntityKind.Brief:
+                    s.Append("<p class=\"brief\">");
+                    RenderChildren(node, s);
+                    s.Append("</p>");
+                    break;
+
+                case DoxygenBlockEntityKind.Page:
+                case DoxygenBlockEntityKind.Section:
+                case DoxygenBlockEntityKind.SubSection:
+                case DoxygenBlockEntityKind.SubSubSection:
+                    RenderSection(node, s);
+                    break;
+
+                case DoxygenBlockEntityKind.Paragraph:
+                case DoxygenBlockEntityKind.See:
+                    RenderParagraph(node, s);
+                    break;
+
+                case DoxygenBlockEntityKind.Reference:
+                    RenderReference(node, s);
+                    break;
+
+                case DoxygenBlockEntityKind.VisualEnhancement:
+                    RenderVisualEnhancement(node, s);
+                    break;
+
+                default:
+                    RenderChildren(node, s);
+                    break;
+            }
+        }
+
+        private void RenderSection(DoxygenBlockNode node, StringBuilder s)
+        {
+            DoxygenBlockEntity entity = node.Entity;
+            int level;
+            if (entity.Kind == DoxygenBlockEntityKind.Page)
+                level = 1;
+            else if ("subsubsection".Equals(entity.Id))
+                level = 4;
+            else if ("subsection".Equals(entity.Id))
+                level = 3;
+            else
+                level = 2;
+            string name = entity.GetParameterValue("name");
+            s.Append($"<h{level}");
+            if (!string.IsNullOrWhiteSpace(name))
+                s.Append($" id=\"{WebUtility.HtmlEncode(name)}\"");
+            s.Append('>');
+            s.Append(WebUtility.HtmlEncode(entity.DisplayName ?? string.Empty));
+            s.Append($"</h{level}>");
+            RenderChildren(node, s);
+        }
+
+        private void RenderParagraph(DoxygenBlockNode node, StringBuilder s)
+        {
+            DoxygenBlockEntity entity = node.Entity;
+            string id = entity.Id ?? string.Empty;
+            if ("brief".Equals(id) || "short".Equals(id))
+            {
+                s.Append("<p class=\"brief\">");
+                RenderChildren(node, s);
+                s.Append("</p>");
+                return;
+            }
+            if ("details".Equals(id))
+            {
+                s.Append("<p>");
+                RenderChildren(node, s);
+                s.Append("</p>");
+                return;
+            }
+
+            string title;
+            if ("par".Equals(id))
+                title = entity.GetParameterValue("paragraph title");
+            else if (!ParagraphTitles.TryGetValue(id, out title))
+                title = id.Length > 0 ? char.ToUpperInvariant(id[0]) + id.Substring(1) : id;
+
+            s.Append("<dl class=\"section ");
+            s.Append(WebUtility.HtmlEncode(id));
+            s.Append("\"><dt>");
+            s.Append(WebUtility.HtmlEncode(title ?? string.Empty));
+            s.Append("</dt><dd>");
+            foreach (DoxygenBlockEntity.Parameter parameter in entity.Parameters)
+            {
+                if ("paragraph title".Equals(parameter.Name) || string.IsNullOrWhiteSpace(parameter.Value))
+                    continue;
+                if ("dir".Equals(parameter.Name))
+                    s.Append($"<code>[{WebUtility.HtmlEncode(parameter.Value.Trim('[', ']'))}]</code> ");
+                else
+                    s.Append($"<b>{WebUtility.HtmlEncode(parameter.Value)}</b> ");
+            }
+            RenderChildren(node, s);
+            s.Append("</dd></dl>");
+        }
+
+        private void RenderReference(DoxygenBlockNode node, StringBuilder s)
+        {
+            DoxygenBlockEntity entity = node.Entity;
+            string name = entity.GetParameterValue("name");
+            if (string.IsNullOrWhiteSpace(name))
+            {
+                RenderChildren(node, s);
+                return;
+            }
+            string text = Unquote(entity.GetParameterValue("text"));
+            if (string.IsNullOrWhiteSpace(text))
+                text = name;
+            Tuple<SourceSymbol, ISymbolTableId> source = ResolveReference?.Invoke(name);
+            if (source != null)
+            {
+                string caption = source.Item1.Caption;
+                if (text == name && !string.IsNullOrWhiteSpace(caption))
+                    text = caption;
+                s.Append($"<a href=\"{LinkScheme}{Uri.EscapeDataString(name)}\">{WebUtility.HtmlEncode(text)}</a>");
+            }
+            else
+                s.Append($"<span class=\"unresolved\" title=\"Unresolved reference\">{WebUtility.HtmlEncode(text)}</span>");
+            s.Append(' ');
+            RenderChildren(node, s);
+        }
+
+        private void RenderVisualEnhancement(DoxygenBlockNode node, StringBuilder s)
+        {
+            DoxygenBlockEntity entity = node.Entity;
+            string word = entity.GetParameterValue("word", "name");
+            string encoded = WebUtility.HtmlEncode(Unquote(word) ?? string.Empty);
+            switch (entity.Id)
+            {
+                case "b":
+                    s.Append($"<b>{encoded}</b> ");
+                    break;
+                case "c":
+                case "p":
+                    s.Append($"<code>{encoded}</code> ");
+                    break;
+                case "n":
+                    s.Append("<br/>");
+                    break;
+                default:
+                    s.Append($"<em>{encoded}</em> ");
+                    break;
+            }
+            RenderChildren(node, s);
+        }
+
+        private static string Unquote(string value)
+        {
+            if (value != null && value.Length >= 2 && value[0] == '"' && value[value.Length - 1] == '"')
+                return value.Substring(1, value.Length - 2);
+            return (value);
+        }
+
+        /// <summary>
+        /// Appends documentation text, which may contain HTML tags.
+        /// Only complete tags from the <see cref="HtmlSyntax"/> table are written again, with known attributes only and links using the <see cref="LinkScheme"/>.
+        /// Everything else is escaped, except for character entities.
+        /// </summary>
+        private void AppendDocText(StringBuilder s, string text)
+        {
+            if (string.IsNullOrEmpty(text))
+                return;
+            _htmlTokens.Clear();
+            _htmlScanner.Scan(text, 0, text.Length, new TextPosition(0), _htmlTokens);
+            int textStart = 0;
+            int i = 0;
+            while (i < _htmlTokens.Count)
+            {
+                HtmlToken tagToken = (HtmlToken)_htmlTokens[i++];
+                if (tagToken.Kind != HtmlTokenKind.MetaTagStart && tagToken.Kind != HtmlTokenKind.MetaTagClose && tagToken.Kind != HtmlTokenKind.MetaTagStartAndClose)
+                    continue;
+                int tagEnd = i;
+                while (tagEnd < _htmlTokens.Count && !IsTagStart((HtmlToken)_htmlTokens[tagEnd]))
+                    ++tagEnd;
+                AppendEncodedText(s, text, textStart, tagToken.Index - textStart);
+                if (!AppendTag(s, text, tagToken, i, tagEnd))
+                    AppendEncodedText(s, text, tagToken.Index, tagToken.Length);
+                textStart = tagToken.Index + tagToken.Length;
+                i = tagEnd;
+            }
+            AppendEncodedText(s, text, textStart, text.Length - textStart);
+            HtmlTokenPool.Release(_htmlTokens.Cast<HtmlToken>());
+            _htmlTokens.Clear();
+        }
+
+        private static bool IsTagStart(HtmlToken token)
+        {
+            return (token.Kind == HtmlTokenKind.MetaTagStart || token.Kind == HtmlTokenKind.MetaTagClose || token.Kind == HtmlTokenKind.MetaTagStartAndClose || token.Kind == HtmlTokenKind.EOF);
+        }
+
+        private bool AppendTag(StringBuilder s, string text, HtmlToken tagToken, int firstToken, int endToken)
+        {
+            if (tagToken.Length < 3 || text[tagToken.Index + tagToken.Length - 1] != '>' || firstToken + 1 >= endToken)
+                return (false);
+            HtmlToken nameToken = (HtmlToken)_htmlTokens[firstToken + 1];
+            if (nameToken.Kind != HtmlTokenKind.TagName)
+                return (false);
+            string tagName = HtmlSyntax.GetTagName(nameToken.NameId);
+            if (tagName == null || DeniedTags.Contains(tagName))
+                return (false);
+
+            s.Append('<');
+            if (tagToken.Kind == HtmlTokenKind.MetaTagClose)
+            {
+                s.Append('/').Append(tagName).Append('>');
+                return (true);
+            }
+            s.Append(tagName);
+            for (int i = firstToken + 2; i < endToken; ++i)
+            {
+                HtmlToken attrToken = (HtmlToken)_htmlTokens[i];
+                if (attrToken.Kind != HtmlTokenKind.AttrName)
+                    continue;
+                HtmlToken valueToken = i + 2 < endToken && ((HtmlToken)_htmlTokens[i + 1]).Kind == HtmlTokenKind.AttrChars ? (HtmlToken)_htmlTokens[i + 2] : null;
+                if (valueToken != null && valueToken.Kind != HtmlTokenKind.AttrValue)
+                    valueToken = null;
+                string attrName = HtmlSyntax.GetAttributeName(attrToken.NameId);
+                if (attrName == null || DeniedAttributes.Contains(attrName))
+                    continue;
+                if (valueToken == null)
+                {
+                    if (!UrlAttributes.Contains(attrName))
+                        s.Append(' ').Append(attrName);
+                    continue;
+                }
+                string value = Unquote(text.Substring(valueToken.Index, valueToken.Length));
+                if (value.Length >= 2 && value[0] == '\'' && value[value.Length - 1] == '\'')
+                    value = value.Substring(1, value.Length - 2);
+                value = WebUtility.HtmlDecode(value);
+                if (UrlAttributes.Contains(attrName) && !value.StartsWith(LinkScheme, StringComparison.OrdinalIgnoreCase))
+                    continue;
+                s.Append(' ').Append(attrName).Append("=\"").Append(WebUtility.HtmlEncode(value)).Append('"');
+            }
+            if (tagToken.Kind == HtmlTokenKind.MetaTagStartAndClose)
+                s.Append('/');
+            s.Append('>');
+            return (true);
+        }
+
+        /// <summary>
+        /// Appends the text escaped, but keeps character entities like &amp;amp; or &amp;#169;.
+        /// </summary>
+        private static void AppendEncodedText(StringBuilder s, string text, int index, int length)
+        {
+            int end = index + length;
+            int runStart = index;
+            for (int i = index; i < end; ++i)
+            {
+                if (text[i] != '&')
+                    continue;
+                int nameStart = i + 1;
+                if (nameStart < end && text[nameStart] == '#')
+                    ++nameStart;
+                int entityEnd = nameStart;
+                while (entityEnd < end && char.IsLetterOrDigit(text[entityEnd]))
+                    ++entityEnd;
+                if (entityEnd < end && text[entityEnd] == ';' && entityEnd > nameStart)
+                {
+                    s.Append(WebUtility.HtmlEncode(text.Substring(runStart, i - runStart)));
+                    s.Append(text, i, entityEnd + 1 - i);
+                    runStart = entityEnd + 1;
+                    i = entityEnd;
+                }
+            }
+            if (runStart < end)
+                s.Append(WebUtility.HtmlEncode(text.Substring(runStart, end - runStart)));
+        }
+
+        /// <summary>
+        /// Removes the leading '*' from every line of code inside a multi-line comment.
+        /// </summary>
+        private static string StripCommentPrefixes(string code)
+        {
+            if (string.IsNullOrEmpty(code))
+                return (string.Empty);
+            string[] lines = code.Replace("\r\n", "\n").Split('\n');
+            StringBuilder s = new StringBuilder(code.Length);
+            bool isFirst = true;
+            for (int i = 0; i < lines.Length; ++i)
+            {
+                string line = lines[i];
+                int p = 0;
+                while (p < line.Length && (line[p] == ' ' || line[p] == '\t'))
+                    ++p;
+                if (p < line.Length && line[p] == '*' && (p + 1 >= line.Length || line[p + 1] != '/'))
+                {
+                    ++p;
+                    if (p < line.Length && line[p] == ' ')
+                        ++p;
+                    line = line.Substring(p);
+                }
+                // Skip the empty lines directly after @code and before @endcode
+                if ((i == 0 || i == lines.Length - 1) && string.IsNullOrWhiteSpace(line))
+                    continue;
+                if (!isFirst)
+                    s.Append('\n');
+                s.Append(line);
+                isFirst = false;
+            }
+            return (s.ToString());
+        }
+    }
+}
@@ -148,6 +148,8 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
 
         public abstract class CommandRule
         {
+            public int Id { get; internal set; }
+            public string Name { get; internal set; }
             public CommandKind Kind { get; }
             public DoxygenBlockEntityKind EntityKind { get; }
             public IEnumerable<ArgumentRule> Args { get; }
@@ -213,6 +215,12 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
         public class EndBlockCommandRule : CommandRule
         {
             public HashSet<string> StartCommandNames { get; }
+            public int[] StartCommandIds { get; internal set; }
+            public bool IsEndOf(int startCommandId)
+            {
+                bool result = Array.IndexOf(StartCommandIds, startCommandId) >= 0;
+                return (result);
+            }
             public EndBlockCommandRule(string[] startCommandNames, params ArgumentRule[] args) : base(CommandKind.EndCommandBlock, DoxygenBlockEntityKind.None, args)
             {
                 StartCommandNames = new HashSet<string>(startCommandNames);
@@ -419,12 +427,138 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
             { "throws", CommandRules["throw"] },
         };
 
+        public const int InvalidCommandId = 0;
+
+        public static readonly int CodeCommandId;
+        public static readonly int HtmlOnlyCommandId;
+        public static readonly int ParamCommandId;
+        public static readonly int PageCommandId;
+        public static readonly int MainPageCommandId;
+        public static readonly int SubPageCommandId;
+        public static readonly int RefCommandId;
+        public static readonly int RefItemCommandId;
+
+        // @NOTE(final): Open addressed name -> id table, so the lexers can resolve a command directly from the source span without allocating a string
+        private static readonly CommandRule[] CommandRuleById;
+        private static readonly string[] CommandLookupNames;
+        private static readonly int[] CommandLookupIds;
+        private static readonly int CommandLookupMask;
+
+        static DoxygenSyntax()
+        {
+            CommandRuleById = new CommandRule[CommandRules.Count + 1];
+            int id = InvalidCommandId;
+            foreach (KeyValuePair<string, CommandRule> rulePair in CommandRules)
+            {
+                ++id;
+                rulePair.Value.Id = id;
+                rulePair.Value.Name = rulePair.Key;
+                CommandRuleById[id] = rulePair.Value;
+            }
+
+            int nameCount = CommandRules.Count + EquivalentCommandMap.Count;
+            int capacity = 16;
+            while (capacity < nameCount * 4)
+                capacity <<= 1;
+            CommandLookupNames = new string[capacity];
+            CommandLookupIds = new int[capacity];
+            CommandLookupMask = capacity - 1;
+            foreach (KeyValuePair<string, CommandRule> rulePair in CommandRules)
+                AddCommandLookup(rulePair.Key, rulePair.Value.Id);
+            foreach (KeyValuePair<string, CommandRule> equivalentPair in EquivalentCommandMap)
+                AddCommandLookup(equivalentPair.Key, equivalentPair.Value.Id);
+
+            foreach (CommandRule rule in CommandRules.Values)
+            {
+                if (rule is EndBlockCommandRule endRule)
+                {
+                    List<int> startIds = new List<int>(endRule.StartCommandNames.Count);
+                    foreach (string startName in endRule.StartCommandNames)
+                        startIds.Add(GetCommandId(startName));
+                    endRule.StartCommandIds = startIds.ToArray();
+                }
+            }
+
+            CodeCommandId = GetCommandId("code");
+            HtmlOnlyCommandId = GetCommandId("htmlonly");
+            ParamCommandId = GetCommandId("param");
+            PageCommandId = GetCommandId("page");
+            MainPageCommandId = GetCommandId("mainpage");
+            SubPageCommandId = GetCommandId("subpage");
+            RefCommandId = GetCommandId("ref");
+            RefItemCommandId = GetCommandId("refitem");
+        }
+
+        private static uint HashCommandName(ReadOnlySpan<char> name)
+        {
+            // FNV-1a
+            uint result = 2166136261;
+            for (int i = 0; i < name.Length; ++i)
+            {
+                result ^= name[i];
+                result *= 16777619;
+            }
+            return (result);
+        }
+
+        private static void AddCommandLookup(string name, int id)
+        {
+            int slot = (int)(HashCommandName(name) & (uint)CommandLookupMask);
+            while (CommandLookupNames[slot] != null)
+                slot = (slot + 1) & CommandLookupMask;
+            CommandLookupNames[slot] = name;
+            CommandLookupIds[slot] = id;
+        }
+
+        /// <summary>
+        /// Returns the id of the command rule for the given command name (without the leading @ or \), or <see cref="InvalidCommandId"/>.
+        /// Equivalent commands such as "see" and "sa" share the same id.
+        /// </summary>
+        public static int GetCommandId(ReadOnlySpan<char> commandName)
+        {
+            int slot = FindCommandLookupSlot(commandName);
+            if (slot == -1)
+                return (InvalidCommandId);
+            return (CommandLookupIds[slot]);
+        }
+
+        /// <summary>
+        /// Returns the known command name that matches the given spelling (without the leading @ or \), or null.
+        /// Unlike <see cref="CommandRule.Name"/> this keeps equivalent spellings such as "see" instead of "sa".
+        /// </summary>
+        public static string GetCommandName(ReadOnlySpan<char> commandName)
+        {
+            int slot = FindCommandLookupSlot(commandName);
+            if (slot == -1)
+                return (null);
+            return (CommandLookupNames[slot]);
+        }
+
+        private static int FindCommandLookupSlot(ReadOnlySpan<char> commandName)
+        {
+            int slot = (int)(HashCommandName(commandName) & (uint)CommandLookupMask);
+            string name;
+            while ((name = CommandLookupNames[slot]) != null)
+            {
+                if (commandName.SequenceEqual(name))
+                    return (slot);
+                slot = (slot + 1) & CommandLookupMask;
+            }
+            return (-1);
+        }
+
+        public static CommandRule GetCommandRule(int commandId)
+        {
+            if (commandId <= InvalidCommandId || commandId >= CommandRuleById.Length)
+                return (null);
+            return (CommandRuleById[commandId]);
+        }
+
         public static CommandRule GetCommandRule(string commandName)
         {
-            if (EquivalentCommandMap.ContainsKey(commandName))
-                return EquivalentCommandMap[commandName];
-            else
-                return CommandRules.ContainsKey(commandName) ? CommandRules[commandName] : null;
+            if (commandName == null)
+                return (null);
+            return (GetCommandRule(GetCommandId(commandName)));
         }
 
         public static bool IsCommandBegin(char c)
@@ -7,6 +7,11 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
     {
         public DoxygenTokenKind Kind { get; private set; }
 
+        /// <summary>
+        /// Resolved <see cref="DoxygenSyntax.CommandRule.Id"/> for command tokens, otherwise <see cref="DoxygenSyntax.InvalidCommandId"/>.
+        /// </summary>
+        public int CommandId { get; private set; }
+
         public override bool IsEOF => Kind == DoxygenTokenKind.EOF;
         public override bool IsValid => Kind != DoxygenTokenKind.Invalid;
         public override bool IsEndOfLine => Kind == DoxygenTokenKind.EndOfLine;
@@ -32,10 +37,11 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
         public DoxygenToken() : this(DoxygenTokenKind.Invalid, TextRange.Invalid, false)
         {
         }
-        public void Set(DoxygenTokenKind kind, TextRange range, bool isComplete)
+        public void Set(DoxygenTokenKind kind, TextRange range, bool isComplete, int commandId = DoxygenSyntax.InvalidCommandId)
         {
             Set(LanguageKind.Doxygen, range, isComplete);
             Kind = kind;
+            CommandId = commandId;
         }
         public override string ToString()
         {
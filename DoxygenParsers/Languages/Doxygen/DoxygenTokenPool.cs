@@ -7,12 +7,12 @@ namespace TSP.DoxygenEditor.Languages.Doxygen
     public static class DoxygenTokenPool
     {
         private static ObjectPool<DoxygenToken> _pool = null;
-        public static DoxygenToken Make(DoxygenTokenKind kind, TextRange range, bool isComplete)
+        public static DoxygenToken Make(DoxygenTokenKind kind, TextRange range, bool isComplete, int commandId = DoxygenSyntax.InvalidCommandId)
         {
             if (_pool == null)
                 _pool = new ObjectPool<DoxygenToken>(() => new DoxygenToken());
             DoxygenToken result = _pool.Aquire();
-            result.Set(kind, range, isComplete);
+            result.Set(kind, range, isComplete, commandId);
             return (result);
         }
         public static void Release(IEnumerable<DoxygenToken> list)
@@ -0,0 +1,206 @@
+﻿using System;
+using System.Collections.Generic;
+using TSP.DoxygenEditor.Languages.Utils;
+using TSP.DoxygenEditor.Lexers;
+using TSP.DoxygenEditor.TextAnalysis;
+
+namespace TSP.DoxygenEditor.Languages.Html
+{
+    /// <summary>
+    /// Lightweight and reusable scanner for HTML tags inside of documentation text.
+    /// Produces the same token kinds as the <see cref="HtmlLexer"/>, but works directly on the source string and resolves tag and attribute names against the <see cref="HtmlSyntax"/> tables, so no strings are allocated.
+    /// Text without any '&lt;' is rejected by a single vectorized search.
+    /// </summary>
+    public class HtmlScanner
+    {
+        private const int ColumnsPerTab = 4;
+
+        private string _source;
+        private int _end;
+        private int _index;
+        private int _line;
+        private int _column;
+        private List<IBaseToken> _tokens;
+
+        private TextPosition Position => new TextPosition(_index, _line, _column);
+        private char Peek() => _index < _end ? _source[_index] : TextStream.InvalidCharacter;
+
+        /// <summary>
+        /// Scans the given text range for tags and appends the pooled tokens to the list.
+        /// Returns the number of added tokens, which is zero when the text contains no tags at all.
+        /// </summary>
+        public int Scan(string source, int index, int length, TextPosition pos, List<IBaseToken> tokens)
+        {
+            if (source == null)
+                throw new ArgumentNullException("Source may not be null");
+            if (tokens == null)
+                throw new ArgumentNullException("Tokens may not be null");
+            if (length <= 0 || source.AsSpan(index, length).IndexOf('<') < 0)
+                return (0);
+
+            _source = source;
+            _end = index + length;
+            _index = pos.Index;
+            _line = pos.Line;
+            _column = pos.Column;
+            _tokens = tokens;
+            int startCount = tokens.Count;
+            while (_index < _end)
+            {
+                int next = _source.AsSpan(_index, _end - _index).IndexOf('<');
+                if (next < 0)
+                {
+                    AdvanceTo(_end);
+                    break;
+                }
+                AdvanceTo(_index + next);
+                ScanTag();
+            }
+            _tokens.Add(Make(HtmlTokenKind.EOF, Position, 0, false));
+            int result = tokens.Count - startCount;
+
+            _source = null;
+            _tokens = null;
+            return (result);
+        }
+
+        private HtmlToken Make(HtmlTokenKind kind, TextPosition start, int length, bool isComplete, int nameId = HtmlSyntax.InvalidNameId, string name = null)
+        {
+            HtmlToken result = HtmlTokenPool.Make(kind, new TextRange(start, length), isComplete, nameId);
+            result.Value = name;
+            return (result);
+        }
+
+        private void AdvanceChar()
+        {
+            char c = _source[_index];
+            if (SyntaxUtils.IsLineBreak(c))
+            {
+                char n = _index + 1 < _end ? _source[_index + 1] : TextStream.InvalidCharacter;
+                _index += SyntaxUtils.GetLineBreakChars(c, n);
+                _line++;
+                _column = 0;
+            }
+            else
+            {
+                _column += c == '\t' ? ColumnsPerTab : 1;
+                _index++;
+            }
+        }
+
+        private void AdvanceTo(int target)
+        {
+            // Plain runs are skipped as a whole, only line breaks and tabs need special care
+            while (_index < target)
+            {
+                int run = _source.AsSpan(_index, target - _index).IndexOfAny('\r', '\n', '\t');
+                if (run < 0)
+                {
+                    _column += target - _index;
+                    _index = target;
+                    break;
+                }
+                _column += run;
+                _index += run;
+                AdvanceChar();
+            }
+        }
+
+        private void SkipWhitespaces()
+        {
+            while (_index < _end && char.IsWhiteSpace(_source[_index]))
+                AdvanceChar();
+        }
+
+        private int SkipIdent()
+        {
+            int start = _index;
+            while (_index < _end && SyntaxUtils.IsIdentPart(_source[_index]))
+                _index++;
+            _column += _index - start;
+            return (_index - start);
+        }
+
+        private void ScanTag()
+        {
+            TextPosition tagStart = Position;
+            HtmlToken startTagToken = Make(HtmlTokenKind.MetaTagStart, tagStart, 0, false);
+            _tokens.Add(startTagToken);
+
+            bool allowAttributes = true;
+            AdvanceChar();
+            if (Peek() == '/')
+            {
+                startTagToken.ChangeKind(HtmlTokenKind.MetaTagClose);
+                AdvanceChar();
+                allowAttributes = false;
+            }
+            _tokens.Add(Make(HtmlTokenKind.TagChars, tagStart, _index - tagStart.Index, true));
+
+            if (SyntaxUtils.IsIdentStart(Peek()))
+            {
+                TextPosition nameStart = Position;
+                int nameLength = SkipIdent();
+                int tagId = HtmlSyntax.GetTagId(_source.AsSpan(nameStart.Index, nameLength));
+                _tokens.Add(Make(HtmlTokenKind.TagName, nameStart, nameLength, true, tagId, HtmlSyntax.GetTagName(tagId)));
+            }
+
+            if (allowAttributes)
+            {
+                while (_index < _end)
+                {
+                    SkipWhitespaces();
+                    if (!SyntaxUtils.IsIdentStart(Peek()))
+                        break;
+                    TextPosition nameStart = Position;
+                    int nameLength = SkipIdent();
+                    int attrId = HtmlSyntax.GetAttributeId(_source.AsSpan(nameStart.Index, nameLength));
+                    _tokens.Add(Make(HtmlTokenKind.AttrName, nameStart, nameLength, true, attrId, HtmlSyntax.GetAttributeName(attrId)));
+                    SkipWhitespaces(); // Allow whitespaces before =
+                    if (Peek() != '=')
+                        break;
+                    _tokens.Add(Make(HtmlTokenKind.AttrChars, Position, 1, true));
+                    AdvanceChar();
+                    SkipWhitespaces(); // Allow whitespaces after =
+                    char quote = Peek();
+                    TextPosition valueStart = Position;
+                    if (quote == '"' || quote == '\'')
+                    {
+                        AdvanceChar();
+                        int close = _source.AsSpan(_index, _end - _index).IndexOf(quote);
+                        AdvanceTo(close < 0 ? _end : _index + close);
+                        if (Peek() == quote)
+                            AdvanceChar();
+                        _tokens.Add(Make(HtmlTokenKind.AttrValue, valueStart, _index - valueStart.Index, true));
+                    }
+                    else if (quote != '>' && !char.IsWhiteSpace(quote) && _index < _end)
+                    {
+                        // Unquoted value, until the next whitespace or the end of the tag
+                        while (_index < _end && _source[_index] != '>' && !char.IsWhiteSpace(_source[_index]))
+                            _index++;
+                        _column += _index - valueStart.Index;
+                        _tokens.Add(Make(HtmlTokenKind.AttrValue, valueStart, _index - valueStart.Index, true));
+                    }
+                }
+            }
+
+            SkipWhitespaces(); // Allow whitespaces before /
+            if (Peek() == '/')
+            {
+                startTagToken.ChangeKind(HtmlTokenKind.MetaTagStartAndClose);
+                AdvanceChar();
+                SkipWhitespaces(); // Allow whitespaces after /
+            }
+
+            int tagEnd = _source.AsSpan(_index, _end - _index).IndexOf('>');
+            AdvanceTo(tagEnd < 0 ? _end : _index + tagEnd);
+            if (Peek() == '>')
+            {
+                _tokens.Add(Make(HtmlTokenKind.TagChars, Position, 1, true));
+                AdvanceChar();
+            }
+
+            startTagToken.ChangeLength(_index - tagStart.Index);
+        }
+    }
+}
@@ -0,0 +1,103 @@
+﻿using System;
+
+namespace TSP.DoxygenEditor.Languages.Html
+{
+    public static class HtmlSyntax
+    {
+        public const int InvalidNameId = 0;
+
+        // @NOTE(final): The HTML tags doxygen understands inside of documentation blocks (See "HTML commands" in the doxygen manual)
+        private static readonly string[] TagNames = new[] {
+            "a", "b", "blockquote", "br", "caption", "center", "cite", "code", "dd", "del", "details", "dfn", "div", "dl", "dt",
+            "em", "font", "form", "h1", "h2", "h3", "h4", "h5", "h6", "hr", "i", "img", "input", "ins", "kbd", "li", "meta",
+            "ol", "p", "pre", "q", "s", "small", "span", "strike", "strong", "sub", "summary", "sup", "table", "tbody", "td",
+            "tfoot", "th", "thead", "tr", "tt", "u", "ul", "var",
+        };
+
+        private static readonly string[] AttributeNames = new[] {
+            "align", "alt", "border", "cellpadding", "cellspacing", "class", "color", "cols", "colspan", "dir", "face",
+            "height", "href", "id", "lang", "name", "open", "rows", "rowspan", "size", "src", "start", "style", "target",
+            "title", "type", "valign", "value", "width",
+        };
+
+        // @NOTE(final): Open addressed, case insensitive name -> id tables, so the scanner can resolve a name directly from the source span without allocating a string
+        class NameTable
+        {
+            private readonly string[] _names;
+            private readonly string[] _lookupNames;
+            private readonly int[] _lookupIds;
+            private readonly int _lookupMask;
+
+            public NameTable(string[] names)
+            {
+                _names = new string[names.Length + 1];
+                int capacity = 16;
+                while (capacity < names.Length * 4)
+                    capacity <<= 1;
+                _lookupNames = new string[capacity];
+                _lookupIds = new int[capacity];
+                _lookupMask = capacity - 1;
+                for (int i = 0; i < names.Length; ++i)
+                {
+                    int id = i + 1;
+                    _names[id] = names[i];
+                    int slot = (int)(HashName(names[i]) & (uint)_lookupMask);
+                    while (_lookupNames[slot] != null)
+                        slot = (slot + 1) & _lookupMask;
+                    _lookupNames[slot] = names[i];
+                    _lookupIds[slot] = id;
+                }
+            }
+
+            public int GetId(ReadOnlySpan<char> name)
+            {
+                int slot = (int)(HashName(name) & (uint)_lookupMask);
+                string lookupName;
+                while ((lookupName = _lookupNames[slot]) != null)
+                {
+                    if (name.Equals(lookupName, StringComparison.OrdinalIgnoreCase))
+                        return (_lookupIds[slot]);
+                    slot = (slot + 1) & _lookupMask;
+                }
+                return (InvalidNameId);
+            }
+
+            public string GetName(int id)
+            {
+                if (id <= InvalidNameId || id >= _names.Length)
+                    return (null);
+                return (_names[id]);
+            }
+        }
+
+        private static readonly NameTable Tags = new NameTable(TagNames);
+        private static readonly NameTable Attributes = new NameTable(AttributeNames);
+
+        private static uint HashName(ReadOnlySpan<char> name)
+        {
+            // FNV-1a over the ascii lower case characters
+            uint result = 2166136261;
+            for (int i = 0; i < name.Length; ++i)
+            {
+                char c = name[i];
+                if (c >= 'A' && c <= 'Z')
+                    c = (char)(c + ('a' - 'A'));
+                result ^= c;
+                result *= 16777619;
+            }
+            return (result);
+        }
+
+        /// <summary>
+        /// Returns the id of the given tag name (case insensitive), or <see cref="InvalidNameId"/> when doxygen does not support the tag.
+        /// </summary>
+        public static int GetTagId(ReadOnlySpan<char> tagName) => Tags.GetId(tagName);
+        public static string GetTagName(int tagId) => Tags.GetName(tagId);
+
+        /// <summary>
+        /// Returns the id of the given attribute name (case insensitive), or <see cref="InvalidNameId"/> when the attribute is unknown.
+        /// </summary>
+        public static int GetAttributeId(ReadOnlySpan<char> attributeName) => Attributes.GetId(attributeName);
+        public static string GetAttributeName(int attributeId) => Attributes.GetName(attributeId);
+    }
+}
@@ -6,6 +6,12 @@ namespace TSP.DoxygenEditor.Languages.Html
     public class HtmlToken : BaseToken
     {
         public HtmlTokenKind Kind { get; private set; }
+
+        /// <summary>
+        /// Resolved <see cref="HtmlSyntax"/> tag id for tag names or attribute id for attribute names, otherwise <see cref="HtmlSyntax.InvalidNameId"/>.
+        /// </summary>
+        public int NameId { get; private set; }
+
         public override bool IsEOF => Kind == HtmlTokenKind.EOF;
         public override bool IsValid => Kind != HtmlTokenKind.Invalid;
         public override bool IsEndOfLine => false;
@@ -18,10 +24,11 @@ namespace TSP.DoxygenEditor.Languages.Html
         public HtmlToken() : this(HtmlTokenKind.Invalid, TextRange.Invalid, false)
         {
         }
-        public void Set(HtmlTokenKind kind, TextRange range, bool isComplete)
+        public void Set(HtmlTokenKind kind, TextRange range, bool isComplete, int nameId = HtmlSyntax.InvalidNameId)
         {
             Set(LanguageKind.Html, range, isComplete);
             Kind = kind;
+            NameId = nameId;
         }
         public void ChangeKind(HtmlTokenKind kind)
         {
@@ -7,12 +7,12 @@ namespace TSP.DoxygenEditor.Languages.Html
     public static class HtmlTokenPool
     {
         private static ObjectPool<HtmlToken> _pool = null;
-        public static HtmlToken Make(HtmlTokenKind kind, TextRange range, bool isComplete)
+        public static HtmlToken Make(HtmlTokenKind kind, TextRange range, bool isComplete, int nameId = HtmlSyntax.InvalidNameId)
         {
             if (_pool == null)
                 _pool = new ObjectPool<HtmlToken>(() => new HtmlToken());
             HtmlToken result = _pool.Aquire();
-            result.Set(kind, range, isComplete);
+            result.Set(kind, range, isComplete, nameId);
             return (result);
         }
         public static void Release(IEnumerable<HtmlToken> tokens)
@@ -12,6 +12,8 @@ namespace TSP.DoxygenEditor.Lexers
         internal readonly ITextStream Buffer;
         private readonly List<T> _tokens = new List<T>();
         private readonly List<TextError> _lexErrors = new List<TextError>();
+        private State _windowState = null;
+        private bool _isWindowDone = false;
         protected IEnumerable<T> Tokens => _tokens;
         public bool HasTokens => _tokens.Count > 0;
         public IEnumerable<TextError> LexErrors => _lexErrors;
@@ -76,6 +78,38 @@ namespace TSP.DoxygenEditor.Lexers
             return (_tokens);
         }
 
+        /// <summary>
+        /// Tokenizes the next window of at least the given number of characters and returns only the tokens of that window.
+        /// The lexer state is kept between the calls, so all windows together produce the same tokens as <see cref="Tokenize"/>.
+        /// Returns false when the end of the stream was reached before.
+        /// </summary>
+        public bool TokenizeWindow(int minLength, out IEnumerable<T> tokens)
+        {
+            _tokens.Clear();
+            tokens = _tokens;
+            if (_isWindowDone)
+                return (false);
+            if (_windowState == null)
+                _windowState = CreateState();
+            int end = Buffer.StreamPosition + minLength;
+            do
+            {
+                int p = Buffer.StreamPosition;
+                _windowState.StartLex(Buffer);
+                bool r = LexNext(_windowState);
+                if (!r)
+                {
+                    _isWindowDone = true;
+                    break;
+                }
+                else
+                    Debug.Assert(Buffer.StreamPosition > p);
+            } while (!Buffer.IsEOF && Buffer.StreamPosition < end);
+            if (Buffer.IsEOF)
+                _isWindowDone = true;
+            return (true);
+        }
+
         #region IDisposable Support
         protected virtual void DisposeManaged()
         {
@@ -7,8 +7,8 @@ namespace TSP.DoxygenEditor.Parsers
 {
     public abstract class BaseNode<TEntity> : IEntityBaseNode<TEntity> where TEntity : BaseEntity
     {
-        public IBaseNode Parent { get; }
-        public int Level { get; }
+        public IBaseNode Parent { get; private set; }
+        public int Level { get; private set; }
         private readonly List<IBaseNode> _children = new List<IBaseNode>();
         public IEnumerable<IBaseNode> Children => _children;
         public IEnumerable<BaseNode<TEntity>> TypedChildren => _children.Select(c => (BaseNode<TEntity>)c);
@@ -56,6 +56,21 @@ namespace TSP.DoxygenEditor.Parsers
             _children.Add(child);
         }
 
+        /// <summary>
+        /// Attaches a subtree which was built without a parent, such as a block parsed on its own, and updates the levels.
+        /// </summary>
+        internal void ChangeParent(IBaseNode parent)
+        {
+            Parent = parent;
+            UpdateLevel(parent != null ? parent.Level + 1 : 0);
+        }
+        private void UpdateLevel(int level)
+        {
+            Level = level;
+            foreach (IBaseNode child in _children)
+                ((BaseNode<TEntity>)child).UpdateLevel(level + 1);
+        }
+
         public IBaseNode FindNodeByRange(TextRange range)
         {
             IBaseNode found = _children.FirstOrDefault(n => n.EndRange.Equals(range));
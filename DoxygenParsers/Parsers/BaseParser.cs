@@ -28,6 +28,16 @@ namespace TSP.DoxygenEditor.Parsers
         }
 
         protected IEntityBaseNode<TEntity> Top { get { return _stack.Count > 0 ? _stack.Peek() : null; } }
+        protected int StackDepth => _stack.Count;
+
+        /// <summary>
+        /// Lowest stack depth since the last call of <see cref="ResetMinStackDepth"/>.
+        /// </summary>
+        protected int MinStackDepth { get; private set; }
+        protected void ResetMinStackDepth()
+        {
+            MinStackDepth = _stack.Count;
+        }
 
         public BaseParser(ISymbolTableId id)
         {
@@ -39,6 +49,11 @@ namespace TSP.DoxygenEditor.Parsers
             string category = GetType().Name;
             _parseErrors.Add(new TextError(pos, category, message, type, symbol) { Tag = this });
         }
+        protected void AddError(TextError error)
+        {
+            _parseErrors.Add(error);
+        }
+        protected int ParseErrorCount => _parseErrors.Count;
 
         protected enum SearchMode
         {
@@ -113,6 +128,7 @@ namespace TSP.DoxygenEditor.Parsers
         public void ParseTokens(string source, IEnumerable<IBaseToken> tokens)
         {
             IEnumerable<IBaseToken> filteredTokens = FilterTokens(tokens);
+            Prepare(source, filteredTokens);
             LinkedListStream<IBaseToken> tokenStream = new LinkedListStream<IBaseToken>(filteredTokens);
             while (!tokenStream.IsEOF)
             {
@@ -132,6 +148,7 @@ namespace TSP.DoxygenEditor.Parsers
         }
 
         public virtual IEnumerable<IBaseToken> FilterTokens(IEnumerable<IBaseToken> tokens) { return tokens; }
+        public virtual void Prepare(string source, IEnumerable<IBaseToken> tokens) { }
         public virtual void Finished(IEnumerable<IBaseToken> tokens) { }
 
         protected void Add(IBaseNode node)
@@ -143,6 +160,15 @@ namespace TSP.DoxygenEditor.Parsers
                 Top.AddChild(node);
         }
 
+        /// <summary>
+        /// Adds a complete subtree, such as a cached one, which contains the given number of nodes.
+        /// </summary>
+        protected void AddTree(IBaseNode node, int nodeCount)
+        {
+            Add(node);
+            TotalNodeCount += nodeCount - 1;
+        }
+
         protected void Push(IEntityBaseNode<TEntity> node)
         {
             Add(node);
@@ -152,6 +178,8 @@ namespace TSP.DoxygenEditor.Parsers
         protected IBaseNode Pop()
         {
             IBaseNode result = _stack.Pop();
+            if (_stack.Count < MinStackDepth)
+                MinStackDepth = _stack.Count;
             return (result);
         }
 
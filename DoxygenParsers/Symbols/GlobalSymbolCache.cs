@@ -9,6 +9,11 @@ namespace TSP.DoxygenEditor.Symbols
     public static class GlobalSymbolCache
     {
         private readonly static ConcurrentDictionary<ISymbolTableId, SymbolTable> _tableMap = new ConcurrentDictionary<ISymbolTableId, SymbolTable>();
+        private readonly static SymbolSearchIndex _searchIndex = new SymbolSearchIndex();
+        private readonly static SymbolReferenceIndex _referenceIndex = new SymbolReferenceIndex();
+
+        public static SymbolSearchIndex SearchIndex => _searchIndex;
+        public static SymbolReferenceIndex ReferenceIndex => _referenceIndex;
 
         public static void Clear(ISymbolTableId id)
         {
@@ -18,6 +23,8 @@ namespace TSP.DoxygenEditor.Symbols
             {
                 SymbolTable table = _tableMap[id];
                 table.Clear();
+                _searchIndex.RemoveTable(id);
+                _referenceIndex.RemoveTable(id);
             }
         }
 
@@ -42,10 +49,12 @@ namespace TSP.DoxygenEditor.Symbols
                 SymbolTable table = _tableMap[id];
                 table.Clear();
                 ((IDictionary)_tableMap).Remove(id);
+                _searchIndex.RemoveTable(id);
+                _referenceIndex.RemoveTable(id);
             }
         }
 
-        public static void AddOrReplaceTable(SymbolTable table)
+        private static SymbolTable AddOrReplaceTableCopy(SymbolTable table)
         {
             if (table == null)
                 throw new ArgumentNullException("Table may not be null");
@@ -57,6 +66,28 @@ namespace TSP.DoxygenEditor.Symbols
                     throw new ArgumentException($"Duplicate table id '{copy.Id}' are not allowed");
                 return (existingValue);
             });
+            return (copy);
+        }
+
+        public static void AddOrReplaceTable(SymbolTable table)
+        {
+            SymbolTable copy = AddOrReplaceTableCopy(table);
+            _searchIndex.ReplaceTable(copy);
+            _referenceIndex.ReplaceTable(copy);
+        }
+
+        /// <summary>
+        /// Adds or replaces multiple tables at once, the search and reference indices are updated in one go.
+        /// </summary>
+        public static void AddOrReplaceTables(IEnumerable<SymbolTable> tables)
+        {
+            if (tables == null)
+                throw new ArgumentNullException("Tables may not be null");
+            List<SymbolTable> copies = new List<SymbolTable>();
+            foreach (SymbolTable table in tables)
+                copies.Add(AddOrReplaceTableCopy(table));
+            _searchIndex.ReplaceTables(copies);
+            _referenceIndex.ReplaceTables(copies);
         }
 
         public static bool HasReference(string symbol)
@@ -109,6 +140,13 @@ namespace TSP.DoxygenEditor.Symbols
             }
         }
 
+        public static IEnumerable<KeyValuePair<ISymbolTableId, IReadOnlyList<ReferenceSymbol>>> FindReferences(string symbol, Func<ISymbolTableId, bool> tableFilter = null)
+        {
+            if (string.IsNullOrWhiteSpace(symbol))
+                throw new ArgumentNullException("Symbol may not be null or empty");
+            return (_referenceIndex.FindReferences(symbol, tableFilter));
+        }
+
         public static BaseSymbol FindSymbolFromRange(TextRange range)
         {
             foreach (KeyValuePair<ISymbolTableId, SymbolTable> entryPair in _tableMap)
@@ -142,6 +180,26 @@ namespace TSP.DoxygenEditor.Symbols
             public bool ExcludeCppPreprocessorUsage { get; set; }
         }
 
+        private static bool IsExcluded(ValidationConfigration config, ReferenceSymbol reference)
+        {
+            if (config.ExcludeCppPreprocessorMatch)
+            {
+                if (reference.Kind == ReferenceSymbolKind.CppMacroMatch)
+                    return (true);
+            }
+            if (config.ExcludeCppPreprocessorUsage)
+            {
+                if (reference.Kind == ReferenceSymbolKind.CppMacroUsage)
+                    return (true);
+            }
+            return (false);
+        }
+
+        private static TextError CreateMissingSymbolError(string name, ReferenceSymbol reference)
+        {
+            return new TextError(reference.Range.Position, "Symbols", $"Missing symbol '{name}'", reference.Kind.ToString(), name) { Tag = reference };
+        }
+
         public static IEnumerable<KeyValuePair<ISymbolTableId, TextError>> Validate(ValidationConfigration config)
         {
             List<KeyValuePair<ISymbolTableId, TextError>> result = new List<KeyValuePair<ISymbolTableId, TextError>>();
@@ -154,18 +212,32 @@ namespace TSP.DoxygenEditor.Symbols
                     string name = names.Key;
                     foreach (ReferenceSymbol reference in names.Value)
                     {
-                        if (config.ExcludeCppPreprocessorMatch)
-                        {
-                            if (reference.Kind == ReferenceSymbolKind.CppMacroMatch)
-                                continue;
-                        }
-                        if (config.ExcludeCppPreprocessorUsage)
-                        {
-                            if (reference.Kind == ReferenceSymbolKind.CppMacroUsage)
-                                continue;
-                        }
+                        if (IsExcluded(config, reference))
+                            continue;
                         if (!HasReference(name))
-                            result.Add(new KeyValuePair<ISymbolTableId, TextError>(id, new TextError(reference.Range.Position, "Symbols", $"Missing symbol '{name}'", reference.Kind.ToString(), name) { Tag = reference }));
+                            result.Add(new KeyValuePair<ISymbolTableId, TextError>(id, CreateMissingSymbolError(name, reference)));
+                    }
+                }
+            }
+            return (result);
+        }
+
+        /// <summary>
+        /// Validates only the references to the given names, across all tables.
+        /// </summary>
+        public static IEnumerable<KeyValuePair<ISymbolTableId, TextError>> ValidateNames(ValidationConfigration config, IEnumerable<string> names)
+        {
+            List<KeyValuePair<ISymbolTableId, TextError>> result = new List<KeyValuePair<ISymbolTableId, TextError>>();
+            foreach (string name in names)
+            {
+                if (string.IsNullOrWhiteSpace(name) || HasReference(name))
+                    continue;
+                foreach (KeyValuePair<ISymbolTableId, IReadOnlyList<ReferenceSymbol>> tablePair in _referenceIndex.FindReferences(name))
+                {
+                    foreach (ReferenceSymbol reference in tablePair.Value)
+                    {
+                        if (!IsExcluded(config, reference))
+                            result.Add(new KeyValuePair<ISymbolTableId, TextError>(tablePair.Key, CreateMissingSymbolError(name, reference)));
                     }
                 }
             }
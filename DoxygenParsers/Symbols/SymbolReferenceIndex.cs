@@ -0,0 +1,137 @@
+﻿using System;
+using System.Collections.Generic;
+
+namespace TSP.DoxygenEditor.Symbols
+{
+    /// <summary>
+    /// Maps a symbol name to all its references, grouped by the table (file) in which they occur.
+    /// Tables are replaced as a whole, so republishing a single file only touches the names of that file.
+    /// The table map of a name is changed in place, so publishing a table costs the same no matter how many other tables reference the same names.
+    /// Lookups copy the table entries of the one name under the lock and stream the references without holding it. The reference arrays are never changed, so they are not copied.
+    /// </summary>
+    public class SymbolReferenceIndex
+    {
+        private readonly object _lock = new object();
+        private readonly Dictionary<string, Dictionary<ISymbolTableId, ReferenceSymbol[]>> _nameMap = new Dictionary<string, Dictionary<ISymbolTableId, ReferenceSymbol[]>>();
+        private readonly Dictionary<ISymbolTableId, List<string>> _tableNames = new Dictionary<ISymbolTableId, List<string>>();
+
+        public void Clear()
+        {
+            lock (_lock)
+            {
+                _nameMap.Clear();
+                _tableNames.Clear();
+            }
+        }
+
+        public void ReplaceTable(SymbolTable table)
+        {
+            if (table == null)
+                throw new ArgumentNullException("Table may not be null");
+            lock (_lock)
+                ReplaceTableInternal(table);
+        }
+
+        public void ReplaceTables(IEnumerable<SymbolTable> tables)
+        {
+            if (tables == null)
+                throw new ArgumentNullException("Tables may not be null");
+            lock (_lock)
+            {
+                foreach (SymbolTable table in tables)
+                    ReplaceTableInternal(table);
+            }
+        }
+
+        public void RemoveTable(ISymbolTableId id)
+        {
+            if (id == null)
+                throw new ArgumentNullException("Id may not be null");
+            lock (_lock)
+                RemoveTableInternal(id);
+        }
+
+        public int GetReferenceCount(string name)
+        {
+            int result = 0;
+            lock (_lock)
+            {
+                Dictionary<ISymbolTableId, ReferenceSymbol[]> tableMap;
+                if (_nameMap.TryGetValue(name, out tableMap))
+                {
+                    foreach (ReferenceSymbol[] references in tableMap.Values)
+                        result += references.Length;
+                }
+            }
+            return (result);
+        }
+
+        /// <summary>
+        /// Streams the references to the given name, one item per table.
+        /// Tables which are replaced or removed while streaming are not visible, the stream always reflects the state at the time of the call.
+        /// </summary>
+        public IEnumerable<KeyValuePair<ISymbolTableId, IReadOnlyList<ReferenceSymbol>>> FindReferences(string name, Func<ISymbolTableId, bool> tableFilter = null)
+        {
+            if (string.IsNullOrWhiteSpace(name))
+                throw new ArgumentNullException("Name may not be null or empty");
+            KeyValuePair<ISymbolTableId, ReferenceSymbol[]>[] tablePairs;
+            lock (_lock)
+            {
+                Dictionary<ISymbolTableId, ReferenceSymbol[]> tableMap;
+                if (!_nameMap.TryGetValue(name, out tableMap))
+                    return (new KeyValuePair<ISymbolTableId, IReadOnlyList<ReferenceSymbol>>[0]);
+                tablePairs = new KeyValuePair<ISymbolTableId, ReferenceSymbol[]>[tableMap.Count];
+                ((ICollection<KeyValuePair<ISymbolTableId, ReferenceSymbol[]>>)tableMap).CopyTo(tablePairs, 0);
+            }
+            return (EnumerateTables(tablePairs, tableFilter));
+        }
+
+        private static IEnumerable<KeyValuePair<ISymbolTableId, IReadOnlyList<ReferenceSymbol>>> EnumerateTables(KeyValuePair<ISymbolTableId, ReferenceSymbol[]>[] tablePairs, Func<ISymbolTableId, bool> tableFilter)
+        {
+            foreach (KeyValuePair<ISymbolTableId, ReferenceSymbol[]> tablePair in tablePairs)
+            {
+                if (tableFilter != null && !tableFilter(tablePair.Key))
+                    continue;
+                yield return new KeyValuePair<ISymbolTableId, IReadOnlyList<ReferenceSymbol>>(tablePair.Key, tablePair.Value);
+            }
+        }
+
+        private void ReplaceTableInternal(SymbolTable table)
+        {
+            RemoveTableInternal(table.Id);
+            List<string> names = new List<string>(table.ReferenceCount);
+            foreach (KeyValuePair<string, List<ReferenceSymbol>> referencePair in table.ReferenceMap)
+            {
+                if (referencePair.Value.Count == 0)
+                    continue;
+                Dictionary<ISymbolTableId, ReferenceSymbol[]> tableMap;
+                if (!_nameMap.TryGetValue(referencePair.Key, out tableMap))
+                {
+                    tableMap = new Dictionary<ISymbolTableId, ReferenceSymbol[]>();
+                    _nameMap.Add(referencePair.Key, tableMap);
+                }
+                tableMap[table.Id] = referencePair.Value.ToArray();
+                names.Add(referencePair.Key);
+            }
+            _tableNames[table.Id] = names;
+        }
+
+        private void RemoveTableInternal(ISymbolTableId id)
+        {
+            List<string> names;
+            if (!_tableNames.TryGetValue(id, out names))
+                return;
+            foreach (string name in names)
+            {
+                Dictionary<ISymbolTableId, ReferenceSymbol[]> tableMap;
+                if (_nameMap.TryGetValue(name, out tableMap))
+                {
+                    tableMap.Remove(id);
+                    if (tableMap.Count == 0)
+                        _nameMap.Remove(name);
+                }
+            }
+            _tableNames.Remove(id);
+        }
+    }
+}
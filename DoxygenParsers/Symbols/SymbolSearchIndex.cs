@@ -0,0 +1,495 @@
+﻿using System;
+using System.Collections.Generic;
+
+namespace TSP.DoxygenEditor.Symbols
+{
+    public class SymbolSearchEntry
+    {
+        public SourceSymbol Symbol { get; }
+        public ISymbolTableId TableId { get; }
+
+        internal readonly string LowerName;
+        internal readonly string LowerCaption;
+
+        internal SymbolSearchEntry(ISymbolTableId tableId, SourceSymbol symbol)
+        {
+            TableId = tableId;
+            Symbol = symbol;
+            LowerName = symbol.Name != null ? symbol.Name.ToLowerInvariant() : string.Empty;
+            LowerCaption = symbol.Caption?.ToLowerInvariant();
+        }
+
+        public override string ToString()
+        {
+            return $"{Symbol} [{TableId}]";
+        }
+    }
+
+    /// <summary>
+    /// Incrementally maintained search index over all source symbols, with a separate index for every symbol table.
+    /// Names and captions are indexed by trigrams, anchored prefixes of length one and two and the initials of the first two and three camel humps.
+    /// Queries only touch the smallest matching posting list of the searched tables, so the cost depends on the number of candidates and not on the number of symbols.
+    /// </summary>
+    public class SymbolSearchIndex
+    {
+        class Posting
+        {
+            public readonly List<int> Slots = new List<int>();
+        }
+
+        // @NOTE(final): Built once per table and replaced as a whole, so there are never any dead entries to clean up
+        class TableIndex
+        {
+            public readonly List<SymbolSearchEntry> Entries = new List<SymbolSearchEntry>();
+            public readonly Dictionary<ulong, Posting> Postings = new Dictionary<ulong, Posting>();
+            public readonly HashSet<SourceSymbolKind> Kinds = new HashSet<SourceSymbolKind>();
+            public readonly Posting AllSlots = new Posting();
+            public int[] VisitStamps = new int[0];
+        }
+
+        enum MatchScore : int
+        {
+            Exact = 0,
+            Prefix,
+            CamelHump,
+            Substring,
+            Caption,
+            Any,
+            None,
+        }
+
+        private const ulong PrefixKeyFlag = 1UL << 48;
+        private const ulong HumpKeyFlag = 1UL << 49;
+
+        private readonly object _lock = new object();
+        private readonly Dictionary<ISymbolTableId, TableIndex> _tables = new Dictionary<ISymbolTableId, TableIndex>();
+        private int _visitStamp = 0;
+
+        public int Count
+        {
+            get
+            {
+                int result = 0;
+                lock (_lock)
+                {
+                    foreach (TableIndex table in _tables.Values)
+                        result += table.Entries.Count;
+                }
+                return (result);
+            }
+        }
+
+        public void Clear()
+        {
+            lock (_lock)
+                _tables.Clear();
+        }
+
+        public void ReplaceTable(SymbolTable table)
+        {
+            if (table == null)
+                throw new ArgumentNullException("Table may not be null");
+            TableIndex tableIndex = BuildTable(table);
+            lock (_lock)
+                _tables[table.Id] = tableIndex;
+        }
+
+        public void ReplaceTables(IEnumerable<SymbolTable> tables)
+        {
+            if (tables == null)
+                throw new ArgumentNullException("Tables may not be null");
+            List<KeyValuePair<ISymbolTableId, TableIndex>> tableIndices = new List<KeyValuePair<ISymbolTableId, TableIndex>>();
+            foreach (SymbolTable table in tables)
+                tableIndices.Add(new KeyValuePair<ISymbolTableId, TableIndex>(table.Id, BuildTable(table)));
+            lock (_lock)
+            {
+                foreach (KeyValuePair<ISymbolTableId, TableIndex> pair in tableIndices)
+                    _tables[pair.Key] = pair.Value;
+            }
+        }
+
+        public void RemoveTable(ISymbolTableId id)
+        {
+            if (id == null)
+                throw new ArgumentNullException("Id may not be null");
+            lock (_lock)
+                _tables.Remove(id);
+        }
+
+        /// <summary>
+        /// Returns the kinds of all source symbols in the given table.
+        /// </summary>
+        public List<SourceSymbolKind> GetKinds(ISymbolTableId id)
+        {
+            List<SourceSymbolKind> result = new List<SourceSymbolKind>();
+            lock (_lock)
+            {
+                TableIndex table;
+                if (_tables.TryGetValue(id, out table))
+                    result.AddRange(table.Kinds);
+            }
+            result.Sort();
+            return (result);
+        }
+
+        /// <summary>
+        /// Returns the best <paramref name="maxResults"/> entries of all tables for the given text, best match first.
+        /// An empty text returns the first entries ordered by name length and name.
+        /// </summary>
+        public List<SymbolSearchEntry> Search(string text, int maxResults, Func<SymbolSearchEntry, bool> filter = null)
+        {
+            return (Search(null, text, maxResults, filter));
+        }
+
+        /// <summary>
+        /// Returns the best <paramref name="maxResults"/> entries of the given table for the given text, best match first.
+        /// When the id is null, all tables are searched.
+        /// </summary>
+        public List<SymbolSearchEntry> Search(ISymbolTableId id, string text, int maxResults, Func<SymbolSearchEntry, bool> filter = null)
+        {
+            List<SymbolSearchEntry> result = new List<SymbolSearchEntry>();
+            if (maxResults <= 0)
+                return (result);
+            string query = text != null ? text.Trim() : string.Empty;
+            string lowerQuery = query.ToLowerInvariant();
+            List<string> segments = SplitQueryHumps(query);
+            List<KeyValuePair<MatchScore, SymbolSearchEntry>> top = new List<KeyValuePair<MatchScore, SymbolSearchEntry>>(maxResults + 1);
+            lock (_lock)
+            {
+                ++_visitStamp;
+                if (_visitStamp == int.MaxValue)
+                {
+                    foreach (TableIndex table in _tables.Values)
+                        Array.Clear(table.VisitStamps, 0, table.VisitStamps.Length);
+                    _visitStamp = 1;
+                }
+                if (id != null)
+                {
+                    TableIndex table;
+                    if (_tables.TryGetValue(id, out table))
+                        SearchTable(table, lowerQuery, segments, filter, top, maxResults);
+                }
+                else
+                {
+                    foreach (TableIndex table in _tables.Values)
+                        SearchTable(table, lowerQuery, segments, filter, top, maxResults);
+                }
+            }
+            foreach (KeyValuePair<MatchScore, SymbolSearchEntry> pair in top)
+                result.Add(pair.Value);
+            return (result);
+        }
+
+        private void SearchTable(TableIndex table, string lowerQuery, List<string> segments, Func<SymbolSearchEntry, bool> filter, List<KeyValuePair<MatchScore, SymbolSearchEntry>> top, int maxResults)
+        {
+            if (lowerQuery.Length == 0)
+            {
+                CollectPosting(table, table.AllSlots, MatchScore.Any, lowerQuery, segments, filter, top, maxResults);
+                return;
+            }
+
+            // Trigrams for substrings of name and caption, anchored prefixes for queries shorter than a trigram
+            Posting candidates;
+            if (lowerQuery.Length >= 3)
+                candidates = FindSmallestTrigramPosting(table, lowerQuery);
+            else
+                candidates = GetPosting(table, MakePrefixKey(lowerQuery));
+            if (candidates != null)
+                CollectPosting(table, candidates, MatchScore.Prefix, lowerQuery, segments, filter, top, maxResults);
+
+            // Camel humps, such as "GSC" or "GloSymCa" for "GlobalSymbolCache"
+            if (segments.Count >= 2)
+            {
+                Posting humpCandidates;
+                if (segments.Count >= 3)
+                    humpCandidates = GetPosting(table, MakeHumpKey(segments[0][0], segments[1][0], segments[2][0]));
+                else
+                    humpCandidates = GetPosting(table, MakeHumpKey(segments[0][0], segments[1][0], '\0'));
+                // @NOTE(final): Every prefix match was already seen by the text pass, so camel humps are the best we can get here
+                if (humpCandidates != null)
+                    CollectPosting(table, humpCandidates, MatchScore.CamelHump, lowerQuery, segments, filter, top, maxResults);
+            }
+        }
+
+        private void CollectPosting(TableIndex table, Posting posting, MatchScore bestScore, string lowerQuery, List<string> segments, Func<SymbolSearchEntry, bool> filter, List<KeyValuePair<MatchScore, SymbolSearchEntry>> top, int maxResults)
+        {
+            // @NOTE(final): Postings are sorted by name length and name, the same order used to break ties between equal scores.
+            // So as soon as the best possible score of a longer name cannot beat the worst result we have, no following slot can either.
+            foreach (int slot in posting.Slots)
+            {
+                if (table.VisitStamps[slot] == _visitStamp)
+                    continue;
+                SymbolSearchEntry entry = table.Entries[slot];
+                if (top.Count == maxResults)
+                {
+                    bool isExactLength = entry.LowerName.Length == lowerQuery.Length;
+                    MatchScore bestPossible = (bestScore == MatchScore.Prefix && isExactLength) ? MatchScore.Exact : bestScore;
+                    if (Compare(new KeyValuePair<MatchScore, SymbolSearchEntry>(bestPossible, entry), top[top.Count - 1]) >= 0)
+                    {
+                        if (bestScore != MatchScore.Prefix || entry.LowerName.Length > lowerQuery.Length)
+                            break;
+                        continue;
+                    }
+                }
+                MatchScore score = bestScore == MatchScore.Any ? MatchScore.Any : Score(entry, lowerQuery, segments);
+                Collect(table, slot, score, filter, top, maxResults);
+            }
+        }
+
+        private static int CompareSlots(TableIndex table, int a, int b)
+        {
+            string nameA = table.Entries[a].LowerName;
+            string nameB = table.Entries[b].LowerName;
+            int result = nameA.Length.CompareTo(nameB.Length);
+            if (result == 0)
+                result = string.CompareOrdinal(nameA, nameB);
+            if (result == 0)
+                result = a.CompareTo(b);
+            return (result);
+        }
+
+        private void Collect(TableIndex table, int slot, MatchScore score, Func<SymbolSearchEntry, bool> filter, List<KeyValuePair<MatchScore, SymbolSearchEntry>> top, int maxResults)
+        {
+            if (score == MatchScore.None)
+                return;
+            SymbolSearchEntry entry = table.Entries[slot];
+            if (filter != null && !filter(entry))
+                return;
+            table.VisitStamps[slot] = _visitStamp;
+            KeyValuePair<MatchScore, SymbolSearchEntry> item = new KeyValuePair<MatchScore, SymbolSearchEntry>(score, entry);
+            if (top.Count == maxResults && Compare(item, top[top.Count - 1]) >= 0)
+                return;
+            int lo = 0, hi = top.Count;
+            while (lo < hi)
+            {
+                int mid = (lo + hi) >> 1;
+                if (Compare(top[mid], item) <= 0)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            top.Insert(lo, item);
+            if (top.Count > maxResults)
+                top.RemoveAt(top.Count - 1);
+        }
+
+        private static int Compare(KeyValuePair<MatchScore, SymbolSearchEntry> a, KeyValuePair<MatchScore, SymbolSearchEntry> b)
+        {
+            int result = ((int)a.Key).CompareTo((int)b.Key);
+            if (result == 0)
+                result = a.Value.LowerName.Length.CompareTo(b.Value.LowerName.Length);
+            if (result == 0)
+                result = string.CompareOrdinal(a.Value.LowerName, b.Value.LowerName);
+            return (result);
+        }
+
+        private static MatchScore Score(SymbolSearchEntry entry, string lowerQuery, List<string> segments)
+        {
+            MatchScore result = ScoreText(entry, lowerQuery);
+            if (result > MatchScore.CamelHump && segments.Count >= 2 && IsHumpMatch(entry.Symbol.Name, segments))
+                result = MatchScore.CamelHump;
+            return (result);
+        }
+
+        private static MatchScore ScoreText(SymbolSearchEntry entry, string lowerQuery)
+        {
+            string name = entry.LowerName;
+            if (name.Length == lowerQuery.Length && name.Equals(lowerQuery, StringComparison.Ordinal))
+                return (MatchScore.Exact);
+            if (name.StartsWith(lowerQuery, StringComparison.Ordinal))
+                return (MatchScore.Prefix);
+            if (lowerQuery.Length >= 3)
+            {
+                if (name.IndexOf(lowerQuery, StringComparison.Ordinal) > -1)
+                    return (MatchScore.Substring);
+                if (entry.LowerCaption != null && entry.LowerCaption.IndexOf(lowerQuery, StringComparison.Ordinal) > -1)
+                    return (MatchScore.Caption);
+            }
+            else if (entry.LowerCaption != null && entry.LowerCaption.StartsWith(lowerQuery, StringComparison.Ordinal))
+                return (MatchScore.Caption);
+            return (MatchScore.None);
+        }
+
+        private static Posting GetPosting(TableIndex table, ulong key)
+        {
+            Posting result;
+            if (table.Postings.TryGetValue(key, out result))
+                return (result);
+            return (null);
+        }
+
+        private static Posting FindSmallestTrigramPosting(TableIndex table, string lowerQuery)
+        {
+            Posting result = null;
+            for (int i = 0; i + 2 < lowerQuery.Length; ++i)
+            {
+                Posting posting = GetPosting(table, MakeTrigramKey(lowerQuery[i], lowerQuery[i + 1], lowerQuery[i + 2]));
+                if (posting == null)
+                    return (null);
+                if (result == null || posting.Slots.Count < result.Slots.Count)
+                    result = posting;
+            }
+            return (result);
+        }
+
+        private static TableIndex BuildTable(SymbolTable symbolTable)
+        {
+            TableIndex result = new TableIndex();
+            HashSet<ulong> keys = new HashSet<ulong>();
+            foreach (KeyValuePair<string, List<SourceSymbol>> sourcePair in symbolTable.SourceMap)
+            {
+                foreach (SourceSymbol symbol in sourcePair.Value)
+                {
+                    SymbolSearchEntry entry = new SymbolSearchEntry(symbolTable.Id, symbol);
+                    int slot = result.Entries.Count;
+                    result.Entries.Add(entry);
+                    result.Kinds.Add(symbol.Kind);
+                    result.AllSlots.Slots.Add(slot);
+
+                    keys.Clear();
+                    AddTextKeys(entry.LowerName, keys);
+                    if (entry.LowerCaption != null)
+                        AddTextKeys(entry.LowerCaption, keys);
+                    string initials = GetFirstHumpInitials(symbol.Name, 3);
+                    if (initials.Length >= 2)
+                        keys.Add(MakeHumpKey(initials[0], initials[1], '\0'));
+                    if (initials.Length >= 3)
+                        keys.Add(MakeHumpKey(initials[0], initials[1], initials[2]));
+                    foreach (ulong key in keys)
+                    {
+                        Posting posting;
+                        if (!result.Postings.TryGetValue(key, out posting))
+                        {
+                            posting = new Posting();
+                            result.Postings.Add(key, posting);
+                        }
+                        posting.Slots.Add(slot);
+                    }
+                }
+            }
+
+            // Every posting is sorted right away, the table is never changed afterwards
+            result.AllSlots.Slots.Sort((a, b) => CompareSlots(result, a, b));
+            foreach (Posting posting in result.Postings.Values)
+                posting.Slots.Sort((a, b) => CompareSlots(result, a, b));
+            result.VisitStamps = new int[result.Entries.Count];
+            return (result);
+        }
+
+        private static void AddTextKeys(string lower, HashSet<ulong> keys)
+        {
+            if (lower.Length > 0)
+                keys.Add(MakePrefixKey(lower.Substring(0, 1)));
+            if (lower.Length > 1)
+                keys.Add(MakePrefixKey(lower.Substring(0, 2)));
+            for (int i = 0; i + 2 < lower.Length; ++i)
+                keys.Add(MakeTrigramKey(lower[i], lower[i + 1], lower[i + 2]));
+        }
+
+        private static ulong MakeTrigramKey(char a, char b, char c)
+        {
+            return (((ulong)a << 32) | ((ulong)b << 16) | c);
+        }
+
+        private static ulong MakePrefixKey(string lowerPrefix)
+        {
+            ulong result = PrefixKeyFlag | ((ulong)lowerPrefix[0] << 16);
+            if (lowerPrefix.Length > 1)
+                result |= (ulong)lowerPrefix[1] | (1UL << 47);
+            return (result);
+        }
+
+        private static ulong MakeHumpKey(char a, char b, char c)
+        {
+            return (HumpKeyFlag | ((ulong)char.ToLowerInvariant(a) << 32) | ((ulong)char.ToLowerInvariant(b) << 16) | char.ToLowerInvariant(c));
+        }
+
+        private static bool IsHumpStart(string name, int index)
+        {
+            char c = name[index];
+            if (c == '_')
+                return (false);
+            if (index == 0)
+                return (true);
+            char prev = name[index - 1];
+            if (prev == '_')
+                return (true);
+            if (char.IsDigit(c))
+                return (!char.IsDigit(prev));
+            if (char.IsUpper(c))
+            {
+                if (!char.IsUpper(prev))
+                    return (true);
+                // Last upper letter of an acronym starts the next hump, e.g. "S" in "HTTPServer"
+                return (index + 1 < name.Length && char.IsLower(name[index + 1]));
+            }
+            return (false);
+        }
+
+        private static string GetFirstHumpInitials(string name, int maxCount)
+        {
+            string result = string.Empty;
+            if (name == null)
+                return (result);
+            for (int i = 0; i < name.Length && result.Length < maxCount; ++i)
+            {
+                if (IsHumpStart(name, i))
+                    result += name[i];
+            }
+            return (result);
+        }
+
+        private static List<string> SplitQueryHumps(string query)
+        {
+            List<string> result = new List<string>();
+            int start = -1;
+            for (int i = 0; i < query.Length; ++i)
+            {
+                char c = query[i];
+                if (c == '_' || char.IsWhiteSpace(c))
+                {
+                    if (start > -1)
+                        result.Add(query.Substring(start, i - start));
+                    start = -1;
+                }
+                else if (start == -1)
+                    start = i;
+                else if (char.IsUpper(c))
+                {
+                    result.Add(query.Substring(start, i - start));
+                    start = i;
+                }
+            }
+            if (start > -1)
+                result.Add(query.Substring(start));
+            return (result);
+        }
+
+        private static bool IsHumpMatch(string name, List<string> segments)
+        {
+            int segmentIndex = 0;
+            int i = 0;
+            while (i < name.Length && segmentIndex < segments.Count)
+            {
+                if (!IsHumpStart(name, i))
+                {
+                    ++i;
+                    continue;
+                }
+                string segment = segments[segmentIndex];
+                if (i + segment.Length > name.Length)
+                    return (false);
+                for (int j = 0; j < segment.Length; ++j)
+                {
+                    if (char.ToLowerInvariant(name[i + j]) != char.ToLowerInvariant(segment[j]))
+                        return (false);
+                    if (j > 0 && IsHumpStart(name, i + j))
+                        return (false);
+                }
+                ++segmentIndex;
+                i += segment.Length;
+            }
+            return (segmentIndex == segments.Count);
+        }
+    }
+}
@@ -39,6 +39,7 @@ namespace TSP.DoxygenEditor.TextAnalysis
         void SkipSpaces(RepeatKind repeat);
         void SkipLineBreaks(RepeatKind repeat);
         void SkipUntil(char c);
+        void Seek(TextPosition pos);
 
         void StartLexeme();
     }
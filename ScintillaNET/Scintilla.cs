@@ -2494,6 +2494,49 @@ namespace ScintillaNET
             stylingBytePosition = endBytePos;
         }
 
+        /// <summary>
+        /// Styles the specified length of characters from a buffer of styles in a single call.
+        /// </summary>
+        /// <param name="length">The number of characters to style.</param>
+        /// <param name="styles">
+        /// The <see cref="Style" /> definition index for each byte of the document, where index zero is the first byte of the document.
+        /// The bytes starting at the current styling position are applied.
+        /// </param>
+        /// <exception cref="ArgumentNullException"><paramref name="styles" /> is null.</exception>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="length" /> is less than zero. -or-
+        /// The sum of a preceeding call to <see cref="StartStyling" /> or <see name="SetStyling" /> and <paramref name="length" /> is greater than the document length. -or-
+        /// <paramref name="styles" /> does not cover the styled range.
+        /// </exception>
+        /// <remarks>
+        /// The styling position is advanced by <paramref name="length" /> the same as <see cref="SetStyling(int, int)" />.
+        /// The style indices are not validated.
+        /// </remarks>
+        /// <seealso cref="StartStyling" />
+        public unsafe void SetStyling(int length, byte[] styles)
+        {
+            var textLength = TextLength;
+
+            if (styles == null)
+                throw new ArgumentNullException("styles");
+            if (length < 0)
+                throw new ArgumentOutOfRangeException("length", "Length cannot be less than zero.");
+            if (stylingPosition + length > textLength)
+                throw new ArgumentOutOfRangeException("length", "Position and length must refer to a range within the document.");
+
+            var endPos = stylingPosition + length;
+            var endBytePos = Lines.CharToBytePosition(endPos);
+            if (endBytePos > styles.Length)
+                throw new ArgumentOutOfRangeException("styles", "Styles must cover the range within the document.");
+
+            fixed (byte* bp = styles)
+                DirectMessage(NativeMethods.SCI_SETSTYLINGEX, new IntPtr(endBytePos - stylingBytePosition), new IntPtr(bp + stylingBytePosition));
+
+            // Track this for the next call
+            stylingPosition = endPos;
+            stylingBytePosition = endBytePos;
+        }
+
         /// <summary>
         /// Sets the <see cref="TargetStart" /> and <see cref="TargetEnd" /> properties in a single call.
         /// </summary>